@@ -0,0 +1,90 @@
+/*
+  Auto-Ranging the Panasonic Grid-EYE Sensor with a Histogram
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  This example keeps a histogram of the last four frames and uses its percentiles to pick the
+  display range, instead of a fixed 20C to 40C. The 1st and 99th percentiles become the ends of
+  the scale, so a single hot or dead pixel can't squash the rest of the image. Each frame is
+  printed to the serial terminal at 115200 as an 8x8 block of characters from cold to hot,
+  followed by the low, median and high temperatures.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+#define WINDOW_FRAMES 4
+
+GridEYE grideye;
+GridEYEHistogram histogram;
+
+int16_t frame[64];
+uint8_t history[WINDOW_FRAMES * 64];
+
+const char shades[] = " .:-=+*#%@";
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  histogram.setWindow(history, WINDOW_FRAMES);
+
+}
+
+void loop() {
+
+  if (grideye.getFrameRaw(frame)) {
+    histogram.pushFrame(frame);
+
+    // Never stretch less than 2C across the scale
+    GridEYEStretch stretch;
+    histogram.getStretch(&stretch, 1, 99, 8);
+
+    for (unsigned char i = 0; i < 64; i++) {
+      uint8_t level = stretch.apply(frame[i]);
+      Serial.print(shades[(level * 10) >> 8]);
+      if ((i + 1) % 8 == 0) {
+        Serial.println();
+      }
+    }
+
+    Serial.print("Low: ");
+    Serial.print(stretch.low * 0.25);
+    Serial.print("C  Median: ");
+    Serial.print(histogram.getPercentile(50) * 0.25);
+    Serial.print("C  High: ");
+    Serial.print(stretch.high * 0.25);
+    Serial.println("C");
+    Serial.println();
+  }
+
+  delay(100);
+
+}
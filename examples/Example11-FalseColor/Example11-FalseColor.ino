@@ -0,0 +1,100 @@
+/*
+  False Color Images from the Panasonic Grid-EYE Sensor
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  This example renders each frame as a 16x16 false color image, one row at a time, and draws it
+  in a terminal that understands 24-bit ANSI colors (screen, minicom, PuTTY or the terminal built
+  into most editors; the Arduino serial monitor does not) at 115200. Send 'p' to cycle through the
+  ironbow, rainbow and grayscale palettes.
+
+  To drive an SPI display instead, set the scale to fit the screen and send each RGB565 row from
+  renderRow() straight to the display, for example with pushColors() on Adafruit or TFT_eSPI
+  style libraries. Only one row has to be held in RAM.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+#define SCALE 2
+
+GridEYE grideye;
+GridEYERenderer renderer;
+
+int16_t frame[64];
+uint8_t row[8 * SCALE * 3];
+uint8_t palette = GRIDEYE_PALETTE_IRONBOW;
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  renderer.setScale(SCALE);
+  // Stretch each frame from its coldest to its hottest pixel, at least 2C
+  renderer.setAutoRange(8);
+
+}
+
+void loop() {
+
+  if (Serial.available() && Serial.read() == 'p') {
+    palette = (palette + 1) % 3;
+    renderer.setPalette(palette);
+  }
+
+  if (grideye.getFrameRaw(frame)) {
+    renderer.setFrame(frame);
+
+    // Cursor to the top left corner
+    Serial.print("\033[H");
+    for (uint16_t y = 0; y < renderer.getHeight(); y++) {
+      renderer.renderRow888(y, row);
+      for (uint16_t x = 0; x < renderer.getWidth(); x++) {
+        // Two spaces with the pixel color as background make a square-ish block
+        Serial.print("\033[48;2;");
+        Serial.print(row[x * 3]);
+        Serial.print(";");
+        Serial.print(row[x * 3 + 1]);
+        Serial.print(";");
+        Serial.print(row[x * 3 + 2]);
+        Serial.print("m  ");
+      }
+      Serial.println("\033[0m");
+    }
+
+    Serial.print(renderer.getStretch().low * 0.25);
+    Serial.print("C to ");
+    Serial.print(renderer.getStretch().high * 0.25);
+    Serial.println("C    ");
+  }
+
+  delay(100);
+
+}
@@ -0,0 +1,83 @@
+/*
+  Detecting Occupancy with a Tiny Neural Network on the Panasonic Grid-EYE
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  This example runs a small int8 network on every frame to decide whether anyone is in view. The
+  model in model.h is stored in flash and read from there as it runs; only the arena of
+  activations below needs RAM. It removes the frame mean so it works at any room temperature,
+  looks for warm spots with a blur and a center-surround filter, and scores them with a dense
+  layer. Open the serial terminal at 115200 to see the class, both scores and how long the
+  model took.
+
+  The model is hand-built as a demonstration. Train your own with any tool that can export int8
+  weights, and write it with GridEYEModelBuilder in extras/linux.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+#include "model.h"
+
+GridEYE grideye;
+GridEYEModel model;
+
+int16_t frame[64];
+int8_t arena[192];
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  if (!model.begin(occupancyModel, arena, sizeof(arena), true)) {
+    Serial.print("Model did not load, it needs an arena of ");
+    Serial.print(model.getArenaSize());
+    Serial.println(" bytes");
+    while (1);
+  }
+
+}
+
+void loop() {
+
+  if (grideye.getFrameRaw(frame) && model.run(frame)) {
+    Serial.print(model.getClass() ? "Occupied" : "Empty   ");
+    Serial.print("  scores: ");
+    Serial.print(model.getOutput(0));
+    Serial.print(", ");
+    Serial.print(model.getOutput(1));
+    Serial.print("  ");
+    Serial.print(model.getLatency());
+    Serial.println("us");
+  }
+
+  delay(100);
+
+}
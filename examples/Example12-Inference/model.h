@@ -0,0 +1,20 @@
+// Occupancy model for GridEYEModel, written by extras/linux/inference_check --emit
+// Hand-built, not trained; see inference_check.cpp for how it works
+// Outputs: 0 empty, 1 occupied
+
+const uint8_t occupancyModel[158] PROGMEM = {
+  0x47, 0x4D, 0x01, 0x03, 0x9E, 0x00, 0x01, 0x00, 0x00, 0x00, 0x40, 0x0D,
+  0x01, 0x01, 0x02, 0x03, 0x01, 0x81, 0x40, 0x14, 0x04, 0xFE, 0xFF, 0xFF,
+  0x04, 0xFE, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+  0x0E, 0xF0, 0xF0, 0xF0, 0xF0, 0x7F, 0xF0, 0xF0, 0xF0, 0xF0, 0x02, 0x01,
+  0x03, 0x02, 0x81, 0x40, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F,
+  0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x03, 0x00, 0x02, 0x81, 0x40,
+  0x14, 0x00, 0x00, 0x00, 0x00, 0x08, 0xFC, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D,
+  0x7F, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D,
+  0x7F, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D, 0x7F, 0x0D,
+  0x7F, 0xB7
+};
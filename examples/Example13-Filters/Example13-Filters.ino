@@ -0,0 +1,93 @@
+/*
+  Filtering Noise and Finding Edges on the Panasonic Grid-EYE
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  This example cleans up each frame with a 3x3 median filter, which removes single pixel noise
+  without blurring edges, then smooths it and takes the Sobel gradient magnitude to find the
+  outlines of warm objects. The filters work on a padded copy of the frame, so there are no edge
+  checks in the inner loops. Open the serial terminal at 115200 to see the filtered frame and
+  the edge map side by side, followed by the time the filters took.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+GridEYE grideye;
+GridEYEFilter filter;
+
+int16_t frame[64];
+int16_t filtered[64];
+int16_t edges[64];
+
+const char shades[] = " .:-=+*#%@";
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+}
+
+void loop() {
+
+  if (grideye.getFrameRaw(frame)) {
+    unsigned long start = micros();
+    filter.load(frame);
+    filter.median();
+    filter.store(filtered);
+    filter.gaussian();
+    filter.sobel();
+    filter.store(edges);
+    unsigned long elapsed = micros() - start;
+
+    // Filtered frame from 20C to 40C on the left, edges on the right
+    for (unsigned char y = 0; y < 8; y++) {
+      for (unsigned char x = 0; x < 8; x++) {
+        int level = constrain((filtered[y * 8 + x] - 80) / 8, 0, 9);
+        Serial.print(shades[level]);
+      }
+      Serial.print("   ");
+      for (unsigned char x = 0; x < 8; x++) {
+        // 8 per LSB per pixel, so 64 is 2C across one pixel
+        int level = constrain(edges[y * 8 + x] / 8, 0, 9);
+        Serial.print(shades[level]);
+      }
+      Serial.println();
+    }
+
+    Serial.print("Filters took ");
+    Serial.print(elapsed);
+    Serial.println("us");
+    Serial.println();
+  }
+
+  delay(100);
+
+}
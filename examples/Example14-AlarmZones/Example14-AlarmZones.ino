@@ -0,0 +1,92 @@
+/*
+  Per-Zone Alarms on the Panasonic Grid-EYE
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  This example watches two zones of the view with their own limits. A "door" zone down the left
+  two columns alarms when two or more of its pixels read over 30C for half a second, like a
+  person walking through. A "stove" zone in the top right corner alarms over 60C, or under
+  10C if something cold is left there. The sensor's interrupt is set to the loosest of these
+  limits, so the INT pin only goes low when one of the zones could be in alarm. Open the serial
+  terminal at 115200 to see alarms as they start and stop.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+#define DOOR 0
+#define STOVE 1
+
+GridEYE grideye;
+GridEYEZones zones;
+GridEYEZone zoneList[2];
+
+int16_t frame[64];
+
+const char *names[] = {"Door", "Stove"};
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  zones.begin(zoneList, 2);
+
+  // Levels are in quarter degrees. 5 frames at 10 FPS is half a second.
+  GridEYERegion door = {0, 0, 2, 8};
+  zones.setZone(DOOR, GridEYEZones::regionMask(door), GRIDEYE_ZONE_NO_LOWER, 30 * 4, 4, 5, 2);
+
+  GridEYERegion stove = {5, 0, 3, 3};
+  zones.setZone(STOVE, GridEYEZones::regionMask(stove), 10 * 4, 60 * 4, 8);
+
+  zones.programInterrupt(grideye);
+
+}
+
+void loop() {
+
+  if (grideye.getFrameRaw(frame) && zones.update(frame)) {
+    for (unsigned char i = 0; i < 2; i++) {
+      if (zones.changed(i)) {
+        Serial.print(names[i]);
+        uint8_t state = zones.getState(i);
+        if (state & GRIDEYE_ZONE_HIGH) {
+          Serial.println(": too hot");
+        } else if (state & GRIDEYE_ZONE_LOW) {
+          Serial.println(": too cold");
+        } else {
+          Serial.println(": back to normal");
+        }
+      }
+    }
+  }
+
+  delay(100);
+
+}
@@ -0,0 +1,88 @@
+/*
+  Fast Verified Startup of the Panasonic Grid-EYE
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  This example brings the sensor up with GridEYEStartup instead of fixed delays. It checks
+  that the sensor answers, sets 10 FPS with the interrupt pin armed over 30C and reads the
+  settings back, then waits only as long as it takes for the first real frame. Press reset
+  on your Arduino and the sensor, still powered and set up, is used straight away. Asking
+  for GRIDEYE_RESET_INITIAL instead resets the sensor every time, at the cost of a frame.
+  Open the serial terminal at 115200 to see how long it took.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+GridEYE grideye;
+GridEYEStartup startup;
+
+int16_t frame[64];
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  GridEYEProfile profile;
+  GridEYEStartup::defaultProfile(&profile);
+  profile.interruptControl = 0x03; // Pin enabled, absolute levels
+  profile.upper = 30 * 4;          // Quarter degrees
+  profile.lower = -20 * 4;
+  profile.hysteresis = 2 * 4;
+
+  uint8_t result = startup.start(grideye, profile, GRIDEYE_RESET_NONE, frame);
+  if (result == GRIDEYE_STARTUP_NO_DEVICE) {
+    Serial.println("No sensor found. Check wiring.");
+  } else if (result == GRIDEYE_STARTUP_NOT_GRIDEYE) {
+    Serial.println("Something answered, but it isn't a GridEYE");
+  } else if (result == GRIDEYE_STARTUP_CONFIG) {
+    Serial.println("Settings didn't stick");
+  } else if (result == GRIDEYE_STARTUP_NO_FRAME) {
+    Serial.println("No frame from the sensor");
+  } else {
+    Serial.print(startup.wasWarmStart() ? "Warm start" : "Cold start");
+    Serial.print(", first frame after ");
+    Serial.print(startup.getTimeToFirstFrame() / 1000.0);
+    Serial.println(" ms");
+  }
+
+}
+
+void loop() {
+
+  if (startup.getResult() == GRIDEYE_STARTUP_OK && grideye.getFrameRaw(frame)) {
+    // Center pixel, 0.25C per LSB
+    Serial.print(frame[27] * 0.25);
+    Serial.println(" C");
+  }
+
+  delay(100);
+
+}
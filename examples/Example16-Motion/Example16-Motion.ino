@@ -0,0 +1,76 @@
+/*
+  Motion Direction with the Panasonic Grid-EYE
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+  This example measures how the scene moves between frames with GridEYEMotion. Every frame
+  gives a 4x4 grid of motion vectors and the dominant flow, the direction most of the moving
+  warm areas agree on. Walk past the sensor and open the serial terminal at 115200 to see the
+  direction and speed, in pixels per second at 10 frames per second.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+GridEYE grideye;
+GridEYEMotion motion;
+
+int16_t frame[64];
+
+const char *directions[8] = {"right", "down right", "down", "down left", "left", "up left", "up", "up right"};
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  grideye.setFramerate10FPS();
+
+}
+
+void loop() {
+
+  if (grideye.getFrameRaw(frame) && motion.update(frame)) {
+    uint8_t direction = motion.getDirection();
+    if (direction != GRIDEYE_MOTION_NONE) {
+      int16_t dx, dy;
+      motion.getDominant(&dx, &dy);
+      // Q8 pixels per frame, 10 frames per second
+      float speed = sqrt((float)dx * dx + (float)dy * dy) * 10 / GRIDEYE_MOTION_ONE;
+      Serial.print(directions[direction]);
+      Serial.print(" at ");
+      Serial.print(speed);
+      Serial.print(" px/s, ");
+      Serial.print(motion.getMovingCount());
+      Serial.println(" cells moving");
+    }
+  }
+
+  delay(100);
+
+}
@@ -0,0 +1,81 @@
+/*
+  Packed Frame History on the Panasonic Grid-EYE
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+  This example keeps the last 20 frames, two seconds at 10 frames per second, in a
+  GridEYEFrameRing. Each frame is stored as the difference from a background frame taken
+  at startup, 80 bytes instead of 128, so the history fits where only 12 plain frames
+  would. Open the serial terminal at 115200 to see how much the center pixel has changed
+  over the last two seconds. Wave your hand in front of the sensor to see it jump.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+#define HISTORY_FRAMES 20
+
+GridEYE grideye;
+GridEYEFrameRing history;
+
+int16_t background[64];
+int16_t frame[64];
+uint8_t historyBuffer[HISTORY_FRAMES * GRIDEYE_DELTA_BYTES];
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  grideye.setFramerate10FPS();
+  delay(200); // Let a full frame land at the new rate
+  grideye.getFrameRaw(background);
+  history.begin(historyBuffer, sizeof(historyBuffer), background);
+
+}
+
+void loop() {
+
+  if (grideye.getFrameRaw(frame)) {
+    if (history.push(frame) != 0) {
+      Serial.println("Some pixels are too far from the background to store exactly");
+    }
+
+    // Center pixel now and two seconds ago, read in place without unpacking
+    uint16_t oldest = history.getCount() - 1;
+    int16_t change = history.getPixel(0, 27) - history.getPixel(oldest, 27);
+    Serial.print("Center pixel changed ");
+    Serial.print(change * 0.25);
+    Serial.print(" C over ");
+    Serial.print(history.getCount());
+    Serial.println(" frames");
+  }
+
+  delay(100);
+
+}
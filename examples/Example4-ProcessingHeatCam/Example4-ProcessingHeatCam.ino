@@ -28,6 +28,10 @@
   use them to generate a thermal image. If you don't have Processing, you can download it here:
   https://processing.org/
   
+  Set BINARY_FRAMES to 1 to send each frame as 134 bytes instead, for the Linux ingestion daemon in
+  extras/linux: 0xAA 0x55, a sequence number, the 128 pixel register bytes, the 2 thermistor
+  register bytes and a checksum. The Processing sketch only reads the comma separated values.
+  
   Hardware Connections:
   Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
   Plug the sensor onto the shield
@@ -36,8 +40,15 @@
 #include <Wire.h>
 #include <SparkFun_GridEYE_Arduino_Library.h>
 
+#define BINARY_FRAMES 0
+
 GridEYE grideye;
 
+#if BINARY_FRAMES
+uint8_t packet[134];
+uint8_t sequence = 0;
+#endif
+
 void setup() {
 
   // Start your preferred I2C object 
@@ -51,6 +62,26 @@ void setup() {
 
 void loop() {
 
+#if BINARY_FRAMES
+  // Sync, sequence, then the registers exactly as the sensor holds them
+  uint16_t thermistor = 0;
+  packet[0] = 0xAA;
+  packet[1] = 0x55;
+  packet[2] = sequence++;
+  if (grideye.getRegisterBlock(TEMPERATURE_REGISTER_START, &packet[3], 128) &&
+      grideye.getRegister16(THERMISTOR_REGISTER_LSB, &thermistor)) {
+    packet[131] = thermistor & 0xFF;
+    packet[132] = thermistor >> 8;
+
+    // Inverted sum of everything after the sync
+    uint8_t checksum = 0;
+    for (unsigned char i = 2; i < 133; i++) {
+      checksum += packet[i];
+    }
+    packet[133] = ~checksum;
+    Serial.write(packet, sizeof(packet));
+  }
+#else
   // Print the temperature value of each pixel in floating point degrees Celsius
   // separated by commas 
   for(unsigned char i = 0; i < 64; i++){
@@ -60,6 +91,7 @@ void loop() {
 
   // End each frame with a linefeed
   Serial.println();
+#endif
 
   // Give Processing time to chew
   delay(100);
@@ -37,6 +37,12 @@ import processing.serial.*;
 String myString = null;
 Serial myPort;  // The serial port
 
+// Histogram of the current frame in quarter degree bins (the sensor's own
+// resolution) from -512C, used to find the display range without sorting
+int[] counts = new int[4096];
+float low = 20;
+float high = 40;
+
 float[] temps =  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
 
 // The statements in the setup() function 
@@ -81,11 +87,20 @@ void draw() {
   // separated values
   String splitString[] = splitTokens(myString, ",");
   
-  // for each of the 64 values, map the temperatures between 20C and 40C
-  // to the blue through red portion of the color space
+  // count each of the 64 values into the histogram, then use its 1st and
+  // 99th percentiles as the range, never narrower than 2C
+  java.util.Arrays.fill(counts, 0);
+  for(int q = 0; q < 64; q++){
+    counts[constrain(round(float(splitString[q]) * 4) + 2048, 0, 4095)]++;
+  }
+  low = percentile(1);
+  high = max(percentile(99), low + 2);
+  
+  // map the temperatures between low and high to the blue through red
+  // portion of the color space
   for(int q = 0; q < 64; q++){
    
-    temps[q] = map(float(splitString[q]), 20, 40, 240, 360);
+    temps[q] = map(float(splitString[q]), low, high, 240, 360);
     
   }
   }
@@ -123,3 +138,15 @@ void draw() {
   // visual interpolation between pixels.
   filter(BLUR,10);
 } 
+
+// Temperature below which the given percent of this frame's pixels fall
+float percentile(int percent){
+  int rank = max(1, (64 * percent + 99) / 100);
+  int seen = 0;
+  int bin = 0;
+  while(seen + counts[bin] < rank){
+    seen += counts[bin];
+    bin++;
+  }
+  return (bin - 2048) / 4.0;
+}
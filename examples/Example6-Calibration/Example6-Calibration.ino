@@ -0,0 +1,137 @@
+/*
+  Per-Pixel Calibration of the Panasonic Grid-EYE Sensor
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  This example builds a per-pixel offset table for the GridEYE and keeps it in EEPROM. Cover the
+  sensor with something of even temperature (a piece of cardboard held flat works well) and send
+  'c' in the serial terminal at 115200 to capture. After that every frame is corrected as it is
+  read. Send 'x' to go back to uncorrected frames. On boards without EEPROM the table is only kept
+  until reset.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+#include <EEPROM.h>
+#define HAS_EEPROM
+#endif
+
+// Where the calibration blob lives in EEPROM
+#define CALIBRATION_EEPROM_ADDRESS 0
+
+GridEYE grideye;
+GridEYECalibration calibration;
+
+int16_t frame[64];
+uint8_t blob[GRIDEYE_CALIBRATION_SIZE];
+
+void setup() {
+
+  // Start your preferred I2C object
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+#ifdef HAS_EEPROM
+#if !defined(ARDUINO_ARCH_AVR)
+  EEPROM.begin(GRIDEYE_CALIBRATION_SIZE);
+#endif
+  // Load a previous calibration, if there is a valid one
+  for (int i = 0; i < GRIDEYE_CALIBRATION_SIZE; i++)
+    blob[i] = EEPROM.read(CALIBRATION_EEPROM_ADDRESS + i);
+  if (calibration.deserialize(blob)) {
+    grideye.setCalibration(&calibration);
+    Serial.println("Loaded calibration from EEPROM");
+  }
+#endif
+
+}
+
+void loop() {
+
+  if (Serial.available()) {
+    char command = Serial.read();
+    if (command == 'c') {
+      captureCalibration();
+    } else if (command == 'x') {
+      grideye.setCalibration(NULL);
+      Serial.println("Calibration off");
+    }
+  }
+
+  // Print the frame in degrees C, calibrated or not
+  if (grideye.getFrameRaw(frame)) {
+    for (unsigned char i = 0; i < 64; i++) {
+      Serial.print(frame[i] * 0.25);
+      Serial.print(" ");
+      if ((i + 1) % 8 == 0) {
+        Serial.println();
+      }
+    }
+    Serial.println();
+  }
+
+  delay(500);
+
+}
+
+void captureCalibration() {
+
+  Serial.println("Capturing, keep the sensor covered...");
+
+  // Reference frames must be uncorrected
+  grideye.setCalibration(NULL);
+
+  calibration.beginCapture();
+  for (int i = 0; i < GRIDEYE_CAL_MAX_CAPTURE_FRAMES; i++) {
+    delay(100); // One new frame every 100ms at 10FPS
+    if (grideye.getFrameRaw(frame)) {
+      calibration.addFrame(frame);
+    }
+  }
+
+  if (!calibration.computeOffsets()) {
+    Serial.println("Capture failed");
+    return;
+  }
+
+  grideye.setCalibration(&calibration);
+  Serial.println("Calibration done");
+
+#ifdef HAS_EEPROM
+  calibration.serialize(blob);
+  for (int i = 0; i < GRIDEYE_CALIBRATION_SIZE; i++)
+    EEPROM.write(CALIBRATION_EEPROM_ADDRESS + i, blob[i]);
+#if !defined(ARDUINO_ARCH_AVR)
+  EEPROM.commit();
+#endif
+  Serial.println("Saved to EEPROM");
+#endif
+
+}
@@ -0,0 +1,92 @@
+/*
+  Ambient Drift Compensation for the Panasonic Grid-EYE Sensor
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  This example samples the GridEYE's thermistor on a slow schedule instead of every frame and uses
+  it to keep pixel readings referenced to the ambient temperature at startup. The service switches
+  to a faster schedule whenever the board temperature jumps. Touch the sensor board with a finger
+  and watch the transient flag and drift rate in the serial terminal at 115200.
+
+  The drift coefficient depends on the module and mounting. Measure it by warming the board with
+  the sensor looking at a fixed scene and dividing the change in pixel reading by the change in
+  thermistor reading.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+// Pixels read this much high per degree of board warming, Q8 (128 = 0.5C per C)
+#define DRIFT_COEFFICIENT 128
+
+GridEYE grideye;
+GridEYEThermistor thermistor;
+
+int16_t frame[64];
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  // Sample every 10s normally, every 250ms while the board temperature is moving
+  thermistor.setInterval(10000);
+  thermistor.setFastInterval(250);
+  thermistor.setDriftCoefficient(DRIFT_COEFFICIENT);
+
+  // From now on getFrameRaw() takes care of sampling and correction
+  grideye.attachThermistor(&thermistor);
+
+}
+
+void loop() {
+
+  if (grideye.getFrameRaw(frame)) {
+    // Average the corrected frame
+    long total = 0;
+    for (unsigned char i = 0; i < 64; i++) {
+      total += frame[i];
+    }
+
+    Serial.print("Frame average: ");
+    Serial.print(total / 64.0 * 0.25);
+    Serial.print("C  Ambient: ");
+    Serial.print(thermistor.getFiltered() * 0.0625);
+    Serial.print("C  Drift: ");
+    Serial.print(thermistor.getRate() * 0.0625);
+    Serial.print("C/min");
+    if (thermistor.isTransient()) {
+      Serial.print("  TRANSIENT");
+    }
+    Serial.println();
+  }
+
+  delay(100);
+
+}
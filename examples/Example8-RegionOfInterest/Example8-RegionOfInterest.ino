@@ -0,0 +1,103 @@
+/*
+  Region of Interest Tracking for the Panasonic Grid-EYE Sensor
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  This example follows the warmest object in view and only reads the rows around it. A full frame
+  is read every ten updates, and whenever the object is lost, to look for new objects. Each line in
+  the serial terminal at 115200 shows the region that was read, the object's bounding box and how
+  long the read took, so you can compare region reads with full frame reads.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+GridEYE grideye;
+GridEYETracker tracker;
+
+// Keeps the last value of every pixel, region reads only update part of it
+int16_t frame[64];
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  // Anything 1.5C above the scene average is an object
+  tracker.setThreshold(6);
+  tracker.setRefreshInterval(10);
+
+}
+
+void loop() {
+
+  unsigned long start = micros();
+  bool ok = tracker.update(grideye, frame);
+  unsigned long elapsed = micros() - start;
+
+  if (ok) {
+    GridEYERegion region;
+    tracker.getRegion(&region);
+
+    Serial.print(tracker.wasFullFrame() ? "Full frame  " : "Region read ");
+    Serial.print(elapsed);
+    Serial.print("us");
+
+    if (tracker.hasTarget()) {
+      GridEYERegion box;
+      tracker.getTarget(&box);
+      uint8_t hottest = tracker.getHottestPixel();
+
+      Serial.print("  Object at ");
+      Serial.print(box.x);
+      Serial.print(",");
+      Serial.print(box.y);
+      Serial.print(" size ");
+      Serial.print(box.width);
+      Serial.print("x");
+      Serial.print(box.height);
+      Serial.print("  Hottest ");
+      Serial.print(frame[hottest] * 0.25);
+      Serial.print("C  Next read ");
+      Serial.print(region.width);
+      Serial.print("x");
+      Serial.print(region.height);
+      Serial.print(" at ");
+      Serial.print(region.x);
+      Serial.print(",");
+      Serial.print(region.y);
+    } else {
+      Serial.print("  No object");
+    }
+    Serial.println();
+  }
+
+  delay(100);
+
+}
@@ -0,0 +1,85 @@
+/*
+  Streaming Only Changed Pixels from the Panasonic Grid-EYE Sensor
+  By: SparkFun Electronics
+  Date: October 18th, 2026
+
+  MIT License: Permission is hereby granted, free of charge, to any person obtaining a copy of this
+  software and associated documentation files (the "Software"), to deal in the Software without
+  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all copies or
+  substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/14568
+
+  Most frames are almost the same as the one before. This example compares each frame with the
+  last and sends only the pixels that moved by more than 0.5C, as index:temperature pairs separated
+  by commas, one line per frame. A still scene sends an empty line; wave a hand in front of the
+  sensor to see the events. Open the serial terminal at 115200.
+
+  Set BINARY_STREAM to 1 to send the compact binary encoding instead: an 8 byte change mask
+  followed by two bytes per changed pixel. GridEYEChangeDetector::decode() unpacks it on the
+  receiving side.
+
+  Hardware Connections:
+  Attach the Qwiic Shield to your Arduino/Photon/ESP32 or other
+  Plug the sensor onto the shield
+*/
+
+#include <SparkFun_GridEYE_Arduino_Library.h>
+#include <Wire.h>
+
+#define BINARY_STREAM 0
+
+GridEYE grideye;
+GridEYEChangeDetector changes;
+
+int16_t frame[64];
+
+void setup() {
+
+  // Start your preferred I2C object 
+  Wire.begin();
+  // Library assumes "Wire" for I2C but you can pass something else with begin() if you like
+  grideye.begin();
+  // Pour a bowl of serial
+  Serial.begin(115200);
+
+  // Ignore changes of 0.5C or less
+  changes.setDeadband(2);
+
+}
+
+void loop() {
+
+  if (grideye.getFrameRaw(frame)) {
+    uint8_t count = changes.update(frame);
+
+#if BINARY_STREAM
+    uint8_t encoded[GRIDEYE_CHANGES_MAX_ENCODED];
+    Serial.write(encoded, changes.encode(encoded));
+#else
+    const uint8_t *pixels = changes.getEventIndices();
+    const int16_t *values = changes.getEventValues();
+    for (uint8_t i = 0; i < count; i++) {
+      Serial.print(pixels[i]);
+      Serial.print(":");
+      Serial.print(values[i] * 0.25);
+      Serial.print(",");
+    }
+    Serial.println();
+#endif
+  }
+
+  delay(100);
+
+}
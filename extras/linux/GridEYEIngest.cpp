@@ -0,0 +1,217 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Serial and pty ingestion into a GridEYEShmRing.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYEIngest.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <termios.h>
+#include <unistd.h>
+
+static speed_t baudConstant(uint32_t baud)
+{
+  switch (baud)
+  {
+  case 9600:
+    return B9600;
+  case 19200:
+    return B19200;
+  case 38400:
+    return B38400;
+  case 57600:
+    return B57600;
+  case 230400:
+    return B230400;
+  case 460800:
+    return B460800;
+  case 921600:
+    return B921600;
+  case 1000000:
+    return B1000000;
+  case 2000000:
+    return B2000000;
+  default:
+    return B115200;
+  }
+}
+
+GridEYEIngest::GridEYEIngest(GridEYEShmRing &ring) : _ring(ring)
+{
+  _epoll = epoll_create1(EPOLL_CLOEXEC);
+  _count = 0;
+  _active = 0;
+  _now = 0;
+  _frames = 0;
+  _bytes = 0;
+}
+
+GridEYEIngest::~GridEYEIngest()
+{
+  for (int i = 0; i < _count; i++)
+  {
+    if (_sources[i].open)
+      close(_sources[i].fd);
+  }
+  if (_epoll >= 0)
+    close(_epoll);
+}
+
+/********************************************************
+ * Sources
+ ********************************************************
+ *
+ * addSource() - raw mode so the line discipline neither
+ *    rewrites line endings nor echoes anything back to the
+ *    sender. Non-blocking: drain() reads until EAGAIN.
+ *
+ ********************************************************/
+
+int GridEYEIngest::addSource(const char *path, uint32_t baud)
+{
+  int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0)
+    return -1;
+
+  struct termios tty;
+  if (tcgetattr(fd, &tty) == 0)
+  {
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, baudConstant(baud));
+    cfsetospeed(&tty, baudConstant(baud));
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_cc[VMIN] = 1;
+    tty.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tty);
+    tcflush(fd, TCIFLUSH); // Drop whatever queued up before we started
+  }
+
+  int index = addSource(fd);
+  if (index < 0)
+    close(fd);
+  return index;
+}
+
+int GridEYEIngest::addSource(int fd)
+{
+  if ((_epoll < 0) || (_count >= GRIDEYE_INGEST_MAX_SOURCES))
+    return -1;
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  Source *source = &_sources[_count];
+  source->fd = fd;
+  source->index = _count;
+  source->open = true;
+  source->owner = this;
+  source->parser.reset();
+  source->parser.setHandler(onFrame, source);
+
+  struct epoll_event event;
+  event.events = EPOLLIN;
+  event.data.ptr = source;
+  if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) != 0)
+    return -1;
+
+  _active++;
+  return _count++;
+}
+
+/********************************************************
+ * Reading
+ ********************************************************/
+
+uint32_t GridEYEIngest::poll(int timeoutMs)
+{
+  struct epoll_event events[GRIDEYE_INGEST_MAX_SOURCES];
+  int ready = epoll_wait(_epoll, events, GRIDEYE_INGEST_MAX_SOURCES, timeoutMs);
+  if (ready <= 0)
+    return 0;
+
+  uint64_t before = _frames;
+  for (int i = 0; i < ready; i++)
+    drain((Source *)events[i].data.ptr);
+  return (uint32_t)(_frames - before);
+}
+
+void GridEYEIngest::run(volatile bool *stop)
+{
+  while (!*stop && (_active > 0))
+    poll(100);
+}
+
+// A pty reads EIO once the other side has closed, a serial port 0 once unplugged
+void GridEYEIngest::drain(Source *source)
+{
+  for (;;)
+  {
+    ssize_t got = read(source->fd, _buffer, sizeof(_buffer));
+    if (got > 0)
+    {
+      _bytes += got;
+      _now = hostMicros64();
+      source->parser.parse(_buffer, got);
+      if ((size_t)got < sizeof(_buffer))
+        return;
+      continue;
+    }
+    if ((got < 0) && (errno == EINTR))
+      continue;
+    if ((got < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+      return;
+
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, source->fd, NULL);
+    close(source->fd);
+    source->open = false;
+    _active--;
+    return;
+  }
+}
+
+void GridEYEIngest::onFrame(const GridEYEStreamFrame *frame, void *context)
+{
+  Source *source = (Source *)context;
+  GridEYEIngest *ingest = source->owner;
+  ingest->_ring.publish(frame, source->index, ingest->_now);
+  ingest->_frames++;
+}
+
+/********************************************************
+ * Counters
+ ********************************************************/
+
+int GridEYEIngest::activeSources()
+{
+  return _active;
+}
+
+uint64_t GridEYEIngest::frames()
+{
+  return _frames;
+}
+
+uint64_t GridEYEIngest::bytes()
+{
+  return _bytes;
+}
+
+GridEYEStreamParser &GridEYEIngest::parser(int source)
+{
+  return _sources[source].parser;
+}
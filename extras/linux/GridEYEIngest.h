@@ -0,0 +1,77 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Reads GridEYE frame streams from serial ports or ptys and publishes
+  the decoded frames to a GridEYEShmRing.
+
+  One thread serves every source through epoll. Each source has its own
+  GridEYEStreamParser, so CSV and binary senders can be mixed. Reads go
+  into one fixed buffer and frames are written straight from the parser
+  into the ring: nothing is allocated once sources are added.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "GridEYEShmRing.h"
+#include "GridEYEStreamParser.h"
+
+#define GRIDEYE_INGEST_MAX_SOURCES 32
+#define GRIDEYE_INGEST_READ_BYTES 65536
+
+class GridEYEIngest
+{
+public:
+  explicit GridEYEIngest(GridEYEShmRing &ring);
+  ~GridEYEIngest();
+
+  // Opens a serial port or pty, raw 8N1 at baud (ignored for ptys).
+  // Returns the source index frames are tagged with, or -1.
+  int addSource(const char *path, uint32_t baud = 115200);
+  int addSource(int fd); // Takes ownership of an open descriptor
+
+  // Wait up to timeoutMs for input, then read and publish everything available.
+  // Returns the frames published.
+  uint32_t poll(int timeoutMs);
+  void run(volatile bool *stop);
+
+  int activeSources(); // Sources not yet hung up
+  uint64_t frames();
+  uint64_t bytes();
+  GridEYEStreamParser &parser(int source);
+
+private:
+  struct Source
+  {
+    int fd;
+    uint16_t index;
+    bool open;
+    GridEYEIngest *owner;
+    GridEYEStreamParser parser;
+  };
+
+  static void onFrame(const GridEYEStreamFrame *frame, void *context);
+  void drain(Source *source);
+
+  GridEYEShmRing &_ring;
+  int _epoll;
+  Source _sources[GRIDEYE_INGEST_MAX_SOURCES];
+  int _count;
+  int _active;
+  uint64_t _now;
+  uint64_t _frames;
+  uint64_t _bytes;
+  uint8_t _buffer[GRIDEYE_INGEST_READ_BYTES];
+};
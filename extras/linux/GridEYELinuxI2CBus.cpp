@@ -0,0 +1,218 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Native Linux bus backend using /dev/i2c-N.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYELinuxI2CBus.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+// Descriptor handed out by the fake device
+#define FAKE_I2C_FD 1000
+
+/********************************************************
+ * File descriptor layer
+ ********************************************************/
+
+GridEYEI2CDevOps::GridEYEI2CDevOps()
+{
+  _syscalls = 0;
+}
+
+int GridEYEI2CDevOps::openDevice(const char *path)
+{
+  _syscalls++;
+  return open(path, O_RDWR);
+}
+
+int GridEYEI2CDevOps::ioctlDevice(int fd, unsigned long request, void *arg)
+{
+  _syscalls++;
+  return ioctl(fd, request, arg);
+}
+
+int GridEYEI2CDevOps::closeDevice(int fd)
+{
+  _syscalls++;
+  return close(fd);
+}
+
+uint32_t GridEYEI2CDevOps::syscalls()
+{
+  return _syscalls;
+}
+
+void GridEYEI2CDevOps::resetSyscalls()
+{
+  _syscalls = 0;
+}
+
+void GridEYEFakeI2CDev::attach(GridEYESimDevice *device)
+{
+  _devices.push_back(device);
+}
+
+int GridEYEFakeI2CDev::openDevice(const char *path)
+{
+  (void)path;
+  _syscalls++;
+  return FAKE_I2C_FD;
+}
+
+int GridEYEFakeI2CDev::closeDevice(int fd)
+{
+  _syscalls++;
+  return (fd == FAKE_I2C_FD) ? 0 : -1;
+}
+
+// Accepts what the kernel would: a lone write, or a register write followed by a read
+int GridEYEFakeI2CDev::ioctlDevice(int fd, unsigned long request, void *arg)
+{
+  _syscalls++;
+
+  if ((fd != FAKE_I2C_FD) || (request != I2C_RDWR))
+  {
+    errno = EINVAL;
+    return -1;
+  }
+
+  struct i2c_rdwr_ioctl_data *data = (struct i2c_rdwr_ioctl_data *)arg;
+  if ((data->nmsgs < 1) || (data->nmsgs > 2) || (data->msgs[0].flags & I2C_M_RD) || (data->msgs[0].len < 1))
+  {
+    errno = EINVAL;
+    return -1;
+  }
+
+  GridEYESimDevice *device = NULL;
+  for (size_t i = 0; i < _devices.size(); i++)
+  {
+    if (_devices[i]->address() == data->msgs[0].addr)
+      device = _devices[i];
+  }
+  if (device == NULL)
+  {
+    errno = ENXIO; // No ACK
+    return -1;
+  }
+
+  struct i2c_msg *first = &data->msgs[0];
+  bool ok;
+  if (data->nmsgs == 1)
+  {
+    ok = device->write(first->buf[0], first->buf + 1, first->len - 1);
+  }
+  else
+  {
+    struct i2c_msg *second = &data->msgs[1];
+    ok = (second->flags & I2C_M_RD) && (second->addr == first->addr) && (first->len == 1) &&
+         device->read(first->buf[0], second->buf, second->len);
+  }
+
+  if (!ok)
+  {
+    errno = EIO;
+    return -1;
+  }
+  return (int)data->nmsgs;
+}
+
+/********************************************************
+ * Bus backend
+ ********************************************************/
+
+GridEYELinuxI2CBus::GridEYELinuxI2CBus(GridEYEI2CDevOps *ops)
+{
+  _ops = (ops != NULL) ? ops : &_defaultOps;
+  _fd = -1;
+}
+
+GridEYELinuxI2CBus::~GridEYELinuxI2CBus()
+{
+  end();
+}
+
+bool GridEYELinuxI2CBus::begin(int busNumber)
+{
+  char path[32];
+  snprintf(path, sizeof(path), "/dev/i2c-%d", busNumber);
+  return begin(path);
+}
+
+bool GridEYELinuxI2CBus::begin(const char *path)
+{
+  end();
+  _fd = _ops->openDevice(path);
+  return (_fd >= 0);
+}
+
+void GridEYELinuxI2CBus::end()
+{
+  if (_fd >= 0)
+    _ops->closeDevice(_fd);
+  _fd = -1;
+}
+
+GridEYEI2CDevOps *GridEYELinuxI2CBus::ops()
+{
+  return _ops;
+}
+
+bool GridEYELinuxI2CBus::submit(GridEYETransfer *transfer)
+{
+  uint8_t out[256];
+  struct i2c_msg msgs[2];
+  struct i2c_rdwr_ioctl_data data;
+
+  out[0] = transfer->reg;
+  msgs[0].addr = transfer->address;
+  msgs[0].flags = 0;
+  msgs[0].buf = out;
+  msgs[0].len = 1;
+  data.msgs = msgs;
+  data.nmsgs = 1;
+
+  if (transfer->readLength == 0)
+  {
+    // A register pointer write has no data, and writeData may be NULL
+    if (transfer->writeLength)
+      memcpy(out + 1, transfer->writeData, transfer->writeLength);
+    msgs[0].len += transfer->writeLength;
+  }
+  else
+  {
+    // Repeated start read, in the same ioctl
+    msgs[1].addr = transfer->address;
+    msgs[1].flags = I2C_M_RD;
+    msgs[1].buf = transfer->readData;
+    msgs[1].len = transfer->readLength;
+    data.nmsgs = 2;
+  }
+
+  bool result = (_fd >= 0) && (_ops->ioctlDevice(_fd, I2C_RDWR, &data) >= 0);
+
+  transfer->status = result ? GRIDEYE_TRANSFER_DONE : GRIDEYE_TRANSFER_ERROR;
+  if (transfer->onComplete != NULL)
+    transfer->onComplete(transfer);
+
+  return true;
+}
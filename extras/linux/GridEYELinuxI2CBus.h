@@ -0,0 +1,88 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Native Linux bus backend using /dev/i2c-N.
+
+  Every transfer is one I2C_RDWR ioctl: the register write and the
+  read that follows go out as two messages joined by a repeated
+  start, so a full 128-byte frame costs a single syscall. The
+  kernel driver has no buffer limit like Wire does, so there is no
+  chunking either.
+
+  All file descriptor calls go through GridEYEI2CDevOps. The default
+  implementation is the real open/ioctl/close; GridEYEFakeI2CDev
+  answers I2C_RDWR from simulated devices so the backend can be
+  exercised without hardware.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYESimDevice.h"
+
+#include <vector>
+
+class GridEYEI2CDevOps
+{
+public:
+  GridEYEI2CDevOps();
+  virtual ~GridEYEI2CDevOps() {}
+
+  // Same contract as the libc calls: -1 and errno on failure
+  virtual int openDevice(const char *path);
+  virtual int ioctlDevice(int fd, unsigned long request, void *arg);
+  virtual int closeDevice(int fd);
+
+  uint32_t syscalls(); // Every call above counts as one
+  void resetSyscalls();
+
+protected:
+  uint32_t _syscalls;
+};
+
+// Userspace stand-in for an i2c-dev file, backed by simulated devices
+class GridEYEFakeI2CDev : public GridEYEI2CDevOps
+{
+public:
+  void attach(GridEYESimDevice *device);
+
+  int openDevice(const char *path);
+  int ioctlDevice(int fd, unsigned long request, void *arg);
+  int closeDevice(int fd);
+
+private:
+  std::vector<GridEYESimDevice *> _devices;
+};
+
+class GridEYELinuxI2CBus : public GridEYEBus
+{
+public:
+  explicit GridEYELinuxI2CBus(GridEYEI2CDevOps *ops = NULL); // NULL uses the real syscalls
+  ~GridEYELinuxI2CBus();
+
+  bool begin(int busNumber); // Opens /dev/i2c-<busNumber>
+  bool begin(const char *path);
+  void end();
+
+  bool submit(GridEYETransfer *transfer);
+
+  GridEYEI2CDevOps *ops();
+
+private:
+  GridEYEI2CDevOps _defaultOps;
+  GridEYEI2CDevOps *_ops;
+  int _fd;
+};
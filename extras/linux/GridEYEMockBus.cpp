@@ -0,0 +1,185 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Completion driven mock bus backend for Linux hosts.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYEMockBus.h"
+
+#include <algorithm>
+#include <chrono>
+
+// Order the heap so the earliest due transfer is on top
+bool GridEYEMockBus::laterDue(const Pending &a, const Pending &b)
+{
+  return a.due > b.due;
+}
+
+GridEYEMockBus::GridEYEMockBus(uint32_t latencyUs, uint32_t jitterUs, uint32_t byteTimeUs)
+{
+  _latency = latencyUs;
+  _jitter = jitterUs;
+  _byteTime = byteTimeUs;
+  _seed = 0x1234567;
+  _stop = false;
+  _submitted = 0;
+  _inFlight = 0;
+  _completed = 0;
+  _reordered = 0;
+  _lastSequence = 0;
+
+  _thread = std::thread(&GridEYEMockBus::worker, this);
+}
+
+GridEYEMockBus::~GridEYEMockBus()
+{
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    _stop = true;
+  }
+  _wake.notify_all();
+  _thread.join();
+}
+
+void GridEYEMockBus::attach(GridEYESimDevice *device)
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  _devices.push_back(device);
+}
+
+GridEYESimDevice *GridEYEMockBus::findDevice(uint8_t address)
+{
+  for (size_t i = 0; i < _devices.size(); i++)
+  {
+    if (_devices[i]->address() == address)
+      return _devices[i];
+  }
+  return NULL;
+}
+
+bool GridEYEMockBus::submit(GridEYETransfer *transfer)
+{
+  std::lock_guard<std::mutex> guard(_lock);
+
+  // Small xorshift, enough to scatter completion times
+  _seed ^= _seed << 13;
+  _seed ^= _seed >> 17;
+  _seed ^= _seed << 5;
+  uint32_t jitter = (_jitter > 0) ? (_seed % _jitter) : 0;
+
+  uint32_t bytes = 2 + transfer->writeLength + transfer->readLength; // Address, register, payload
+  Pending pending;
+  pending.due = hostMicros64() + _latency + bytes * _byteTime + jitter;
+  pending.sequence = ++_submitted;
+  pending.transfer = transfer;
+
+  transfer->status = GRIDEYE_TRANSFER_PENDING;
+  _pending.push_back(pending);
+  std::push_heap(_pending.begin(), _pending.end(), laterDue);
+  _inFlight++;
+
+  _wake.notify_one();
+  return true;
+}
+
+void GridEYEMockBus::service()
+{
+  Completion completion;
+
+  for (;;)
+  {
+    {
+      std::lock_guard<std::mutex> guard(_lock);
+      if (_done.empty())
+        return;
+      completion = _done.front();
+      _done.pop_front();
+      _inFlight--;
+    }
+
+    completion.transfer->status = completion.ok ? GRIDEYE_TRANSFER_DONE : GRIDEYE_TRANSFER_ERROR;
+    if (completion.transfer->onComplete != NULL)
+      completion.transfer->onComplete(completion.transfer);
+  }
+}
+
+// The "DMA engine": wait for the earliest due transfer, run it against the device
+void GridEYEMockBus::worker()
+{
+  std::unique_lock<std::mutex> lock(_lock);
+
+  while (!_stop)
+  {
+    if (_pending.empty())
+    {
+      _wake.wait(lock);
+      continue;
+    }
+
+    uint64_t now = hostMicros64();
+    uint64_t due = _pending.front().due;
+    if (due > now)
+    {
+      _wake.wait_for(lock, std::chrono::microseconds(due - now));
+      continue;
+    }
+
+    std::pop_heap(_pending.begin(), _pending.end(), laterDue);
+    Pending pending = _pending.back();
+    _pending.pop_back();
+
+    if (pending.sequence < _lastSequence)
+      _reordered++;
+    else
+      _lastSequence = pending.sequence;
+
+    GridEYETransfer *transfer = pending.transfer;
+    GridEYESimDevice *device = findDevice(transfer->address);
+
+    bool ok = (device != NULL);
+    if (ok)
+    {
+      if (transfer->readLength == 0)
+        ok = device->write(transfer->reg, transfer->writeData, transfer->writeLength);
+      else
+        ok = device->read(transfer->reg, transfer->readData, transfer->readLength);
+    }
+
+    Completion completion;
+    completion.transfer = transfer;
+    completion.ok = ok;
+    _done.push_back(completion);
+    _completed++;
+  }
+}
+
+uint32_t GridEYEMockBus::inFlight()
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  return _inFlight;
+}
+
+uint32_t GridEYEMockBus::reordered()
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  return _reordered;
+}
+
+uint32_t GridEYEMockBus::completed()
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  return _completed;
+}
@@ -0,0 +1,92 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Completion driven mock bus backend for Linux hosts.
+
+  Transfers are handed to a worker thread that plays the part of a
+  DMA engine: each one completes after a fixed latency, plus a per
+  byte wire time, plus random jitter. Jitter lets a later transfer
+  finish before an earlier one, so code on top has to cope with
+  out of order completion the same way it would with real
+  interrupt driven hardware.
+
+  Completions are delivered from service(), on the thread that
+  calls it, so the driver never sees a transfer change under it.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYESimDevice.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class GridEYEMockBus : public GridEYEBus
+{
+public:
+  // 400kHz I2C moves a byte (plus ACK) in 22.5us
+  explicit GridEYEMockBus(uint32_t latencyUs = 200, uint32_t jitterUs = 0, uint32_t byteTimeUs = 23);
+  ~GridEYEMockBus();
+
+  void attach(GridEYESimDevice *device);
+
+  bool submit(GridEYETransfer *transfer);
+  void service();
+
+  uint32_t inFlight();   // Submitted, not yet delivered by service()
+  uint32_t reordered();  // Completions that overtook an earlier submission
+  uint32_t completed();
+
+private:
+  struct Pending
+  {
+    uint64_t due;
+    uint32_t sequence;
+    GridEYETransfer *transfer;
+  };
+  struct Completion
+  {
+    GridEYETransfer *transfer;
+    bool ok;
+  };
+
+  static bool laterDue(const Pending &a, const Pending &b);
+  void worker();
+  GridEYESimDevice *findDevice(uint8_t address);
+
+  uint32_t _latency;
+  uint32_t _jitter;
+  uint32_t _byteTime;
+  uint32_t _seed;
+
+  std::vector<GridEYESimDevice *> _devices;
+  std::vector<Pending> _pending; // Min heap on due time
+  std::deque<Completion> _done;
+  std::mutex _lock;
+  std::condition_variable _wake;
+  std::thread _thread;
+  bool _stop;
+
+  uint32_t _submitted;
+  uint32_t _inFlight;
+  uint32_t _completed;
+  uint32_t _reordered;
+  uint32_t _lastSequence;
+};
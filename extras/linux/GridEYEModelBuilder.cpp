@@ -0,0 +1,490 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Host tools for GridEYEModel: a model blob writer and a reference
+  implementation of the runtime.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYEModelBuilder.h"
+
+#include <algorithm>
+#include <math.h>
+
+GridEYEModelBuilder::GridEYEModelBuilder()
+{
+  _layerCount = 0;
+  setInputQuantized(0, 1, 0, false);
+}
+
+/********************************************************
+ * Writing
+ ********************************************************/
+
+void GridEYEModelBuilder::putInt16(int16_t value)
+{
+  _layers.push_back((uint16_t)value & 0xFF);
+  _layers.push_back((uint16_t)value >> 8);
+}
+
+void GridEYEModelBuilder::putInt32(int32_t value)
+{
+  for (int i = 0; i < 4; i++)
+    _layers.push_back(((uint32_t)value >> (8 * i)) & 0xFF);
+}
+
+void GridEYEModelBuilder::quantizeScale(double scale, int16_t *multiplier, uint8_t *shift)
+{
+  // Largest shift that keeps the multiplier in 15 bits gives the most precision
+  int s = 46;
+  while (s > 0 && scale * ldexp(1.0, s) > 32767.0)
+    s--;
+  long m = lround(scale * ldexp(1.0, s));
+  if (m > 32767)
+    m = 32767;
+  *multiplier = (int16_t)m;
+  *shift = (uint8_t)s;
+}
+
+void GridEYEModelBuilder::setInputQuantized(int16_t offset, int16_t multiplier, uint8_t shift, bool subtractMean)
+{
+  _inputOffset = offset;
+  _inputMultiplier = multiplier;
+  _inputShift = shift;
+  _inputFlags = subtractMean ? GRIDEYE_MODEL_INPUT_MEAN : 0;
+  _scale = (float)(ldexp(1.0, shift) / multiplier);
+}
+
+void GridEYEModelBuilder::setInput(int16_t offset, float stepsPerLSB, bool subtractMean)
+{
+  int16_t multiplier;
+  uint8_t shift;
+  quantizeScale(stepsPerLSB, &multiplier, &shift);
+  if (shift > 30)
+    shift = 30; // The input path rounds with a 32-bit constant
+  setInputQuantized(offset, multiplier, shift, subtractMean);
+  _scale = 1.0f / stepsPerLSB;
+}
+
+void GridEYEModelBuilder::addConvQuantized(uint8_t outChannels, uint8_t kernel, uint8_t stride, int16_t multiplier,
+                                           uint8_t shift, const std::vector<int32_t> &bias,
+                                           const std::vector<int8_t> &weights, bool relu)
+{
+  _layers.push_back(GRIDEYE_LAYER_CONV);
+  _layers.push_back(relu ? GRIDEYE_MODEL_FUSED_RELU : 0);
+  _layers.push_back(outChannels);
+  _layers.push_back(kernel);
+  _layers.push_back(stride);
+  putInt16(multiplier);
+  _layers.push_back(shift);
+  for (size_t i = 0; i < bias.size(); i++)
+    putInt32(bias[i]);
+  for (size_t i = 0; i < weights.size(); i++)
+    _layers.push_back((uint8_t)weights[i]);
+  _layerCount++;
+
+}
+
+void GridEYEModelBuilder::addDepthwiseQuantized(uint8_t kernel, uint8_t stride, int16_t multiplier, uint8_t shift,
+                                                const std::vector<int32_t> &bias,
+                                                const std::vector<int8_t> &weights, bool relu)
+{
+  _layers.push_back(GRIDEYE_LAYER_DEPTHWISE);
+  _layers.push_back(relu ? GRIDEYE_MODEL_FUSED_RELU : 0);
+  _layers.push_back(kernel);
+  _layers.push_back(stride);
+  putInt16(multiplier);
+  _layers.push_back(shift);
+  for (size_t i = 0; i < bias.size(); i++)
+    putInt32(bias[i]);
+  for (size_t i = 0; i < weights.size(); i++)
+    _layers.push_back((uint8_t)weights[i]);
+  _layerCount++;
+
+}
+
+void GridEYEModelBuilder::addDenseQuantized(uint8_t outputs, int16_t multiplier, uint8_t shift,
+                                            const std::vector<int32_t> &bias, const std::vector<int8_t> &weights,
+                                            bool relu)
+{
+  _layers.push_back(GRIDEYE_LAYER_DENSE);
+  _layers.push_back(relu ? GRIDEYE_MODEL_FUSED_RELU : 0);
+  _layers.push_back(outputs);
+  putInt16(multiplier);
+  _layers.push_back(shift);
+  for (size_t i = 0; i < bias.size(); i++)
+    putInt32(bias[i]);
+  for (size_t i = 0; i < weights.size(); i++)
+    _layers.push_back((uint8_t)weights[i]);
+  _layerCount++;
+
+}
+
+void GridEYEModelBuilder::addReLU()
+{
+  _layers.push_back(GRIDEYE_LAYER_RELU);
+  _layers.push_back(0);
+  _layerCount++;
+}
+
+/********************************************************
+ * Floating point layers
+ ********************************************************
+ *
+ * Weights get one scale per tensor, max |w| / 127. The
+ * accumulator is then in units of input scale x weight
+ * scale, which is also the bias unit, and requantizing
+ * to the output scale is a multiply by their ratio.
+ *
+ ********************************************************/
+
+float GridEYEModelBuilder::quantizeWeights(const std::vector<float> &weights, std::vector<int8_t> *out)
+{
+  float largest = 0;
+  for (size_t i = 0; i < weights.size(); i++)
+    largest = fmaxf(largest, fabsf(weights[i]));
+  float scale = (largest > 0) ? largest / 127 : 1;
+
+  out->resize(weights.size());
+  for (size_t i = 0; i < weights.size(); i++)
+    (*out)[i] = (int8_t)lroundf(weights[i] / scale);
+  return scale;
+}
+
+std::vector<int32_t> GridEYEModelBuilder::quantizeBias(const std::vector<float> &bias, float scale)
+{
+  std::vector<int32_t> out(bias.size());
+  for (size_t i = 0; i < bias.size(); i++)
+    out[i] = (int32_t)lround(bias[i] / scale);
+  return out;
+}
+
+void GridEYEModelBuilder::addConv(uint8_t outChannels, uint8_t kernel, uint8_t stride, const std::vector<float> &bias,
+                                  const std::vector<float> &weights, float outputScale, bool relu)
+{
+  std::vector<int8_t> q;
+  float accScale = _scale * quantizeWeights(weights, &q);
+  int16_t multiplier;
+  uint8_t shift;
+  quantizeScale(accScale / outputScale, &multiplier, &shift);
+  addConvQuantized(outChannels, kernel, stride, multiplier, shift, quantizeBias(bias, accScale), q, relu);
+  _scale = outputScale;
+}
+
+void GridEYEModelBuilder::addDepthwise(uint8_t kernel, uint8_t stride, const std::vector<float> &bias,
+                                       const std::vector<float> &weights, float outputScale, bool relu)
+{
+  std::vector<int8_t> q;
+  float accScale = _scale * quantizeWeights(weights, &q);
+  int16_t multiplier;
+  uint8_t shift;
+  quantizeScale(accScale / outputScale, &multiplier, &shift);
+  addDepthwiseQuantized(kernel, stride, multiplier, shift, quantizeBias(bias, accScale), q, relu);
+  _scale = outputScale;
+}
+
+void GridEYEModelBuilder::addDense(uint8_t outputs, const std::vector<float> &bias, const std::vector<float> &weights,
+                                   float outputScale, bool relu)
+{
+  std::vector<int8_t> q;
+  float accScale = _scale * quantizeWeights(weights, &q);
+  int16_t multiplier;
+  uint8_t shift;
+  quantizeScale(accScale / outputScale, &multiplier, &shift);
+  addDenseQuantized(outputs, multiplier, shift, quantizeBias(bias, accScale), q, relu);
+  _scale = outputScale;
+}
+
+std::vector<uint8_t> GridEYEModelBuilder::build()
+{
+  std::vector<uint8_t> blob;
+  uint16_t length = (uint16_t)(GRIDEYE_MODEL_HEADER_SIZE + _layers.size() + 1);
+
+  blob.push_back('G');
+  blob.push_back('M');
+  blob.push_back(GRIDEYE_MODEL_VERSION);
+  blob.push_back(_layerCount);
+  blob.push_back(length & 0xFF);
+  blob.push_back(length >> 8);
+  blob.push_back(_inputFlags);
+  blob.push_back((uint16_t)_inputOffset & 0xFF);
+  blob.push_back((uint16_t)_inputOffset >> 8);
+  blob.push_back((uint16_t)_inputMultiplier & 0xFF);
+  blob.push_back((uint16_t)_inputMultiplier >> 8);
+  blob.push_back(_inputShift);
+  blob.insert(blob.end(), _layers.begin(), _layers.end());
+
+  uint8_t checksum = 0;
+  for (size_t i = 0; i < blob.size(); i++)
+    checksum += blob[i];
+  blob.push_back(~checksum);
+  return blob;
+}
+
+/********************************************************
+ * Reference runtime
+ ********************************************************/
+
+static int16_t getInt16(const std::vector<uint8_t> &blob, size_t at)
+{
+  return (int16_t)(blob[at] | (blob[at + 1] << 8));
+}
+
+static int32_t getInt32(const std::vector<uint8_t> &blob, size_t at)
+{
+  return (int32_t)((uint32_t)blob[at] | ((uint32_t)blob[at + 1] << 8) | ((uint32_t)blob[at + 2] << 16) |
+                   ((uint32_t)blob[at + 3] << 24));
+}
+
+bool GridEYEModelReference::load(const std::vector<uint8_t> &blob)
+{
+  _layers.clear();
+  _overflows = 0;
+  if (blob.size() < GRIDEYE_MODEL_HEADER_SIZE + 1 || blob[0] != 'G' || blob[1] != 'M' ||
+      blob[2] != GRIDEYE_MODEL_VERSION)
+    return false;
+  size_t length = (uint16_t)getInt16(blob, 4);
+  if (length != blob.size())
+    return false;
+  uint8_t checksum = 0;
+  for (size_t i = 0; i + 1 < length; i++)
+    checksum += blob[i];
+  if ((uint8_t)~checksum != blob[length - 1])
+    return false;
+
+  _inputFlags = blob[6];
+  _inputOffset = getInt16(blob, 7);
+  _inputMultiplier = getInt16(blob, 9);
+  _inputShift = blob[11];
+
+  size_t at = GRIDEYE_MODEL_HEADER_SIZE;
+  uint32_t h = 8, w = 8, c = 1;
+  _arena = 64;
+  _macs = 0;
+  for (int n = 0; n < blob[3]; n++)
+  {
+    if (at + 2 > length - 1)
+      return false;
+    Layer layer;
+    layer.type = blob[at];
+    layer.relu = blob[at + 1] & GRIDEYE_MODEL_FUSED_RELU;
+    layer.kernel = 1;
+    layer.stride = 1;
+    layer.outChannels = c;
+    at += 2;
+
+    size_t weightCount = 0;
+    uint32_t oh = h, ow = w;
+    switch (layer.type)
+    {
+    case GRIDEYE_LAYER_RELU:
+      _layers.push_back(layer);
+      continue;
+    case GRIDEYE_LAYER_CONV:
+      layer.outChannels = blob[at];
+      layer.kernel = blob[at + 1];
+      layer.stride = blob[at + 2];
+      layer.multiplier = getInt16(blob, at + 3);
+      layer.shift = blob[at + 5];
+      at += 6;
+      weightCount = layer.outChannels * layer.kernel * layer.kernel * c;
+      break;
+    case GRIDEYE_LAYER_DEPTHWISE:
+      layer.kernel = blob[at];
+      layer.stride = blob[at + 1];
+      layer.multiplier = getInt16(blob, at + 2);
+      layer.shift = blob[at + 4];
+      at += 5;
+      weightCount = layer.kernel * layer.kernel * c;
+      break;
+    case GRIDEYE_LAYER_DENSE:
+      layer.outChannels = blob[at];
+      layer.multiplier = getInt16(blob, at + 1);
+      layer.shift = blob[at + 3];
+      at += 4;
+      weightCount = layer.outChannels * h * w * c;
+      break;
+    default:
+      return false;
+    }
+    if (layer.outChannels == 0 || layer.kernel % 2 == 0 || layer.kernel > 7 || layer.stride < 1 ||
+        layer.stride > 2 || layer.shift > 46)
+      return false;
+    if (at + 4 * layer.outChannels + weightCount > length - 1)
+      return false;
+
+    for (uint32_t i = 0; i < layer.outChannels; i++, at += 4)
+      layer.bias.push_back(getInt32(blob, at));
+    for (size_t i = 0; i < weightCount; i++, at++)
+      layer.weights.push_back((int8_t)blob[at]);
+
+    if (layer.type == GRIDEYE_LAYER_DENSE)
+    {
+      oh = ow = 1;
+      _macs += weightCount;
+    }
+    else
+    {
+      oh = (h + layer.stride - 1) / layer.stride;
+      ow = (w + layer.stride - 1) / layer.stride;
+      // Count only taps that land inside the input
+      uint32_t taps = 0;
+      int pad = layer.kernel / 2;
+      for (uint32_t oy = 0; oy < oh; oy++)
+        for (uint32_t ox = 0; ox < ow; ox++)
+          for (int ky = 0; ky < layer.kernel; ky++)
+            for (int kx = 0; kx < layer.kernel; kx++)
+            {
+              int iy = oy * layer.stride + ky - pad;
+              int ix = ox * layer.stride + kx - pad;
+              if (iy >= 0 && iy < (int)h && ix >= 0 && ix < (int)w)
+                taps++;
+            }
+      _macs += taps * layer.outChannels * ((layer.type == GRIDEYE_LAYER_CONV) ? c : 1);
+    }
+
+    uint32_t pair = h * w * c + oh * ow * layer.outChannels;
+    if (pair > _arena)
+      _arena = pair;
+    h = oh;
+    w = ow;
+    c = layer.outChannels;
+    _layers.push_back(layer);
+  }
+
+  return at == length - 1;
+}
+
+int8_t GridEYEModelReference::requantize(int64_t acc, const Layer &layer)
+{
+  if (acc > INT32_MAX || acc < INT32_MIN)
+    _overflows++;
+
+  int64_t value;
+  if (layer.shift >= 15)
+  {
+    int right = layer.shift - 15;
+    value = (right > 0) ? (acc + ((int64_t)1 << (right - 1))) >> right : acc;
+  }
+  else
+  {
+    value = acc * ((int64_t)1 << (15 - layer.shift));
+  }
+  value = std::max<int64_t>(-32768, std::min<int64_t>(32767, value));
+  value = (value * layer.multiplier + 16384) >> 15;
+  return (int8_t)std::max<int64_t>(layer.relu ? 0 : -128, std::min<int64_t>(127, value));
+}
+
+bool GridEYEModelReference::run(const int16_t *frame, std::vector<int8_t> *output)
+{
+  int64_t offset = _inputOffset;
+  if (_inputFlags & GRIDEYE_MODEL_INPUT_MEAN)
+  {
+    int64_t total = 0;
+    for (int i = 0; i < 64; i++)
+      total += frame[i];
+    offset += total >> 6;
+  }
+
+  std::vector<int8_t> tensor(64);
+  for (int i = 0; i < 64; i++)
+  {
+    int64_t v = (frame[i] - offset) * _inputMultiplier;
+    if (_inputShift > 0)
+      v = (v + ((int64_t)1 << (_inputShift - 1))) >> _inputShift;
+    tensor[i] = (int8_t)std::max<int64_t>(-128, std::min<int64_t>(127, v));
+  }
+
+  int h = 8, w = 8, c = 1;
+  for (size_t n = 0; n < _layers.size(); n++)
+  {
+    const Layer &layer = _layers[n];
+    if (layer.type == GRIDEYE_LAYER_RELU)
+    {
+      for (size_t i = 0; i < tensor.size(); i++)
+        tensor[i] = std::max<int8_t>(0, tensor[i]);
+      continue;
+    }
+
+    std::vector<int8_t> out;
+    if (layer.type == GRIDEYE_LAYER_DENSE)
+    {
+      for (int o = 0; o < layer.outChannels; o++)
+      {
+        int64_t acc = layer.bias[o];
+        for (size_t i = 0; i < tensor.size(); i++)
+          acc += tensor[i] * layer.weights[o * tensor.size() + i];
+        out.push_back(requantize(acc, layer));
+      }
+      h = w = 1;
+      c = layer.outChannels;
+    }
+    else
+    {
+      int k = layer.kernel;
+      int pad = k / 2;
+      int oh = (h + layer.stride - 1) / layer.stride;
+      int ow = (w + layer.stride - 1) / layer.stride;
+      int oc = layer.outChannels;
+      out.resize(oh * ow * oc);
+      for (int y = 0; y < oh; y++)
+        for (int x = 0; x < ow; x++)
+          for (int o = 0; o < oc; o++)
+          {
+            int64_t acc = layer.bias[o];
+            for (int ky = 0; ky < k; ky++)
+              for (int kx = 0; kx < k; kx++)
+              {
+                int iy = y * layer.stride + ky - pad;
+                int ix = x * layer.stride + kx - pad;
+                if (iy < 0 || iy >= h || ix < 0 || ix >= w)
+                  continue;
+                if (layer.type == GRIDEYE_LAYER_CONV)
+                {
+                  for (int i = 0; i < c; i++)
+                    acc += tensor[(iy * w + ix) * c + i] * layer.weights[((o * k + ky) * k + kx) * c + i];
+                }
+                else
+                {
+                  acc += tensor[(iy * w + ix) * c + o] * layer.weights[(ky * k + kx) * c + o];
+                }
+              }
+            out[(y * ow + x) * oc + o] = requantize(acc, layer);
+          }
+      h = oh;
+      w = ow;
+      c = oc;
+    }
+    tensor.swap(out);
+  }
+
+  *output = tensor;
+  return true;
+}
+
+uint32_t GridEYEModelReference::arenaSize()
+{
+  return _arena;
+}
+
+uint32_t GridEYEModelReference::macs()
+{
+  return _macs;
+}
+
+uint32_t GridEYEModelReference::overflows()
+{
+  return _overflows;
+}
@@ -0,0 +1,122 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Host tools for GridEYEModel: a model blob writer and a reference
+  implementation of the runtime.
+
+  GridEYEModelBuilder writes the blob format described in
+  SparkFun_GridEYE_Inference.h. Layers can be given already quantized
+  (int8 weights, int32 bias, multiplier and shift) or in floating
+  point with the scale of each layer's output, in which case weights
+  are quantized per tensor and the multiplier and shift are derived.
+  Scales are in raw frame LSB (0.25C) per int8 step for the input,
+  and in whatever units the previous layer produced after that.
+
+  GridEYEModelReference parses a blob and runs it with plain nested
+  loops on std::vector tensors and 64-bit accumulators. It is written
+  from the format description, not from the runtime, so agreement
+  between the two is a real check. It also flags any accumulator that
+  would not fit the int32 the runtime uses.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+#include <vector>
+
+class GridEYEModelBuilder
+{
+public:
+  GridEYEModelBuilder();
+
+  // Input quantization: q = (raw - offset [- mean]) * stepsPerLSB
+  void setInput(int16_t offset, float stepsPerLSB, bool subtractMean);
+  void setInputQuantized(int16_t offset, int16_t multiplier, uint8_t shift, bool subtractMean);
+
+  // Already quantized layers. Weight layouts are as in the blob format.
+  void addConvQuantized(uint8_t outChannels, uint8_t kernel, uint8_t stride, int16_t multiplier, uint8_t shift,
+                        const std::vector<int32_t> &bias, const std::vector<int8_t> &weights, bool relu);
+  void addDepthwiseQuantized(uint8_t kernel, uint8_t stride, int16_t multiplier, uint8_t shift,
+                             const std::vector<int32_t> &bias, const std::vector<int8_t> &weights, bool relu);
+  void addDenseQuantized(uint8_t outputs, int16_t multiplier, uint8_t shift, const std::vector<int32_t> &bias,
+                         const std::vector<int8_t> &weights, bool relu);
+  void addReLU();
+
+  // Floating point layers. outputScale is the real value of one int8 step of the output.
+  void addConv(uint8_t outChannels, uint8_t kernel, uint8_t stride, const std::vector<float> &bias,
+               const std::vector<float> &weights, float outputScale, bool relu);
+  void addDepthwise(uint8_t kernel, uint8_t stride, const std::vector<float> &bias,
+                    const std::vector<float> &weights, float outputScale, bool relu);
+  void addDense(uint8_t outputs, const std::vector<float> &bias, const std::vector<float> &weights,
+                float outputScale, bool relu);
+
+  std::vector<uint8_t> build();
+
+  // Nearest multiplier / 2^shift to scale with the multiplier in 16384..32767
+  static void quantizeScale(double scale, int16_t *multiplier, uint8_t *shift);
+
+private:
+  void putInt16(int16_t value);
+  void putInt32(int32_t value);
+  float quantizeWeights(const std::vector<float> &weights, std::vector<int8_t> *out);
+  std::vector<int32_t> quantizeBias(const std::vector<float> &bias, float scale);
+
+  std::vector<uint8_t> _layers;
+  uint8_t _layerCount;
+  uint8_t _inputFlags;
+  int16_t _inputOffset;
+  int16_t _inputMultiplier;
+  uint8_t _inputShift;
+  float _scale; // Real value of one step of the current tensor
+};
+
+class GridEYEModelReference
+{
+public:
+  // Returns false if the blob does not parse
+  bool load(const std::vector<uint8_t> &model);
+  bool run(const int16_t *frame, std::vector<int8_t> *output);
+
+  uint32_t arenaSize(); // Largest input plus output of any layer
+  uint32_t macs();      // Multiply-accumulates per run
+  uint32_t overflows(); // Accumulators seen outside int32 so far
+
+private:
+  struct Layer
+  {
+    uint8_t type;
+    bool relu;
+    uint16_t outChannels;
+    uint8_t kernel;
+    uint8_t stride;
+    int16_t multiplier;
+    uint8_t shift;
+    std::vector<int32_t> bias;
+    std::vector<int8_t> weights;
+  };
+
+  int8_t requantize(int64_t acc, const Layer &layer);
+
+  uint8_t _inputFlags;
+  int16_t _inputOffset;
+  int16_t _inputMultiplier;
+  uint8_t _inputShift;
+  std::vector<Layer> _layers;
+  uint32_t _arena;
+  uint32_t _macs;
+  uint32_t _overflows;
+};
@@ -0,0 +1,372 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Multi-threaded host pipeline for many GridEYE streams.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYEPipeline.h"
+
+#include <algorithm>
+
+GridEYESensorSource::GridEYESensorSource(GridEYE &sensor)
+{
+  _sensor = &sensor;
+}
+
+bool GridEYESensorSource::read(uint8_t *raw)
+{
+  return _sensor->getRegisterBlock(TEMPERATURE_REGISTER_START, raw, GRIDEYE_FRAME_BYTES);
+}
+
+GridEYEPipeline::GridEYEPipeline()
+{
+  _workerCount = (uint16_t)std::max(1u, std::thread::hardware_concurrency());
+  _hotThreshold = 4 * 4; // 4C above the frame mean
+  _callback = NULL;
+  _context = NULL;
+  _acquiring = false;
+  _running = false;
+  _acquired = 0;
+  _published = 0;
+  _stalls = 0;
+  _stolen = 0;
+}
+
+GridEYEPipeline::~GridEYEPipeline()
+{
+  stop();
+  for (size_t i = 0; i < _sensors.size(); i++)
+    delete _sensors[i];
+  for (size_t i = 0; i < _rings.size(); i++)
+    delete _rings[i];
+}
+
+uint16_t GridEYEPipeline::addSensor(uint16_t bus, GridEYEFrameSource *source, GridEYECalibration *calibration)
+{
+  Sensor *sensor = new Sensor();
+  sensor->id = (uint16_t)_sensors.size();
+  sensor->bus = bus;
+  sensor->source = source;
+  sensor->calibration = calibration;
+  sensor->nextSequence = 0;
+  sensor->stalled = false;
+  sensor->inFlight = 0;
+  sensor->nextPublish = 0;
+  for (int i = 0; i < GRIDEYE_PIPELINE_WINDOW; i++)
+    sensor->ready[i] = false;
+  _sensors.push_back(sensor);
+
+  while (_rings.size() <= bus)
+  {
+    Ring *ring = new Ring();
+    ring->head = 0;
+    ring->tail = 0;
+    _rings.push_back(ring);
+  }
+
+  return sensor->id;
+}
+
+void GridEYEPipeline::setWorkers(uint16_t workers)
+{
+  _workerCount = (workers > 0) ? workers : 1;
+}
+
+void GridEYEPipeline::setHotThreshold(int16_t raw)
+{
+  _hotThreshold = raw;
+}
+
+void GridEYEPipeline::setCallback(GridEYEPipelineCallback callback, void *context)
+{
+  _callback = callback;
+  _context = context;
+}
+
+void GridEYEPipeline::start()
+{
+  if (_running)
+    return;
+
+  _running = true;
+  _acquiring = true;
+
+  for (uint16_t i = 0; i < _workerCount; i++)
+    _workers.push_back(new Worker());
+  for (uint16_t i = 0; i < _workerCount; i++)
+    _workers[i]->thread = std::thread(&GridEYEPipeline::work, this, i);
+  for (uint16_t bus = 0; bus < _rings.size(); bus++)
+    _acquisition.push_back(std::thread(&GridEYEPipeline::acquire, this, bus));
+}
+
+void GridEYEPipeline::stop()
+{
+  if (!_running)
+    return;
+
+  _acquiring = false;
+  for (size_t i = 0; i < _acquisition.size(); i++)
+    _acquisition[i].join();
+  _acquisition.clear();
+
+  // Let the workers finish what was acquired
+  while (_published < _acquired)
+    std::this_thread::yield();
+
+  // Idle workers may still be looking at each other's deques, so all of them
+  // have to be gone before any is freed
+  _running = false;
+  for (size_t i = 0; i < _workers.size(); i++)
+    _workers[i]->thread.join();
+  for (size_t i = 0; i < _workers.size(); i++)
+    delete _workers[i];
+  _workers.clear();
+}
+
+/********************************************************
+ * Acquisition, one thread per bus
+ ********************************************************
+ *
+ * Sensors on a bus are read round robin. A sensor with a
+ * full reorder window is skipped for this round rather
+ * than stalling the others on the bus. Nothing is thrown
+ * away; the sensor is read again once there is room, and
+ * each such hold up counts once as a stall.
+ *
+ ********************************************************/
+
+void GridEYEPipeline::acquire(uint16_t bus)
+{
+  std::vector<Sensor *> sensors;
+  for (size_t i = 0; i < _sensors.size(); i++)
+  {
+    if (_sensors[i]->bus == bus)
+      sensors.push_back(_sensors[i]);
+  }
+
+  Ring *ring = _rings[bus];
+
+  while (_acquiring)
+  {
+    bool progress = false;
+
+    for (size_t i = 0; i < sensors.size(); i++)
+    {
+      Sensor *sensor = sensors[i];
+
+      uint32_t head = ring->head.load(std::memory_order_relaxed);
+      if ((sensor->inFlight.load(std::memory_order_acquire) >= GRIDEYE_PIPELINE_WINDOW) ||
+          (head - ring->tail.load(std::memory_order_acquire) >= GRIDEYE_PIPELINE_RING))
+      {
+        if (!sensor->stalled)
+          _stalls++;
+        sensor->stalled = true;
+        continue;
+      }
+      sensor->stalled = false;
+
+      Job *job = &sensor->jobs[sensor->nextSequence % GRIDEYE_PIPELINE_WINDOW];
+      if (!sensor->source->read(job->raw))
+        continue;
+
+      job->result.sensor = sensor->id;
+      job->result.sequence = sensor->nextSequence++;
+      job->result.timestamp = hostMicros64();
+      sensor->inFlight++;
+      _acquired++;
+
+      ring->slots[head % GRIDEYE_PIPELINE_RING] = job;
+      ring->head.store(head + 1, std::memory_order_release);
+      progress = true;
+    }
+
+    if (sensors.empty())
+      break;
+    if (!progress)
+      std::this_thread::yield(); // Everything backed up, let the workers catch up
+  }
+}
+
+/********************************************************
+ * Work stealing pool
+ ********************************************************
+ *
+ * Worker w is the consumer of every bus ring with
+ * bus % workers == w and moves what it finds into its own
+ * deque. It works from the front of its deque; idle
+ * workers steal from the back of the others'.
+ *
+ ********************************************************/
+
+void GridEYEPipeline::work(uint16_t index)
+{
+  while (true)
+  {
+    Job *job = take(index);
+    if (job != NULL)
+    {
+      process(job);
+      publish(job);
+      continue;
+    }
+
+    if (!_running)
+      break;
+    std::this_thread::yield();
+  }
+}
+
+bool GridEYEPipeline::drain(uint16_t index)
+{
+  Worker *worker = _workers[index];
+  bool found = false;
+
+  for (size_t bus = index; bus < _rings.size(); bus += _workerCount)
+  {
+    Ring *ring = _rings[bus];
+    uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint32_t head = ring->head.load(std::memory_order_acquire);
+    if (tail == head)
+      continue;
+
+    std::lock_guard<std::mutex> guard(worker->lock);
+    for (; tail != head; tail++)
+      worker->jobs.push_back(ring->slots[tail % GRIDEYE_PIPELINE_RING]);
+    ring->tail.store(tail, std::memory_order_release);
+    found = true;
+  }
+
+  return found;
+}
+
+GridEYEPipeline::Job *GridEYEPipeline::take(uint16_t index)
+{
+  drain(index);
+
+  Worker *self = _workers[index];
+  {
+    std::lock_guard<std::mutex> guard(self->lock);
+    if (!self->jobs.empty())
+    {
+      Job *job = self->jobs.front();
+      self->jobs.pop_front();
+      return job;
+    }
+  }
+
+  for (uint16_t i = 1; i < _workerCount; i++)
+  {
+    Worker *victim = _workers[(index + i) % _workerCount];
+    std::lock_guard<std::mutex> guard(victim->lock);
+    if (!victim->jobs.empty())
+    {
+      Job *job = victim->jobs.back();
+      victim->jobs.pop_back();
+      _stolen++;
+      return job;
+    }
+  }
+
+  return NULL;
+}
+
+/********************************************************
+ * Per frame stages
+ ********************************************************
+ *
+ * decode - register bytes to sign extended 0.25C values,
+ *    calibrated if the sensor has tables
+ *
+ * filter - GridEYEFilter's 3x3 median, edges replicated
+ *
+ * detect - mean, pixels more than the hot threshold above
+ *    it, and the hottest pixel
+ *
+ ********************************************************/
+
+void GridEYEPipeline::process(Job *job)
+{
+  GridEYEPipelineResult *result = &job->result;
+
+  int16_t padded[GRIDEYE_PADDED_SIZE];
+  int16_t filtered[GRIDEYE_PADDED_SIZE];
+  GridEYE::decodeRaw(job->raw, result->frame, _sensors[result->sensor]->calibration);
+  GridEYEFilter::pad(result->frame, padded);
+  GridEYEFilter::median3x3(padded, filtered);
+  GridEYEFilter::unpad(filtered, result->frame);
+
+  int32_t total = 0;
+  result->hottestPixel = 0;
+  result->hottestValue = INT16_MIN;
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    int16_t value = result->frame[i];
+    total += value;
+    if (value > result->hottestValue)
+    {
+      result->hottestValue = value;
+      result->hottestPixel = i;
+    }
+  }
+  result->mean = (int16_t)(total / 64);
+
+  int16_t level = result->mean + _hotThreshold;
+  uint64_t mask = 0;
+  for (uint8_t i = 0; i < 64; i++)
+    mask |= (uint64_t)(result->frame[i] > level) << i;
+  result->hotMask = mask;
+  result->hotCount = (uint8_t)__builtin_popcountll(mask);
+}
+
+void GridEYEPipeline::publish(Job *job)
+{
+  Sensor *sensor = _sensors[job->result.sensor];
+  std::lock_guard<std::mutex> guard(sensor->publishLock);
+
+  sensor->ready[job->result.sequence % GRIDEYE_PIPELINE_WINDOW] = true;
+
+  // Hand out everything that is now contiguous
+  while (sensor->ready[sensor->nextPublish % GRIDEYE_PIPELINE_WINDOW])
+  {
+    uint32_t slot = sensor->nextPublish % GRIDEYE_PIPELINE_WINDOW;
+    if (_callback != NULL)
+      _callback(sensor->jobs[slot].result, _context);
+    sensor->ready[slot] = false;
+    sensor->nextPublish++;
+    sensor->inFlight--;
+    _published++;
+  }
+}
+
+uint64_t GridEYEPipeline::acquired()
+{
+  return _acquired;
+}
+
+uint64_t GridEYEPipeline::published()
+{
+  return _published;
+}
+
+uint64_t GridEYEPipeline::stalls()
+{
+  return _stalls;
+}
+
+uint64_t GridEYEPipeline::stolen()
+{
+  return _stolen;
+}
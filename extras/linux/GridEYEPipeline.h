@@ -0,0 +1,163 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Multi-threaded host pipeline for many GridEYE streams.
+
+  One acquisition thread per bus reads raw 128-byte frames from its
+  sensors in turn and pushes them into a lock-free single producer,
+  single consumer ring. Worker threads drain the rings into their
+  own deques and steal from each other when they run dry, so any
+  worker can process any sensor's frame. Each frame goes through
+  decode (with optional calibration), a 3x3 median filter and hot
+  spot detection.
+
+  Frames of one sensor can finish out of order on different
+  workers; results are held in a small per-sensor reorder window and
+  published strictly in acquisition order.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Frames of one sensor that may be in flight at once. Acquisition skips a sensor at the limit.
+#define GRIDEYE_PIPELINE_WINDOW 32
+// Capacity of each bus ring, must be a power of two
+#define GRIDEYE_PIPELINE_RING 256
+
+// Where raw frames come from: a real sensor, a simulation or a recording
+class GridEYEFrameSource
+{
+public:
+  virtual ~GridEYEFrameSource() {}
+  virtual bool read(uint8_t *raw) = 0; // GRIDEYE_FRAME_BYTES, register order
+};
+
+// Reads a real sensor through the driver, one burst per frame
+class GridEYESensorSource : public GridEYEFrameSource
+{
+public:
+  explicit GridEYESensorSource(GridEYE &sensor);
+  bool read(uint8_t *raw);
+
+private:
+  GridEYE *_sensor;
+};
+
+struct GridEYEPipelineResult
+{
+  uint16_t sensor;
+  uint32_t sequence;       // Per sensor, consecutive
+  uint64_t timestamp;      // Acquisition time, us
+  int16_t frame[64];       // Decoded and filtered, 0.25C per LSB
+  uint64_t hotMask;        // Pixels above mean + hot threshold
+  uint8_t hotCount;
+  uint8_t hottestPixel;
+  int16_t hottestValue;
+  int16_t mean;
+};
+
+typedef void (*GridEYEPipelineCallback)(const GridEYEPipelineResult &result, void *context);
+
+class GridEYEPipeline
+{
+public:
+  GridEYEPipeline();
+  ~GridEYEPipeline();
+
+  // Set up before start(). Returns the sensor id used in results.
+  uint16_t addSensor(uint16_t bus, GridEYEFrameSource *source, GridEYECalibration *calibration = NULL);
+  void setWorkers(uint16_t workers);
+  void setHotThreshold(int16_t raw); // Above the frame mean, 0.25C per LSB
+  void setCallback(GridEYEPipelineCallback callback, void *context);
+
+  void start();
+  void stop(); // Finishes and publishes everything already acquired
+
+  uint64_t acquired();
+  uint64_t published();
+  uint64_t stalls();  // Times a sensor was held back because its window or its bus ring was full
+  uint64_t stolen();  // Frames a worker took from another worker's deque
+
+private:
+  // A frame moving through the pipeline. Each sensor owns GRIDEYE_PIPELINE_WINDOW of
+  // these, indexed by sequence, so nothing is allocated per frame.
+  struct Job
+  {
+    uint8_t raw[GRIDEYE_FRAME_BYTES];
+    GridEYEPipelineResult result;
+  };
+
+  // Lock-free single producer, single consumer ring of jobs
+  struct Ring
+  {
+    Job *slots[GRIDEYE_PIPELINE_RING];
+    std::atomic<uint32_t> head; // Next write, producer owned
+    std::atomic<uint32_t> tail; // Next read, consumer owned
+  };
+
+  struct Sensor
+  {
+    uint16_t id;
+    uint16_t bus;
+    GridEYEFrameSource *source;
+    GridEYECalibration *calibration;
+    uint32_t nextSequence; // Acquisition thread only
+    bool stalled;          // Acquisition thread only
+    std::atomic<uint32_t> inFlight;
+    Job jobs[GRIDEYE_PIPELINE_WINDOW];
+
+    std::mutex publishLock;
+    uint32_t nextPublish;
+    bool ready[GRIDEYE_PIPELINE_WINDOW];
+  };
+
+  struct Worker
+  {
+    std::mutex lock;
+    std::deque<Job *> jobs;
+    std::thread thread;
+  };
+
+  void acquire(uint16_t bus);
+  void work(uint16_t index);
+  bool drain(uint16_t index);
+  Job *take(uint16_t index);
+  void process(Job *job);
+  void publish(Job *job);
+
+  std::vector<Sensor *> _sensors;
+  std::vector<Ring *> _rings; // One per bus
+  std::vector<std::thread> _acquisition;
+  std::vector<Worker *> _workers;
+  uint16_t _workerCount;
+  int16_t _hotThreshold;
+  GridEYEPipelineCallback _callback;
+  void *_context;
+
+  std::atomic<bool> _acquiring;
+  std::atomic<bool> _running;
+  std::atomic<uint64_t> _acquired;
+  std::atomic<uint64_t> _published;
+  std::atomic<uint64_t> _stalls;
+  std::atomic<uint64_t> _stolen;
+};
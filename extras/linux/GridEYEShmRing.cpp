@@ -0,0 +1,264 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Shared memory ring of decoded GridEYE frames.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYEShmRing.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Atomics in shared memory must not fall back to a per-process lock
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "64-bit atomics must be lock free");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "32-bit atomics must be lock free");
+
+static long futex(std::atomic<uint32_t> *word, int op, uint32_t val, const struct timespec *timeout)
+{
+  return syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), op, val, timeout, NULL, 0);
+}
+
+GridEYEShmRing::GridEYEShmRing()
+{
+  _header = NULL;
+  _slots = NULL;
+  _size = 0;
+  _mask = 0;
+  _name[0] = 0;
+  _writer = false;
+}
+
+GridEYEShmRing::~GridEYEShmRing()
+{
+  close();
+}
+
+/********************************************************
+ * Mapping
+ ********************************************************
+ *
+ * create() - unlinks any old object first, so readers
+ *    still mapping a previous run keep their copy rather
+ *    than seeing this one rebuilt under them
+ *
+ ********************************************************/
+
+bool GridEYEShmRing::create(const char *name, uint32_t slots)
+{
+  close();
+  if ((slots == 0) || (slots & (slots - 1)))
+    return false;
+
+  snprintf(_name, sizeof(_name), "%s", name);
+  shm_unlink(_name);
+  int fd = shm_open(_name, O_CREAT | O_EXCL | O_RDWR, 0666);
+  if (fd < 0)
+    return false;
+
+  size_t size = sizeof(GridEYEShmHeader) + (size_t)slots * sizeof(GridEYEShmSlot);
+  void *map = MAP_FAILED;
+  if (ftruncate(fd, size) == 0)
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED)
+  {
+    shm_unlink(_name);
+    return false;
+  }
+
+  // ftruncate zero fills, which is a valid value for every atomic
+  _header = (GridEYEShmHeader *)map;
+  _slots = (GridEYEShmSlot *)(_header + 1);
+  _size = size;
+  _mask = slots - 1;
+  _writer = true;
+
+  _header->slots = slots;
+  _header->slotBytes = sizeof(GridEYEShmSlot);
+  _header->version = GRIDEYE_SHM_VERSION;
+  std::atomic_thread_fence(std::memory_order_release);
+  _header->magic = GRIDEYE_SHM_MAGIC;
+  return true;
+}
+
+bool GridEYEShmRing::open(const char *name)
+{
+  close();
+  snprintf(_name, sizeof(_name), "%s", name);
+
+  // Read and write: waiting readers register in the header
+  int fd = shm_open(_name, O_RDWR, 0);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  void *map = MAP_FAILED;
+  if ((fstat(fd, &st) == 0) && ((size_t)st.st_size >= sizeof(GridEYEShmHeader)))
+    map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED)
+    return false;
+
+  GridEYEShmHeader *header = (GridEYEShmHeader *)map;
+  uint32_t slots = header->slots;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  bool ok = (header->magic == GRIDEYE_SHM_MAGIC) && (header->version == GRIDEYE_SHM_VERSION) &&
+            (header->slotBytes == sizeof(GridEYEShmSlot)) && (slots != 0) && !(slots & (slots - 1)) &&
+            ((size_t)st.st_size >= sizeof(GridEYEShmHeader) + (size_t)slots * sizeof(GridEYEShmSlot));
+  if (!ok)
+  {
+    munmap(map, st.st_size);
+    return false;
+  }
+
+  _header = header;
+  _slots = (GridEYEShmSlot *)(_header + 1);
+  _size = st.st_size;
+  _mask = slots - 1;
+  _writer = false;
+  return true;
+}
+
+void GridEYEShmRing::unlink()
+{
+  if (_name[0])
+    shm_unlink(_name);
+}
+
+void GridEYEShmRing::close()
+{
+  if (_header != NULL)
+    munmap(_header, _size);
+  _header = NULL;
+  _slots = NULL;
+  _size = 0;
+}
+
+/********************************************************
+ * Writer
+ ********************************************************
+ *
+ * publish() - marks the slot odd, fills it, marks it
+ *    complete, then moves published on. The fence before
+ *    reading waiters pairs with the one in wait(): either
+ *    the writer sees the waiter, or the waiter sees the
+ *    new frame before it sleeps.
+ *
+ ********************************************************/
+
+void GridEYEShmRing::publish(const GridEYEStreamFrame *frame, uint16_t source, uint64_t timestamp)
+{
+  if (!_writer)
+    return;
+
+  uint64_t n = _header->published.load(std::memory_order_relaxed);
+  GridEYEShmSlot *slot = &_slots[n & _mask];
+
+  slot->sequence.store(2 * n + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot->timestamp = timestamp;
+  slot->source = source;
+  slot->format = frame->format;
+  slot->streamSequence = frame->sequence;
+  slot->thermistor = frame->thermistor;
+  memcpy(slot->pixels, frame->pixels, sizeof(slot->pixels));
+
+  slot->sequence.store(2 * n + 2, std::memory_order_release);
+  _header->published.store(n + 1, std::memory_order_release);
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_header->waiters.load(std::memory_order_relaxed) != 0)
+  {
+    _header->futex.fetch_add(1, std::memory_order_release);
+    futex(&_header->futex, FUTEX_WAKE, INT_MAX, NULL);
+  }
+}
+
+/********************************************************
+ * Readers
+ ********************************************************/
+
+uint64_t GridEYEShmRing::published()
+{
+  return (_header != NULL) ? _header->published.load(std::memory_order_acquire) : 0;
+}
+
+uint32_t GridEYEShmRing::slots()
+{
+  return _mask + 1;
+}
+
+uint64_t GridEYEShmRing::oldest()
+{
+  uint64_t count = published();
+  return (count > (uint64_t)_mask + 1) ? count - _mask - 1 : 0;
+}
+
+const GridEYEShmSlot *GridEYEShmRing::acquire(uint64_t n)
+{
+  if ((_header == NULL) || (n >= published()))
+    return NULL;
+
+  const GridEYEShmSlot *slot = &_slots[n & _mask];
+  if (slot->sequence.load(std::memory_order_acquire) != 2 * n + 2)
+    return NULL;
+  return slot;
+}
+
+bool GridEYEShmRing::valid(const GridEYEShmSlot *slot, uint64_t n)
+{
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot->sequence.load(std::memory_order_relaxed) == 2 * n + 2;
+}
+
+bool GridEYEShmRing::wait(uint64_t n, int timeoutMs)
+{
+  if (_header == NULL)
+    return false;
+  if (n < published())
+    return true;
+
+  uint64_t deadline = hostMicros64() + (uint64_t)timeoutMs * 1000;
+  _header->waiters.fetch_add(1, std::memory_order_relaxed);
+  bool ready = false;
+  for (;;)
+  {
+    uint32_t word = _header->futex.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (n < published())
+    {
+      ready = true;
+      break;
+    }
+
+    uint64_t now = hostMicros64();
+    if (now >= deadline)
+      break;
+    struct timespec timeout;
+    timeout.tv_sec = (deadline - now) / 1000000;
+    timeout.tv_nsec = ((deadline - now) % 1000000) * 1000;
+    futex(&_header->futex, FUTEX_WAIT, word, &timeout);
+  }
+  _header->waiters.fetch_sub(1, std::memory_order_relaxed);
+  return ready;
+}
@@ -0,0 +1,102 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Shared memory ring of decoded GridEYE frames, one writer and any
+  number of reader processes.
+
+  The ring lives in a POSIX shared memory object (/dev/shm). Frame n
+  goes in slot n % slots. Each slot carries a sequence word, a seqlock:
+  odd while the writer fills it, 2n + 2 once frame n is complete.
+  Readers work on the slot in place, without copying, and call valid()
+  when done: if the writer has lapped the slot meanwhile, the sequence
+  no longer matches and the reader drops what it read. Readers never
+  block the writer and the writer never waits for readers.
+
+  wait() sleeps on a futex in the header. The writer only makes the
+  wake system call while some reader is waiting.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYEStreamParser.h"
+
+#include <atomic>
+
+#define GRIDEYE_SHM_MAGIC 0x52594547 // "GEYR"
+#define GRIDEYE_SHM_VERSION 1
+#define GRIDEYE_SHM_DEFAULT_NAME "/grideye"
+#define GRIDEYE_SHM_DEFAULT_SLOTS 1024 // Must be a power of two
+
+struct alignas(64) GridEYEShmSlot
+{
+  std::atomic<uint64_t> sequence; // Seqlock, see above
+  uint64_t timestamp;             // hostMicros64() when the frame was parsed
+  uint16_t source;                // Input the frame came from
+  uint8_t format;                 // GRIDEYE_STREAM_CSV or GRIDEYE_STREAM_BINARY
+  uint8_t streamSequence;         // Sequence byte of binary frames
+  int16_t thermistor;             // 0.0625C per LSB, or GRIDEYE_STREAM_NO_THERMISTOR
+  int16_t pixels[GRIDEYE_PIXELS]; // 0.25C per LSB
+};
+
+struct alignas(64) GridEYEShmHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t slots;
+  uint32_t slotBytes;
+
+  alignas(64) std::atomic<uint64_t> published; // Frames written so far
+  std::atomic<uint32_t> futex;                 // Bumped on every publish while readers wait
+  std::atomic<uint32_t> waiters;
+};
+
+class GridEYEShmRing
+{
+public:
+  GridEYEShmRing();
+  ~GridEYEShmRing();
+
+  // Writer side. Creates or replaces the object. Returns false on failure.
+  bool create(const char *name = GRIDEYE_SHM_DEFAULT_NAME, uint32_t slots = GRIDEYE_SHM_DEFAULT_SLOTS);
+  void publish(const GridEYEStreamFrame *frame, uint16_t source, uint64_t timestamp);
+  void unlink(); // Remove the name; mapped readers keep working
+
+  // Reader side
+  bool open(const char *name = GRIDEYE_SHM_DEFAULT_NAME);
+
+  void close();
+
+  uint64_t published(); // Frames 0 .. published() - 1 have been written
+  uint32_t slots();
+  uint64_t oldest(); // Oldest frame still in the ring
+
+  // Slot holding frame n, or NULL if n isn't written yet or has been overwritten.
+  // The slot is read in place; call valid() after using it.
+  const GridEYEShmSlot *acquire(uint64_t n);
+  bool valid(const GridEYEShmSlot *slot, uint64_t n);
+
+  // Block until frame n is published or timeoutMs passes. Returns true if it was.
+  bool wait(uint64_t n, int timeoutMs);
+
+private:
+  GridEYEShmHeader *_header;
+  GridEYEShmSlot *_slots;
+  size_t _size;
+  uint32_t _mask;
+  char _name[64];
+  bool _writer;
+};
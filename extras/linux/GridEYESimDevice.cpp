@@ -0,0 +1,215 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Register level model of a GridEYE for host side backends.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYESimDevice.h"
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+GridEYESimDevice::GridEYESimDevice(uint8_t address)
+{
+  _address = address;
+  _reads = 0;
+  _writes = 0;
+  _bytesRead = 0;
+  _resets = 0;
+  _sceneStep = 0;
+  _modelStartup = false;
+  _answerAt = 0;
+  _validAt = 0;
+  reset();
+
+  // Room temperature scene: 22C pixels, 25C board
+  for (uint8_t i = 0; i < 64; i++)
+    setPixel(i, 22 * 4);
+  setThermistor(25 * 16);
+}
+
+uint8_t GridEYESimDevice::address()
+{
+  return _address;
+}
+
+// Power-on register values. The thermistor and pixels hold the scene, which
+// the sensor keeps converting; with startup modelled they read as zero until
+// the first frame.
+void GridEYESimDevice::reset()
+{
+  for (int i = 0; i < TEMPERATURE_REGISTER_START; i++)
+  {
+    if ((i != THERMISTOR_REGISTER_LSB) && (i != THERMISTOR_REGISTER_MSB))
+      _registers[i] = 0;
+  }
+  if (_modelStartup)
+    _validAt = hostMicros64() + 100000; // One frame at the default 10FPS
+}
+
+void GridEYESimDevice::modelStartup(bool enable)
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  _modelStartup = enable;
+}
+
+void GridEYESimDevice::powerCycle()
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  reset();
+  if (_modelStartup)
+  {
+    _answerAt = hostMicros64() + 50000;
+    _validAt = _answerAt + 100000;
+  }
+}
+
+bool GridEYESimDevice::answering()
+{
+  return hostMicros64() >= _answerAt;
+}
+
+bool GridEYESimDevice::outputValid()
+{
+  return hostMicros64() >= _validAt;
+}
+
+void GridEYESimDevice::setPixels(const int16_t *raw)
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    uint16_t val = (uint16_t)raw[i] & 0x0FFF;
+    _registers[TEMPERATURE_REGISTER_START + 2 * i] = val & 0xFF;
+    _registers[TEMPERATURE_REGISTER_START + 2 * i + 1] = val >> 8;
+  }
+}
+
+void GridEYESimDevice::setPixel(uint8_t pixelAddr, int16_t raw)
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  uint16_t val = (uint16_t)raw & 0x0FFF;
+  _registers[TEMPERATURE_REGISTER_START + 2 * pixelAddr] = val & 0xFF;
+  _registers[TEMPERATURE_REGISTER_START + 2 * pixelAddr + 1] = val >> 8;
+}
+
+void GridEYESimDevice::setThermistor(int16_t lsb)
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  // Sign and magnitude, like the real register
+  uint16_t val = (lsb < 0) ? (uint16_t)(0x0800 | ((-lsb) & 0x07FF)) : (uint16_t)(lsb & 0x07FF);
+  _registers[THERMISTOR_REGISTER_LSB] = val & 0xFF;
+  _registers[THERMISTOR_REGISTER_MSB] = val >> 8;
+}
+
+void GridEYESimDevice::stepScene()
+{
+  int16_t frame[64];
+  uint32_t step = _sceneStep++;
+
+  // Blob center sweeps each row left to right, 1/8 pixel per step
+  int32_t cx = (int32_t)(step % 64);
+  int32_t cy = (int32_t)(((step / 64) % 8) * 8);
+  for (int y = 0; y < 8; y++)
+  {
+    for (int x = 0; x < 8; x++)
+    {
+      int32_t dx = x * 8 - cx; // 1/8 pixel units
+      int32_t dy = y * 8 - cy;
+      int32_t d2 = (dx * dx + dy * dy) / 64; // Pixels squared
+      int32_t heat = (d2 < 9) ? (9 - d2) * 6 : 0; // Up to ~13C above background
+      frame[y * 8 + x] = (int16_t)(22 * 4 + heat + ((x * 7 + y * 3 + step) & 1));
+    }
+  }
+  setPixels(frame);
+}
+
+bool GridEYESimDevice::write(uint8_t reg, const uint8_t *data, uint8_t len)
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  if (!answering())
+    return false;
+  _writes++;
+
+  for (uint8_t i = 0; i < len; i++, reg++)
+  {
+    if (reg == STATUS_CLEAR_REGISTER)
+    {
+      _registers[STATUS_REGISTER] &= ~data[i];
+    }
+    else if (reg == RESET_REGISTER)
+    {
+      if (data[i] == 0x3F) // Initial reset
+        reset();
+      else if (data[i] == 0x30) // Flag reset
+        _registers[STATUS_REGISTER] = 0;
+      _resets++;
+    }
+    else if (reg < TEMPERATURE_REGISTER_START)
+    {
+      _registers[reg] = data[i];
+    }
+  }
+
+  return true;
+}
+
+bool GridEYESimDevice::read(uint8_t reg, uint8_t *data, uint8_t len)
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  if (!answering())
+    return false;
+  _reads++;
+  _bytesRead += len;
+
+  bool valid = outputValid();
+  for (uint8_t i = 0; i < len; i++)
+  {
+    uint8_t at = (uint8_t)(reg + i);
+    bool output = (at == THERMISTOR_REGISTER_LSB) || (at == THERMISTOR_REGISTER_MSB) || (at >= TEMPERATURE_REGISTER_START);
+    data[i] = (output && !valid) ? 0 : _registers[at];
+  }
+
+  return true;
+}
+
+uint8_t GridEYESimDevice::peek(uint8_t reg)
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  return _registers[reg];
+}
+
+uint32_t GridEYESimDevice::reads()
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  return _reads;
+}
+
+uint32_t GridEYESimDevice::writes()
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  return _writes;
+}
+
+uint32_t GridEYESimDevice::bytesRead()
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  return _bytesRead;
+}
+
+uint32_t GridEYESimDevice::resets()
+{
+  std::lock_guard<std::mutex> guard(_lock);
+  return _resets;
+}
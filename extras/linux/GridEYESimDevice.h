@@ -0,0 +1,78 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Register level model of a GridEYE for host side backends, demos
+  and benchmarks. Reads and writes behave like the real part: the
+  register pointer auto-increments, STATUS_CLEAR_REGISTER clears
+  status bits and RESET_REGISTER restores defaults.
+
+  With modelStartup() on, the device also keeps the part's startup
+  timing: it doesn't answer for 50ms after powerCycle(), and the
+  thermistor and pixel registers read zero from a power cycle or an
+  initial reset until the first frame has been converted.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <mutex>
+
+class GridEYESimDevice
+{
+public:
+  explicit GridEYESimDevice(uint8_t address = 0x69);
+
+  uint8_t address();
+
+  void setPixels(const int16_t *raw); // 64 signed values, 0.25C per LSB
+  void setPixel(uint8_t pixelAddr, int16_t raw);
+  void setThermistor(int16_t lsb); // 0.0625C per LSB
+
+  // Moves a warm blob across a room temperature background, one step per call
+  void stepScene();
+
+  void modelStartup(bool enable);
+  void powerCycle(); // Registers to defaults, as if power had just been applied
+
+  // Bus side access. Return false to NAK.
+  bool write(uint8_t reg, const uint8_t *data, uint8_t len);
+  bool read(uint8_t reg, uint8_t *data, uint8_t len);
+
+  uint8_t peek(uint8_t reg); // Register contents without counting a transaction
+
+  uint32_t reads();
+  uint32_t writes();
+  uint32_t bytesRead();
+  uint32_t resets();
+
+private:
+  void reset();
+  bool answering();
+  bool outputValid();
+
+  std::mutex _lock;
+  uint8_t _address;
+  uint8_t _registers[256];
+  uint32_t _reads;
+  uint32_t _writes;
+  uint32_t _bytesRead;
+  uint32_t _resets;
+  uint32_t _sceneStep;
+
+  bool _modelStartup;
+  uint64_t _answerAt; // hostMicros64() the bus comes alive
+  uint64_t _validAt;  // hostMicros64() the first frame lands
+};
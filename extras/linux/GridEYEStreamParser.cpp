@@ -0,0 +1,350 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Parser for GridEYE frames arriving over a serial line.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYEStreamParser.h"
+
+// Parser states
+#define STATE_IDLE 0  // Between frames
+#define STATE_VALUE 1 // Inside a CSV line
+#define STATE_SKIP 2  // Dropping a bad CSV line up to its newline
+#define STATE_SYNC 3  // Seen GRIDEYE_STREAM_SYNC0
+#define STATE_BODY 4  // Collecting a binary frame
+
+// Fraction digits kept; Example4 prints two, further ones can't change a quarter degree much
+#define MAX_FRACTION_DIGITS 4
+#define MAX_MANTISSA 100000000
+
+static const int32_t powersOf10[MAX_FRACTION_DIGITS + 1] = {1, 10, 100, 1000, 10000};
+
+static int16_t signExtend12(uint16_t val)
+{
+  return (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800;
+}
+
+GridEYEStreamParser::GridEYEStreamParser()
+{
+  _onFrame = NULL;
+  _context = NULL;
+  _emitted = 0;
+  _csvFrames = 0;
+  _binaryFrames = 0;
+  _badLines = 0;
+  _badChecksums = 0;
+  reset();
+}
+
+void GridEYEStreamParser::setHandler(void (*onFrame)(const GridEYEStreamFrame *frame, void *context), void *context)
+{
+  _onFrame = onFrame;
+  _context = context;
+}
+
+void GridEYEStreamParser::reset()
+{
+  _state = STATE_IDLE;
+  _count = 0;
+  _negative = false;
+  _fraction = false;
+  _digits = false;
+  _fractionDigits = 0;
+  _mantissa = 0;
+  _bodyLength = 0;
+}
+
+uint32_t GridEYEStreamParser::parse(const uint8_t *data, size_t len)
+{
+  _emitted = 0;
+  for (size_t i = 0; i < len; i++)
+  {
+    uint8_t c = data[i];
+
+    // Most bytes are pixel data or digits; take those without the full dispatch
+    if (_state == STATE_BODY)
+    {
+      _body[_bodyLength++] = c;
+      if (_bodyLength == GRIDEYE_STREAM_BODY_BYTES)
+        finishBinary();
+      continue;
+    }
+    if ((_state == STATE_VALUE) && ((uint8_t)(c - '0') < 10))
+    {
+      addDigit(c - '0');
+      continue;
+    }
+    parseByte(c);
+  }
+  return _emitted;
+}
+
+/********************************************************
+ * Byte dispatch
+ ********************************************************
+ *
+ * GRIDEYE_STREAM_SYNC0 isn't ASCII, so it starts a binary
+ * frame from any text state; a CSV line cut short by it is
+ * counted as bad. A sync byte not followed by
+ * GRIDEYE_STREAM_SYNC1 drops the rest of its line.
+ *
+ ********************************************************/
+
+void GridEYEStreamParser::parseByte(uint8_t c)
+{
+  switch (_state)
+  {
+  case STATE_SYNC:
+    if (c == GRIDEYE_STREAM_SYNC1)
+    {
+      _state = STATE_BODY;
+      _bodyLength = 0;
+      return;
+    }
+    if (c == GRIDEYE_STREAM_SYNC0)
+      return;
+    // Whatever follows a lone sync byte up to the line end is the tail of
+    // something, not a frame
+    _state = (c == '\n') ? STATE_IDLE : STATE_SKIP;
+    return;
+
+  case STATE_BODY:
+    _body[_bodyLength++] = c;
+    if (_bodyLength == GRIDEYE_STREAM_BODY_BYTES)
+      finishBinary();
+    return;
+
+  case STATE_SKIP:
+    if (c == '\n')
+    {
+      _badLines++;
+      reset();
+    }
+    else if (c == GRIDEYE_STREAM_SYNC0)
+    {
+      _badLines++;
+      reset();
+      _state = STATE_SYNC;
+    }
+    return;
+
+  default:
+    break;
+  }
+
+  if (c == GRIDEYE_STREAM_SYNC0)
+  {
+    if (_state == STATE_VALUE)
+      _badLines++;
+    reset();
+    _state = STATE_SYNC;
+    return;
+  }
+
+  if (_state == STATE_IDLE)
+  {
+    if ((c == '\n') || (c == '\r') || (c == ' '))
+      return;
+    _state = STATE_VALUE;
+    _count = 0;
+  }
+
+  // STATE_VALUE
+  if ((uint8_t)(c - '0') < 10)
+  {
+    addDigit(c - '0');
+  }
+  else if (c == ',')
+  {
+    if (!commitValue())
+      _state = STATE_SKIP;
+  }
+  else if (c == '.')
+  {
+    if (_fraction)
+      _state = STATE_SKIP;
+    _fraction = true;
+  }
+  else if (c == '-')
+  {
+    if (_digits || _negative || _fraction)
+      _state = STATE_SKIP;
+    _negative = true;
+  }
+  else if (c == '\n')
+  {
+    finishLine();
+  }
+  else if (c != '\r')
+  {
+    _state = STATE_SKIP;
+  }
+}
+
+/********************************************************
+ * CSV
+ ********************************************************
+ *
+ * addDigit() - integer digits up to MAX_MANTISSA, fraction
+ *    digits up to MAX_FRACTION_DIGITS, later ones dropped
+ *
+ * commitValue() - value * 4 / 10^fractionDigits rounded
+ *    half away from zero, clamped to the 12-bit range
+ *
+ ********************************************************/
+
+void GridEYEStreamParser::addDigit(uint8_t digit)
+{
+  if (!_fraction)
+  {
+    _mantissa = _mantissa * 10 + digit;
+    if (_mantissa >= MAX_MANTISSA)
+      _state = STATE_SKIP;
+  }
+  else if (_fractionDigits < MAX_FRACTION_DIGITS)
+  {
+    _mantissa = _mantissa * 10 + digit;
+    _fractionDigits++;
+  }
+  _digits = true;
+}
+
+bool GridEYEStreamParser::commitValue()
+{
+  if (!_digits || (_count >= GRIDEYE_PIXELS))
+    return false;
+
+  int32_t scale = powersOf10[_fractionDigits];
+  int32_t quarters = (int32_t)(((int64_t)_mantissa * 8 + scale) / (2 * scale));
+  if (_negative)
+    quarters = -quarters;
+  if (quarters > 2047)
+    quarters = 2047;
+  if (quarters < -2048)
+    quarters = -2048;
+  _frame.pixels[_count++] = (int16_t)quarters;
+
+  _negative = false;
+  _fraction = false;
+  _digits = false;
+  _fractionDigits = 0;
+  _mantissa = 0;
+  return true;
+}
+
+void GridEYEStreamParser::finishLine()
+{
+  // Example4 ends every value with a comma; accept a last value without one too
+  bool ok = true;
+  if (_digits || _negative || _fraction)
+    ok = commitValue();
+
+  if (ok && (_count == GRIDEYE_PIXELS))
+  {
+    _frame.thermistor = GRIDEYE_STREAM_NO_THERMISTOR;
+    _frame.format = GRIDEYE_STREAM_CSV;
+    _frame.sequence = 0;
+    _csvFrames++;
+    emit();
+  }
+  else
+  {
+    _badLines++;
+  }
+  reset();
+}
+
+/********************************************************
+ * Binary
+ ********************************************************/
+
+void GridEYEStreamParser::finishBinary()
+{
+  uint8_t checksum = 0;
+  for (uint8_t i = 0; i < GRIDEYE_STREAM_BODY_BYTES - 1; i++)
+    checksum += _body[i];
+
+  if ((uint8_t)~checksum == _body[GRIDEYE_STREAM_BODY_BYTES - 1])
+  {
+    const uint8_t *pixels = &_body[1];
+    for (uint8_t i = 0; i < GRIDEYE_PIXELS; i++)
+      _frame.pixels[i] = signExtend12(pixels[2 * i] | (pixels[2 * i + 1] << 8));
+
+    // Thermistor register is sign and magnitude
+    uint16_t therm = _body[1 + GRIDEYE_FRAME_BYTES] | (_body[2 + GRIDEYE_FRAME_BYTES] << 8);
+    _frame.thermistor = (therm & 0x0800) ? -(int16_t)(therm & 0x07FF) : (int16_t)(therm & 0x07FF);
+    _frame.format = GRIDEYE_STREAM_BINARY;
+    _frame.sequence = _body[0];
+    _binaryFrames++;
+    reset();
+    emit();
+    return;
+  }
+
+  // The sync may have been pixel data: look for a frame in what followed it
+  _badChecksums++;
+  uint8_t rescan[GRIDEYE_STREAM_BODY_BYTES];
+  memcpy(rescan, _body, sizeof(rescan));
+  reset();
+  for (uint8_t i = 0; i < GRIDEYE_STREAM_BODY_BYTES; i++)
+    parseByte(rescan[i]);
+}
+
+void GridEYEStreamParser::emit()
+{
+  _emitted++;
+  if (_onFrame != NULL)
+    _onFrame(&_frame, _context);
+}
+
+void GridEYEStreamParser::encodeBinary(const uint8_t *pixels, uint16_t thermistor, uint8_t sequence, uint8_t *out)
+{
+  out[0] = GRIDEYE_STREAM_SYNC0;
+  out[1] = GRIDEYE_STREAM_SYNC1;
+  out[2] = sequence;
+  memcpy(&out[3], pixels, GRIDEYE_FRAME_BYTES);
+  out[3 + GRIDEYE_FRAME_BYTES] = thermistor & 0xFF;
+  out[4 + GRIDEYE_FRAME_BYTES] = thermistor >> 8;
+
+  uint8_t checksum = 0;
+  for (uint16_t i = 2; i < GRIDEYE_STREAM_BINARY_BYTES - 1; i++)
+    checksum += out[i];
+  out[GRIDEYE_STREAM_BINARY_BYTES - 1] = ~checksum;
+}
+
+/********************************************************
+ * Counters
+ ********************************************************/
+
+uint32_t GridEYEStreamParser::csvFrames()
+{
+  return _csvFrames;
+}
+
+uint32_t GridEYEStreamParser::binaryFrames()
+{
+  return _binaryFrames;
+}
+
+uint32_t GridEYEStreamParser::badLines()
+{
+  return _badLines;
+}
+
+uint32_t GridEYEStreamParser::badChecksums()
+{
+  return _badChecksums;
+}
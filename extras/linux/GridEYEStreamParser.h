@@ -0,0 +1,114 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Parser for GridEYE frames arriving over a serial line.
+
+  Two formats are accepted on the same stream, frame by frame:
+    - CSV, as Example4 prints it: 64 Celsius values each followed by a
+      comma, one frame per line. Values are converted to raw quarter
+      degrees with integer arithmetic, rounding half away from zero.
+    - Binary, as Example4 sends it with BINARY_FRAMES set: 0xAA 0x55,
+      a sequence byte, the 128 pixel register bytes, the 2 thermistor
+      register bytes and an inverted sum8 checksum of everything after
+      the sync bytes.
+
+  The parser holds one frame of state and never allocates. Input can
+  be split anywhere. Lines that aren't 64 numbers and binary frames
+  with a bad checksum are counted and dropped; after a bad checksum the
+  search for the next sync restarts one byte after the rejected one. A
+  stray sync byte drops the rest of its line, so a damaged line can't
+  leave a tail that parses as a frame.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+#define GRIDEYE_STREAM_SYNC0 0xAA
+#define GRIDEYE_STREAM_SYNC1 0x55
+// Bytes after the sync: sequence, pixels, thermistor, checksum
+#define GRIDEYE_STREAM_BODY_BYTES (1 + GRIDEYE_FRAME_BYTES + 2 + 1)
+#define GRIDEYE_STREAM_BINARY_BYTES (2 + GRIDEYE_STREAM_BODY_BYTES)
+
+// Frame formats
+#define GRIDEYE_STREAM_CSV 1
+#define GRIDEYE_STREAM_BINARY 2
+
+#define GRIDEYE_STREAM_NO_THERMISTOR (-32767 - 1) // CSV lines carry no thermistor
+
+struct GridEYEStreamFrame
+{
+  int16_t pixels[GRIDEYE_PIXELS]; // Signed, 0.25C per LSB
+  int16_t thermistor;             // Signed, 0.0625C per LSB
+  uint8_t format;                 // GRIDEYE_STREAM_CSV or GRIDEYE_STREAM_BINARY
+  uint8_t sequence;               // Binary frames only
+};
+
+class GridEYEStreamParser
+{
+public:
+  GridEYEStreamParser();
+
+  // Called once per complete frame, from inside parse(). frame is only valid during the call.
+  void setHandler(void (*onFrame)(const GridEYEStreamFrame *frame, void *context), void *context);
+
+  void reset(); // Drop any partial frame
+
+  // Consume len bytes. Returns the number of frames completed.
+  uint32_t parse(const uint8_t *data, size_t len);
+
+  // Writes one binary frame for pixels (register order) and thermistor (register value).
+  // out holds GRIDEYE_STREAM_BINARY_BYTES.
+  static void encodeBinary(const uint8_t *pixels, uint16_t thermistor, uint8_t sequence, uint8_t *out);
+
+  uint32_t csvFrames();
+  uint32_t binaryFrames();
+  uint32_t badLines();     // CSV lines dropped
+  uint32_t badChecksums(); // Binary frames dropped
+
+private:
+  void parseByte(uint8_t c);
+  void addDigit(uint8_t digit);
+  bool commitValue();
+  void finishLine();
+  void finishBinary();
+  void emit();
+
+  void (*_onFrame)(const GridEYEStreamFrame *frame, void *context);
+  void *_context;
+
+  uint8_t _state;
+
+  // CSV
+  uint8_t _count;       // Values committed on this line
+  bool _negative;
+  bool _fraction;
+  bool _digits;         // The current value has at least one digit
+  uint8_t _fractionDigits;
+  int32_t _mantissa;
+
+  // Binary
+  uint8_t _body[GRIDEYE_STREAM_BODY_BYTES];
+  uint8_t _bodyLength;
+
+  GridEYEStreamFrame _frame;
+  uint32_t _emitted;
+
+  uint32_t _csvFrames;
+  uint32_t _binaryFrames;
+  uint32_t _badLines;
+  uint32_t _badChecksums;
+};
@@ -0,0 +1,223 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Benchmark for GridEYEChangeDetector.
+
+  Usage:
+    bench_changes [static recording] [busy recording]
+
+  Runs the change detector over a static scene (room background with
+  sensor noise) and a busy one (a warm blob sweeping the array, plus
+  noise), or over recordings of raw 128-byte frames. For each scene it
+  reports time per frame, changed pixels per frame and encoded bytes
+  per frame against the 128-byte full frame.
+
+  Every frame is also checked against a plain branching reference
+  implementation, and the encoded stream is decoded on a receiver
+  copy that has to match the detector's references. The two are
+  timed in turns, best of several rounds each, and a scene fails if
+  update() is slower than the reference.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYESimDevice.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#define SCENE_FRAMES 2048
+#define TIMING_PASSES 40
+#define TIMING_ROUNDS 5
+
+typedef std::vector<int16_t> Frames; // 64 values per frame
+
+static uint32_t noiseState = 0x12345678;
+
+static int16_t noise(int16_t amplitude)
+{
+  noiseState ^= noiseState << 13;
+  noiseState ^= noiseState >> 17;
+  noiseState ^= noiseState << 5;
+  return (int16_t)(noiseState % (2 * amplitude + 1)) - amplitude;
+}
+
+static bool loadRecording(const char *path, Frames *frames)
+{
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+  {
+    perror(path);
+    return false;
+  }
+  uint8_t raw[GRIDEYE_FRAME_BYTES];
+  int16_t frame[64];
+  while (fread(raw, 1, sizeof(raw), file) == sizeof(raw))
+  {
+    GridEYE::decodeRaw(raw, frame);
+    frames->insert(frames->end(), frame, frame + 64);
+  }
+  fclose(file);
+  return !frames->empty();
+}
+
+static void staticScene(Frames *frames)
+{
+  int16_t frame[64];
+  for (int n = 0; n < SCENE_FRAMES; n++)
+  {
+    for (uint8_t i = 0; i < 64; i++)
+      frame[i] = 22 * 4 + (i % 5) + noise(1);
+    frames->insert(frames->end(), frame, frame + 64);
+  }
+}
+
+static void busyScene(Frames *frames)
+{
+  GridEYESimDevice device;
+  uint8_t raw[GRIDEYE_FRAME_BYTES];
+  int16_t frame[64];
+  for (int n = 0; n < SCENE_FRAMES; n++)
+  {
+    device.stepScene();
+    device.read(TEMPERATURE_REGISTER_START, raw, sizeof(raw));
+    GridEYE::decodeRaw(raw, frame);
+    for (uint8_t i = 0; i < 64; i++)
+      frame[i] += noise(2);
+    frames->insert(frames->end(), frame, frame + 64);
+  }
+}
+
+// What update() computes, written the obvious way
+struct Reference
+{
+  int16_t last[64];
+  bool primed;
+
+  uint64_t update(const int16_t *frame, uint8_t deadband)
+  {
+    uint64_t mask = 0;
+    for (uint8_t i = 0; i < 64; i++)
+    {
+      if (!primed || abs(frame[i] - last[i]) > deadband)
+      {
+        last[i] = frame[i];
+        mask |= 1ULL << i;
+      }
+    }
+    primed = true;
+    return mask;
+  }
+};
+
+static bool runScene(const char *name, const Frames &frames)
+{
+  size_t count = frames.size() / 64;
+  GridEYEChangeDetector detector;
+  Reference reference;
+  reference.primed = false;
+
+  // Correctness pass
+  int16_t receiver[64] = {0};
+  uint8_t encoded[GRIDEYE_CHANGES_MAX_ENCODED];
+  uint64_t events = 0;
+  uint64_t bytes = 0;
+  uint32_t errors = 0;
+  for (size_t n = 0; n < count; n++)
+  {
+    const int16_t *frame = &frames[n * 64];
+    uint8_t changed = detector.update(frame);
+    uint64_t expected = reference.update(frame, GRIDEYE_CHANGES_DEFAULT_DEADBAND);
+
+    if ((detector.getMask() != expected) || (changed != __builtin_popcountll(expected)))
+      errors++;
+    const uint8_t *pixels = detector.getEventIndices();
+    const int16_t *values = detector.getEventValues();
+    for (uint8_t e = 0; e < changed; e++)
+    {
+      if ((values[e] != frame[pixels[e]]) || !((expected >> pixels[e]) & 1))
+        errors++;
+    }
+
+    size_t length = detector.encode(encoded);
+    if (GridEYEChangeDetector::decode(encoded, receiver) != length)
+      errors++;
+    if (memcmp(receiver, detector.getReference(), sizeof(receiver)) != 0)
+      errors++;
+
+    events += changed;
+    bytes += length;
+  }
+
+  // Timing, update() only. The two take turns and each keeps its best round,
+  // so a noisy host slows both rather than deciding the comparison.
+  volatile uint32_t sink = 0;
+  double detectorNs = 1e30;
+  double referenceNs = 1e30;
+  for (int round = 0; round < TIMING_ROUNDS; round++)
+  {
+    uint64_t start = hostMicros64();
+    for (int pass = 0; pass < TIMING_PASSES; pass++)
+    {
+      detector.reset();
+      for (size_t n = 0; n < count; n++)
+        sink += detector.update(&frames[n * 64]);
+    }
+    detectorNs = std::min(detectorNs, (hostMicros64() - start) * 1000.0 / (TIMING_PASSES * (double)count));
+
+    start = hostMicros64();
+    for (int pass = 0; pass < TIMING_PASSES; pass++)
+    {
+      reference.primed = false;
+      for (size_t n = 0; n < count; n++)
+        sink += (uint32_t)reference.update(&frames[n * 64], GRIDEYE_CHANGES_DEFAULT_DEADBAND);
+    }
+    referenceNs = std::min(referenceNs, (hostMicros64() - start) * 1000.0 / (TIMING_PASSES * (double)count));
+  }
+
+  bool faster = detectorNs <= referenceNs;
+  printf("%-8s %7zu %12.1f %11.1f %9.2f %13.1f %10.2f %7u  %s\n", name, count, detectorNs, referenceNs,
+         (double)events / count, (double)bytes / count, 128.0 * count / bytes, errors, faster ? "ok" : "SLOWER");
+  if (errors != 0)
+    printf("change detector disagrees with the reference\n");
+  return (errors == 0) && faster;
+}
+
+int main(int argc, char **argv)
+{
+  Frames still;
+  Frames busy;
+
+  if (argc > 2)
+  {
+    if (!loadRecording(argv[1], &still) || !loadRecording(argv[2], &busy))
+      return 1;
+  }
+  else
+  {
+    staticScene(&still);
+    busyScene(&busy);
+  }
+
+  printf("deadband %d LSB\n\n", GRIDEYE_CHANGES_DEFAULT_DEADBAND);
+  printf("scene     frames     ns/frame  branchy ns    events   bytes/frame    vs full  errors\n");
+  bool ok = runScene("static", still);
+  ok = runScene("busy", busy) && ok;
+
+  printf("%s\n", ok ? "all checks passed" : "FAILED");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,433 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Checks and cycle counts for the GridEYEFilter kernels.
+
+  Usage:
+    bench_filters
+
+  Every kernel is compared with a plain version that clamps each
+  coordinate on every access, on random full range frames, step edges,
+  checkerboards at the 12-bit limits and the simulated scene:
+    - median3x3 against a full sort of the nine values
+    - gaussian3x3 against a two pass [1 2 1] blur with the same rounding,
+      also on values up to +-8191
+    - sobel3x3 against a direct 3x3 Sobel with the same magnitude rule,
+      and the magnitude against sqrt(gx^2 + gy^2)
+    - the GridEYEFilter ping-pong chain against the same chain of
+      references, and the border after every kernel
+
+  Then each kernel and its clamped counterpart is timed, best of several
+  runs, in ns and in cycles per frame. Cycles are time stamp counter
+  ticks on x86, so they follow the nominal clock rather than the boost
+  clock; elsewhere only ns are shown.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYESimDevice.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_CYCLES 1
+static inline uint64_t cycles()
+{
+  return __rdtsc();
+}
+#else
+#define HAVE_CYCLES 0
+static inline uint64_t cycles()
+{
+  return 0;
+}
+#endif
+
+#define CHECK_FRAMES 2000
+#define TIMING_RUNS 11
+#define TIMING_CALLS 20000 // Per run
+
+static std::mt19937 rng(7);
+static uint32_t failures = 0;
+
+static void report(const char *name, uint32_t cases, uint32_t errors)
+{
+  printf("  %-48s %7u cases  %s\n", name, cases, errors ? "FAILED" : "ok");
+  if (errors)
+    failures++;
+}
+
+/********************************************************
+ * Clamped references
+ ********************************************************
+ *
+ * The way these filters usually get written: an 8x8 frame
+ * and a clamp on every coordinate.
+ *
+ ********************************************************/
+
+static inline int16_t at(const int16_t *frame, int x, int y)
+{
+  x = x < 0 ? 0 : (x > 7 ? 7 : x);
+  y = y < 0 ? 0 : (y > 7 ? 7 : y);
+  return frame[y * 8 + x];
+}
+
+static void referenceMedian(const int16_t *in, int16_t *out)
+{
+  for (int y = 0; y < 8; y++)
+  {
+    for (int x = 0; x < 8; x++)
+    {
+      int16_t window[9];
+      int n = 0;
+      for (int dy = -1; dy <= 1; dy++)
+        for (int dx = -1; dx <= 1; dx++)
+          window[n++] = at(in, x + dx, y + dy);
+      std::sort(window, window + 9);
+      out[y * 8 + x] = window[4];
+    }
+  }
+}
+
+static void referenceGaussian(const int16_t *in, int16_t *out)
+{
+  int16_t across[64];
+  for (int y = 0; y < 8; y++)
+    for (int x = 0; x < 8; x++)
+      across[y * 8 + x] = (at(in, x - 1, y) + 2 * at(in, x, y) + at(in, x + 1, y) + 2) >> 2;
+  for (int y = 0; y < 8; y++)
+    for (int x = 0; x < 8; x++)
+      out[y * 8 + x] = (at(across, x, y - 1) + 2 * at(across, x, y) + at(across, x, y + 1) + 2) >> 2;
+}
+
+static void referenceGradient(const int16_t *in, int x, int y, int *gx, int *gy)
+{
+  *gx = (at(in, x + 1, y - 1) + 2 * at(in, x + 1, y) + at(in, x + 1, y + 1)) -
+        (at(in, x - 1, y - 1) + 2 * at(in, x - 1, y) + at(in, x - 1, y + 1));
+  *gy = (at(in, x - 1, y + 1) + 2 * at(in, x, y + 1) + at(in, x + 1, y + 1)) -
+        (at(in, x - 1, y - 1) + 2 * at(in, x, y - 1) + at(in, x + 1, y - 1));
+}
+
+static void referenceSobel(const int16_t *in, int16_t *out)
+{
+  for (int y = 0; y < 8; y++)
+  {
+    for (int x = 0; x < 8; x++)
+    {
+      int gx, gy;
+      referenceGradient(in, x, y, &gx, &gy);
+      int large = std::max(abs(gx), abs(gy));
+      int small = std::min(abs(gx), abs(gy));
+      out[y * 8 + x] = (int16_t)(large + ((3 * small) >> 3));
+    }
+  }
+}
+
+/********************************************************
+ * Test frames
+ ********************************************************/
+
+static void readFrame(GridEYESimDevice &device, int16_t *frame)
+{
+  uint8_t raw[GRIDEYE_FRAME_BYTES];
+  device.stepScene();
+  device.read(TEMPERATURE_REGISTER_START, raw, sizeof(raw));
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    uint16_t val = (((uint16_t)raw[2 * i + 1]) << 8) | raw[2 * i];
+    frame[i] = (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800;
+  }
+}
+
+static void makeFrame(int kind, int16_t limit, GridEYESimDevice &device, int16_t *frame)
+{
+  std::uniform_int_distribution<int> value(-limit, limit - 1);
+  int edge = rng() % 8;
+  for (int y = 0; y < 8; y++)
+  {
+    for (int x = 0; x < 8; x++)
+    {
+      int16_t *pixel = &frame[y * 8 + x];
+      switch (kind)
+      {
+      case 0:
+        *pixel = value(rng);
+        break;
+      case 1: // Vertical step
+        *pixel = (x < edge) ? -limit : limit - 1;
+        break;
+      case 2: // Horizontal step
+        *pixel = (y < edge) ? limit - 1 : -limit;
+        break;
+      case 3: // Diagonal step
+        *pixel = (x + y < edge + 4) ? -limit : limit - 1;
+        break;
+      case 4:
+        *pixel = ((x + y) & 1) ? limit - 1 : -limit;
+        break;
+      default:
+        break;
+      }
+    }
+  }
+  if (kind == 5)
+    readFrame(device, frame);
+}
+
+static bool sameFrame(const int16_t *a, const int16_t *b)
+{
+  return memcmp(a, b, 64 * sizeof(int16_t)) == 0;
+}
+
+// The border must repeat the nearest edge pixel after every kernel
+static bool borderValid(const int16_t *padded)
+{
+  for (int y = -1; y <= 8; y++)
+  {
+    for (int x = -1; x <= 8; x++)
+    {
+      int cx = x < 0 ? 0 : (x > 7 ? 7 : x);
+      int cy = y < 0 ? 0 : (y > 7 ? 7 : y);
+      if (padded[GRIDEYE_PADDED_INDEX(x, y)] != padded[GRIDEYE_PADDED_INDEX(cx, cy)])
+        return false;
+    }
+  }
+  return true;
+}
+
+static void checkKernels()
+{
+  GridEYESimDevice device;
+  uint32_t medianErrors = 0, gaussianErrors = 0, wideErrors = 0, sobelErrors = 0, chainErrors = 0,
+           borderErrors = 0;
+  double worstMagnitude = 0;
+
+  for (int n = 0; n < CHECK_FRAMES; n++)
+  {
+    int16_t frame[64], expected[64], actual[64];
+    int16_t in[GRIDEYE_PADDED_SIZE], out[GRIDEYE_PADDED_SIZE];
+    makeFrame(n % 6, 2048, device, frame);
+    GridEYEFilter::pad(frame, in);
+    borderErrors += !borderValid(in);
+
+    referenceMedian(frame, expected);
+    GridEYEFilter::median3x3(in, out);
+    GridEYEFilter::unpad(out, actual);
+    medianErrors += !sameFrame(expected, actual);
+    borderErrors += !borderValid(out);
+
+    referenceSobel(frame, expected);
+    GridEYEFilter::sobel3x3(in, out);
+    GridEYEFilter::unpad(out, actual);
+    sobelErrors += !sameFrame(expected, actual);
+    borderErrors += !borderValid(out);
+    for (int y = 0; y < 8; y++)
+    {
+      for (int x = 0; x < 8; x++)
+      {
+        int gx, gy;
+        referenceGradient(frame, x, y, &gx, &gy);
+        double length = sqrt((double)gx * gx + (double)gy * gy);
+        if (length >= 16)
+          worstMagnitude = std::max(worstMagnitude, fabs(actual[y * 8 + x] - length) / length);
+      }
+    }
+
+    referenceGaussian(frame, expected);
+    GridEYEFilter::gaussian3x3(in);
+    GridEYEFilter::unpad(in, actual);
+    gaussianErrors += !sameFrame(expected, actual);
+    borderErrors += !borderValid(in);
+
+    // The blur's wider input range
+    makeFrame(n % 5, 8192, device, frame);
+    GridEYEFilter::pad(frame, in);
+    referenceGaussian(frame, expected);
+    GridEYEFilter::gaussian3x3(in);
+    GridEYEFilter::unpad(in, actual);
+    wideErrors += !sameFrame(expected, actual);
+
+    // A chain through the object's two buffers
+    int16_t a[64], b[64];
+    makeFrame(n % 6, 2048, device, frame);
+    referenceMedian(frame, a);
+    referenceGaussian(a, b);
+    referenceSobel(b, expected);
+    GridEYEFilter filter;
+    filter.load(frame);
+    filter.median();
+    filter.gaussian();
+    filter.sobel();
+    filter.store(actual);
+    chainErrors += !sameFrame(expected, actual) || (filter.get(3, 5) != expected[5 * 8 + 3]);
+    borderErrors += !borderValid(filter.getPadded());
+  }
+
+  report("median3x3 vs sorted window", CHECK_FRAMES, medianErrors);
+  report("gaussian3x3 vs clamped two pass blur", CHECK_FRAMES, gaussianErrors);
+  report("gaussian3x3 on +-8191", CHECK_FRAMES, wideErrors);
+  report("sobel3x3 vs clamped Sobel", CHECK_FRAMES, sobelErrors);
+  report("median, gaussian, sobel chain in GridEYEFilter", CHECK_FRAMES, chainErrors);
+  report("border repeats the edge after every kernel", CHECK_FRAMES * 5, borderErrors);
+  printf("  %-48s %5.1f%% worst\n", "sobel magnitude vs sqrt(gx^2 + gy^2)", worstMagnitude * 100);
+  if (worstMagnitude > 0.07)
+    failures++;
+}
+
+/********************************************************
+ * Timing
+ ********************************************************/
+
+struct Bench
+{
+  std::vector<int16_t> frames; // 64 frames
+  int16_t padded[GRIDEYE_PADDED_SIZE];
+  int16_t out[GRIDEYE_PADDED_SIZE];
+  int16_t frame[64];
+  int16_t result[64];
+  uint32_t step;
+};
+
+typedef void (*Kernel)(Bench *b);
+
+static const int16_t *nextFrame(Bench *b)
+{
+  return &b->frames[(b->step++ & 63) * 64];
+}
+
+static void runPad(Bench *b)
+{
+  GridEYEFilter::pad(nextFrame(b), b->padded);
+}
+
+static void runMedian(Bench *b)
+{
+  GridEYEFilter::median3x3(b->padded, b->out);
+}
+
+static void runGaussian(Bench *b)
+{
+  GridEYEFilter::gaussian3x3(b->padded);
+}
+
+static void runSobel(Bench *b)
+{
+  GridEYEFilter::sobel3x3(b->padded, b->out);
+}
+
+static void runChain(Bench *b)
+{
+  GridEYEFilter::pad(nextFrame(b), b->padded);
+  GridEYEFilter::median3x3(b->padded, b->out);
+  GridEYEFilter::gaussian3x3(b->out);
+  GridEYEFilter::sobel3x3(b->out, b->padded);
+}
+
+static void runReferenceMedian(Bench *b)
+{
+  referenceMedian(nextFrame(b), b->result);
+}
+
+static void runReferenceGaussian(Bench *b)
+{
+  referenceGaussian(nextFrame(b), b->result);
+}
+
+static void runReferenceSobel(Bench *b)
+{
+  referenceSobel(nextFrame(b), b->result);
+}
+
+static void runReferenceChain(Bench *b)
+{
+  referenceMedian(nextFrame(b), b->result);
+  referenceGaussian(b->result, b->frame);
+  referenceSobel(b->frame, b->result);
+}
+
+// Best ns and cycles per call over TIMING_RUNS runs
+static void timeKernel(Kernel kernel, Bench *b, double *ns, double *ticks)
+{
+  *ns = 1e30;
+  *ticks = 1e30;
+  for (int run = 0; run < TIMING_RUNS; run++)
+  {
+    uint64_t start = hostMicros64();
+    uint64_t startCycles = cycles();
+    for (int i = 0; i < TIMING_CALLS; i++)
+      kernel(b);
+    uint64_t endCycles = cycles();
+    uint64_t elapsed = hostMicros64() - start;
+    *ns = std::min(*ns, elapsed * 1000.0 / TIMING_CALLS);
+    *ticks = std::min(*ticks, (double)(endCycles - startCycles) / TIMING_CALLS);
+  }
+}
+
+static void runTiming()
+{
+  Bench b;
+  GridEYESimDevice device;
+  b.frames.resize(64 * 64);
+  for (int n = 0; n < 64; n++)
+    makeFrame((n & 1) ? 5 : 0, 2048, device, &b.frames[n * 64]);
+  b.step = 0;
+  GridEYEFilter::pad(&b.frames[0], b.padded);
+
+  struct
+  {
+    const char *name;
+    Kernel kernel;
+  } kernels[] = {
+      {"pad", runPad},
+      {"median3x3", runMedian},
+      {"gaussian3x3 (in place)", runGaussian},
+      {"sobel3x3", runSobel},
+      {"pad+median+gaussian+sobel", runChain},
+      {"clamped median (sort)", runReferenceMedian},
+      {"clamped gaussian", runReferenceGaussian},
+      {"clamped sobel", runReferenceSobel},
+      {"clamped median+gaussian+sobel", runReferenceChain},
+  };
+
+  for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+  {
+    double ns, ticks;
+    timeKernel(kernels[k].kernel, &b, &ns, &ticks);
+    printf("  %-32s %9.1f ns/frame", kernels[k].name, ns);
+    if (HAVE_CYCLES)
+      printf("  %9.0f cycles/frame  %6.1f cycles/pixel", ticks, ticks / 64);
+    printf("\n");
+  }
+}
+
+int main()
+{
+  printf("Properties\n");
+  checkKernels();
+
+  printf("\nTiming, best of %d\n", TIMING_RUNS);
+  runTiming();
+
+  if (failures != 0)
+    printf("\n%u checks failed\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Benchmark for the Linux i2c-dev backend.
+
+  Usage:
+    bench_i2cdev                    fake device, no hardware needed
+    bench_i2cdev /dev/i2c-1 [0x69]  real sensor
+
+  Reports syscalls per frame for a burst frame read (getFrameRaw)
+  and for the old pixel at a time pattern (64 x getPixelTemperature),
+  host CPU time per frame, and the frame rate the bus itself allows
+  at standard clock rates, which is what limits how many sensors
+  can share one bus.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYELinuxI2CBus.h"
+#include "GridEYESimDevice.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BURST_FRAMES 2000
+#define PIXEL_FRAMES 200
+
+// Bits on the wire for one register read of len bytes: start, address+W, register,
+// repeated start, address+R, data, stop. Every byte is 8 bits plus ACK.
+static uint32_t wireBits(uint32_t len)
+{
+  return 1 + 9 + 9 + 1 + 9 + 9 * len + 1;
+}
+
+int main(int argc, char **argv)
+{
+  GridEYESimDevice simulated(0x69);
+  GridEYEFakeI2CDev fake;
+  fake.attach(&simulated);
+
+  bool hardware = (argc > 1);
+  uint8_t address = (argc > 2) ? (uint8_t)strtol(argv[2], NULL, 0) : DEFAULT_ADDRESS;
+
+  GridEYELinuxI2CBus bus(hardware ? NULL : &fake);
+  if (!bus.begin(hardware ? argv[1] : "fake"))
+  {
+    perror("open");
+    return 1;
+  }
+
+  GridEYE grideye;
+  grideye.begin(address, bus);
+
+  int16_t frame[64];
+  if (!grideye.getFrameRaw(frame))
+  {
+    printf("no response from 0x%02X\n", address);
+    return 1;
+  }
+
+  // Burst reads
+  bus.ops()->resetSyscalls();
+  uint64_t start = hostMicros64();
+  for (int i = 0; i < BURST_FRAMES; i++)
+  {
+    if (!hardware)
+      simulated.stepScene();
+    grideye.getFrameRaw(frame);
+  }
+  uint64_t burstMicros = hostMicros64() - start;
+  double burstSyscalls = (double)bus.ops()->syscalls() / BURST_FRAMES;
+
+  // One pixel at a time, like the examples used to
+  bus.ops()->resetSyscalls();
+  start = hostMicros64();
+  for (int i = 0; i < PIXEL_FRAMES; i++)
+  {
+    for (uint8_t p = 0; p < 64; p++)
+      grideye.getPixelTemperature(p);
+  }
+  uint64_t pixelMicros = hostMicros64() - start;
+  double pixelSyscalls = (double)bus.ops()->syscalls() / PIXEL_FRAMES;
+
+  printf("%s\n\n", hardware ? argv[1] : "fake i2c-dev (no hardware)");
+  printf("                      syscalls/frame   us/frame   frames/s\n");
+  printf("getFrameRaw           %14.1f %10.1f %10.0f\n", burstSyscalls, (double)burstMicros / BURST_FRAMES,
+         BURST_FRAMES * 1e6 / burstMicros);
+  printf("64 x getPixel...      %14.1f %10.1f %10.0f\n", pixelSyscalls, (double)pixelMicros / PIXEL_FRAMES,
+         PIXEL_FRAMES * 1e6 / pixelMicros);
+
+  // What the wire allows, independent of host CPU
+  const uint32_t clocks[] = {100000, 400000, 1000000};
+  uint32_t burstBits = wireBits(GRIDEYE_FRAME_BYTES);
+  uint32_t pixelBits = 64 * wireBits(2);
+  printf("\nbus limited frame rate (sensors at 10FPS per bus)\n");
+  printf("  clock       getFrameRaw            64 x getPixel...\n");
+  for (int i = 0; i < 3; i++)
+  {
+    double burstFps = (double)clocks[i] / burstBits;
+    double pixelFps = (double)clocks[i] / pixelBits;
+    printf("  %4ukHz %8.1f FPS (%3d)    %8.1f FPS (%3d)\n", clocks[i] / 1000, burstFps, (int)(burstFps / 10),
+           pixelFps, (int)(pixelFps / 10));
+  }
+
+  return 0;
+}
@@ -0,0 +1,742 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Property checks and microbenchmarks for the conversion and frame
+  processing kernels.
+
+  Usage:
+    bench_kernels [--baseline file] [--record file] [--tolerance 0.5]
+
+  First every converter is checked exhaustively: all 65536 register
+  values for the 12 and 16-bit conversions, every 12-bit code through
+  the float round trip, rounding and saturation, and the interrupt
+  level setters read back through the device. Frame routines are
+  checked against a plain reference decode with all 4096 codes spread
+  over 64 frames, with and without calibration and with junk in the
+  unused upper bits.
+
+  Then each kernel is timed, best of several runs: converters in ns per
+  pixel, frame routines in frames per second. The sensor is an in-memory
+  device, so frame rates are CPU cost only.
+
+  Two plain loops that use nothing from the library are the references:
+  a 12-bit decode of the codes for the per pixel kernels, and a device
+  read plus that decode for the frame routines. The reference is timed
+  again right before each kernel and the kernel is compared as its
+  cost relative to it, so a faster, slower or busier machine moves both
+  alike. With --baseline those ratios are compared to a stored run and
+  any kernel whose ratio grew by more than the tolerance (default 50%)
+  fails the run. --record writes the current results as a new baseline.
+  Ratios still shift a little between processors and compilers;
+  bench_kernels.baseline in this folder was recorded at -O2 on the
+  machine named in its header.
+
+  Exits non-zero if a property check or the baseline comparison fails.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYESimDevice.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#define TIMING_RUNS 11
+#define TIMING_MICROSECONDS 50000 // Per run
+#define TIMING_BATCH 256          // Calls between clock reads
+#define TIMING_RETRIES 2          // Extra attempts for a kernel that looks like a regression
+
+// Completes inline from a simulated device. Optionally sets the unused upper
+// nibble of every pixel register on the way out, which decoders must ignore.
+class MemoryBus : public GridEYEBus
+{
+public:
+  MemoryBus(GridEYESimDevice *device)
+  {
+    _device = device;
+    junk = false;
+  }
+
+  bool submit(GridEYETransfer *transfer)
+  {
+    bool ok;
+    if (transfer->readLength == 0)
+    {
+      ok = _device->write(transfer->reg, transfer->writeData, transfer->writeLength);
+    }
+    else
+    {
+      ok = _device->read(transfer->reg, transfer->readData, transfer->readLength);
+      if (ok && junk)
+      {
+        for (uint8_t i = 0; i < transfer->readLength; i++)
+        {
+          uint8_t reg = transfer->reg + i;
+          if ((reg >= TEMPERATURE_REGISTER_START) && (reg & 1))
+            transfer->readData[i] |= 0xF0;
+        }
+      }
+    }
+
+    transfer->status = ok ? GRIDEYE_TRANSFER_DONE : GRIDEYE_TRANSFER_ERROR;
+    if (transfer->onComplete != NULL)
+      transfer->onComplete(transfer);
+    return true;
+  }
+
+  bool junk;
+
+private:
+  GridEYESimDevice *_device;
+};
+
+static int16_t signExtend12(uint16_t code)
+{
+  code &= 0x0FFF;
+  return (code & 0x0800) ? (int16_t)code - 4096 : (int16_t)code;
+}
+
+/********************************************************
+ * Property checks
+ ********************************************************/
+
+static uint32_t failures = 0;
+
+static void report(const char *name, uint32_t cases, uint32_t errors)
+{
+  printf("  %-52s %8u cases  %s\n", name, cases, (errors == 0) ? "ok" : "FAIL");
+  if (errors != 0)
+  {
+    printf("    %u mismatches\n", errors);
+    failures++;
+  }
+}
+
+static void checkConverters(GridEYE &grideye)
+{
+  uint32_t errors = 0;
+  for (uint32_t val = 0; val <= 0xFFFF; val++)
+  {
+    if (grideye.convertSigned12ToFloat((uint16_t)val) != (float)signExtend12((uint16_t)val))
+      errors++;
+  }
+  report("convertSigned12ToFloat, all 16-bit inputs", 65536, errors);
+
+  errors = 0;
+  for (uint16_t code = 0; code < 4096; code++)
+  {
+    if (grideye.convertFloatToSigned12(grideye.convertSigned12ToFloat(code)) != code)
+      errors++;
+  }
+  report("convertFloatToSigned12 round trip, all 12-bit codes", 4096, errors);
+
+  errors = 0;
+  for (int16_t value = -2048; value <= 2047; value++)
+  {
+    uint16_t code = (uint16_t)value & 0x0FFF;
+    if (grideye.convertFloatToSigned12(value - 0.49f) != code)
+      errors++;
+    if (grideye.convertFloatToSigned12(value + 0.49f) != code)
+      errors++;
+  }
+  report("convertFloatToSigned12 rounds to nearest", 8192, errors);
+
+  errors = 0;
+  const float high[] = {2047.4f, 2048.0f, 5000.0f, 1e9f};
+  const float low[] = {-2048.4f, -2049.0f, -5000.0f, -1e9f};
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    if (grideye.convertFloatToSigned12(high[i]) != 0x07FF)
+      errors++;
+    if (grideye.convertFloatToSigned12(low[i]) != 0x0800)
+      errors++;
+  }
+  report("convertFloatToSigned12 saturates", 8, errors);
+
+  errors = 0;
+  for (uint32_t val = 0; val <= 0xFFFF; val++)
+  {
+    int16_t s = grideye.convertUnsignedSigned16((uint16_t)val);
+    if ((uint16_t)s != val || grideye.convertSignedUnsigned16(s) != val)
+      errors++;
+  }
+  report("convertUnsignedSigned16/SignedUnsigned16, all inputs", 65536, errors);
+}
+
+static void checkInterruptLevels(GridEYE &grideye)
+{
+  uint32_t errors = 0;
+  uint32_t cases = 0;
+  for (int16_t quarter = -2048; quarter <= 2047; quarter += 7)
+  {
+    float degrees = quarter * 0.25f;
+    grideye.setUpperInterruptValue(degrees);
+    grideye.setLowerInterruptValue(degrees);
+    grideye.setInterruptHysteresis(degrees);
+    if (grideye.getUpperInterruptValueSigned() != quarter)
+      errors++;
+    if (grideye.getLowerInterruptValueSigned() != quarter)
+      errors++;
+    if (grideye.getInterruptHysteresisSigned() != quarter)
+      errors++;
+    cases += 3;
+  }
+  report("interrupt levels read back what was set", cases, errors);
+}
+
+// 64 frames holding every 12-bit code once, shuffled across pixels
+static void makeCodeFrames(std::vector<int16_t> *frames)
+{
+  frames->resize(4096);
+  for (uint32_t i = 0; i < 4096; i++)
+    (*frames)[i] = signExtend12((uint16_t)((i * 1597) & 0x0FFF)); // 1597 is odd, so this is a permutation
+}
+
+static void checkFrames(GridEYE &grideye, GridEYESimDevice &device, MemoryBus &bus)
+{
+  std::vector<int16_t> frames;
+  makeCodeFrames(&frames);
+
+  GridEYECalibration calibration;
+  uint32_t seed = 1;
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    calibration.setOffset(i, (int8_t)(seed >> 16));
+    calibration.setGainTrim(i, (int8_t)(seed >> 24));
+  }
+
+  const char *names[] = {"getFrameRaw/getFrame/per-pixel getters", "same, junk in the unused upper bits",
+                         "same, with calibration"};
+  for (int pass = 0; pass < 3; pass++)
+  {
+    bus.junk = (pass == 1);
+    grideye.setCalibration((pass == 2) ? &calibration : NULL);
+
+    uint32_t errors = 0;
+    for (int n = 0; n < 64; n++)
+    {
+      const int16_t *expected = &frames[n * 64];
+      device.setPixels(expected);
+
+      int16_t corrected[64];
+      for (uint8_t i = 0; i < 64; i++)
+        corrected[i] = (pass == 2) ? calibration.correct(i, expected[i]) : expected[i];
+
+      int16_t raw[64];
+      float celsius[64];
+      if (!grideye.getFrameRaw(raw) || !grideye.getFrame(celsius))
+        errors++;
+      for (uint8_t i = 0; i < 64; i++)
+      {
+        if (raw[i] != corrected[i])
+          errors++;
+        if (celsius[i] != corrected[i] * 0.25f)
+          errors++;
+        if (grideye.getPixelTemperatureSigned(i) != corrected[i])
+          errors++;
+        if (grideye.getPixelTemperature(i) != corrected[i] * 0.25f)
+          errors++;
+      }
+
+      // A few regions of every shape
+      GridEYERegion region;
+      region.x = n % 8;
+      region.y = (n / 8) % 8;
+      region.width = 8 - region.x;
+      region.height = 1 + (n * 5) % (8 - region.y);
+      int16_t values[64];
+      if (!grideye.getRegionRaw(region, values))
+        errors++;
+      for (uint8_t y = 0; y < region.height; y++)
+      {
+        for (uint8_t x = 0; x < region.width; x++)
+        {
+          if (values[y * region.width + x] != corrected[(region.y + y) * 8 + region.x + x])
+            errors++;
+        }
+      }
+    }
+    report(names[pass], 4096, errors);
+  }
+
+  bus.junk = false;
+  grideye.setCalibration(NULL);
+}
+
+/********************************************************
+ * Timing
+ ********************************************************
+ *
+ * Each kernel is a function run in batches until the run
+ * time is used up. The best of TIMING_RUNS runs is kept,
+ * since anything else running on the machine only ever
+ * makes a run slower.
+ *
+ ********************************************************/
+
+#define REFERENCE_PIXEL "reference decode"
+#define REFERENCE_FRAME "reference read+decode"
+
+struct Result
+{
+  std::string name;
+  std::string unit; // "ns/pixel" lower is better, "frames/s" higher is better
+  double value;
+  double relative; // Cost over the reference timed right before it, 0 if not timed that way
+};
+
+typedef void (*Kernel)(void *context);
+
+static const Result *findResult(const std::vector<Result> &results, const std::string &name, const std::string &unit)
+{
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    if (results[i].name == name && results[i].unit == unit)
+      return &results[i];
+  }
+  return NULL;
+}
+
+// Time per call relative to the reference kernel of the same unit: as measured
+// next to it, or else against the run's own reference result. 0 if neither.
+static double relativeCost(const Result &result, const std::vector<Result> &run)
+{
+  if (result.relative > 0)
+    return result.relative;
+  const Result *reference =
+      findResult(run, (result.unit == "ns/pixel") ? REFERENCE_PIXEL : REFERENCE_FRAME, result.unit);
+  if (reference == NULL || reference->value <= 0 || result.value <= 0)
+    return 0;
+  return (result.unit == "ns/pixel") ? result.value / reference->value : reference->value / result.value;
+}
+
+// How much the relative cost grew against the baseline, as a fraction (0.5 = 50%
+// slower), or 0 if the kernel or either reference is not in both runs
+static double slowdown(const Result &result, const std::vector<Result> &run, const std::vector<Result> &baseline)
+{
+  const Result *stored = findResult(baseline, result.name, result.unit);
+  if (stored == NULL)
+    return 0;
+  double now = relativeCost(result, run);
+  double then = relativeCost(*stored, baseline);
+  if (now == 0 || then == 0)
+    return 0;
+  return now / then - 1;
+}
+
+static double timeKernel(Kernel kernel, void *context)
+{
+  double best = 0;
+  for (int run = 0; run < TIMING_RUNS; run++)
+  {
+    uint64_t start = hostMicros64();
+    uint64_t calls = 0;
+    uint64_t elapsed = 0;
+    while (elapsed < TIMING_MICROSECONDS)
+    {
+      for (int i = 0; i < TIMING_BATCH; i++)
+        kernel(context);
+      calls += TIMING_BATCH;
+      elapsed = hostMicros64() - start;
+    }
+    double rate = calls * 1e6 / elapsed;
+    if (rate > best)
+      best = rate;
+  }
+  return best; // Calls per second
+}
+
+struct Bench
+{
+  GridEYE *grideye;
+  GridEYESimDevice *device;
+  GridEYECalibration *calibration;
+  std::vector<int16_t> codes;
+  int16_t frame[64];
+  float celsius[64];
+  volatile float floatSink;
+  volatile uint32_t sink;
+
+  GridEYETracker tracker;
+  GridEYEChangeDetector changes;
+  GridEYEHistogram histogram;
+  uint8_t history[8 * 64];
+  GridEYERenderer renderer;
+  uint16_t row[64];
+  uint32_t step;
+};
+
+// References, plain code the machine's speed is measured with. The per pixel
+// one is a call per code like the converters, so it isn't vectorized away.
+__attribute__((noinline)) static int16_t referenceDecode(uint16_t code)
+{
+  return signExtend12(code);
+}
+
+static void runReferenceDecode(void *context)
+{
+  Bench *b = (Bench *)context;
+  uint32_t total = 0;
+  for (uint16_t i = 0; i < 4096; i++)
+    total += referenceDecode((uint16_t)b->codes[i]);
+  b->sink = total;
+}
+
+static void runReferenceRead(void *context)
+{
+  Bench *b = (Bench *)context;
+  uint8_t raw[GRIDEYE_FRAME_BYTES];
+  b->device->read(TEMPERATURE_REGISTER_START, raw, sizeof(raw));
+  for (uint8_t i = 0; i < 64; i++)
+    b->frame[i] = signExtend12(((uint16_t)raw[2 * i + 1] << 8) | raw[2 * i]);
+}
+
+// Converters, all 4096 codes per call
+static void runSigned12ToFloat(void *context)
+{
+  Bench *b = (Bench *)context;
+  float total = 0;
+  for (uint16_t i = 0; i < 4096; i++)
+    total += b->grideye->convertSigned12ToFloat((uint16_t)b->codes[i]);
+  b->floatSink = total;
+}
+
+static void runFloatToSigned12(void *context)
+{
+  Bench *b = (Bench *)context;
+  uint32_t total = 0;
+  for (uint16_t i = 0; i < 4096; i++)
+    total += b->grideye->convertFloatToSigned12(b->codes[i] * 1.01f);
+  b->sink = total;
+}
+
+static void runUnsignedSigned16(void *context)
+{
+  Bench *b = (Bench *)context;
+  uint32_t total = 0;
+  for (uint16_t i = 0; i < 4096; i++)
+    total += b->grideye->convertUnsignedSigned16((uint16_t)b->codes[i]);
+  b->sink = total;
+}
+
+static void runSignedUnsigned16(void *context)
+{
+  Bench *b = (Bench *)context;
+  uint32_t total = 0;
+  for (uint16_t i = 0; i < 4096; i++)
+    total += b->grideye->convertSignedUnsigned16(b->codes[i]);
+  b->sink = total;
+}
+
+static void runCorrect(void *context)
+{
+  Bench *b = (Bench *)context;
+  uint32_t total = 0;
+  for (uint16_t i = 0; i < 4096; i++)
+    total += b->calibration->correct(i & 63, b->codes[i]);
+  b->sink = total;
+}
+
+static void runStretch(void *context)
+{
+  Bench *b = (Bench *)context;
+  GridEYEStretch stretch;
+  stretch.low = 80;
+  stretch.high = 160;
+  stretch.scale = (255 << 8) / 80;
+  uint32_t total = 0;
+  for (uint16_t i = 0; i < 4096; i++)
+    total += stretch.apply(b->codes[i]);
+  b->sink = total;
+}
+
+// Frame routines, one frame per call
+static void runGetFrameRaw(void *context)
+{
+  Bench *b = (Bench *)context;
+  b->grideye->getFrameRaw(b->frame);
+}
+
+static void runGetFrameRawCalibrated(void *context)
+{
+  Bench *b = (Bench *)context;
+  b->grideye->setCalibration(b->calibration);
+  b->grideye->getFrameRaw(b->frame);
+  b->grideye->setCalibration(NULL);
+}
+
+static void runGetFrame(void *context)
+{
+  Bench *b = (Bench *)context;
+  b->grideye->getFrame(b->celsius);
+}
+
+static void runPerPixel(void *context)
+{
+  Bench *b = (Bench *)context;
+  for (uint8_t i = 0; i < 64; i++)
+    b->celsius[i] = b->grideye->getPixelTemperature(i);
+}
+
+static void runRegion(void *context)
+{
+  Bench *b = (Bench *)context;
+  GridEYERegion region = {2, 2, 4, 4};
+  b->grideye->getRegionRaw(region, b->frame);
+}
+
+static void runTracker(void *context)
+{
+  Bench *b = (Bench *)context;
+  b->tracker.update(*b->grideye, b->frame);
+}
+
+static void runChanges(void *context)
+{
+  Bench *b = (Bench *)context;
+  b->sink = b->changes.update(&b->codes[(b->step++ & 63) * 64]);
+}
+
+static void runHistogramPush(void *context)
+{
+  Bench *b = (Bench *)context;
+  b->histogram.pushFrame(&b->codes[(b->step++ & 63) * 64]);
+}
+
+static void runHistogramQuery(void *context)
+{
+  Bench *b = (Bench *)context;
+  b->sink = b->histogram.getPercentile(1) + b->histogram.getPercentile(50) + b->histogram.getPercentile(99);
+}
+
+static void runRender(void *context)
+{
+  Bench *b = (Bench *)context;
+  b->renderer.setFrame(&b->codes[(b->step++ & 63) * 64]);
+  for (uint16_t y = 0; y < 64; y++)
+    b->renderer.renderRow(y, b->row);
+}
+
+static void runTiming(GridEYE &grideye, GridEYESimDevice &device, const std::vector<Result> &baseline, double tolerance,
+                      std::vector<Result> *results)
+{
+  Bench *b = new Bench();
+  b->grideye = &grideye;
+  b->device = &device;
+  makeCodeFrames(&b->codes);
+  b->step = 0;
+
+  GridEYECalibration calibration;
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    calibration.setOffset(i, (int8_t)(i * 3 - 96));
+    calibration.setGainTrim(i, (int8_t)(i - 32));
+  }
+  b->calibration = &calibration;
+
+  b->histogram.setRange(0, 0);
+  b->histogram.setWindow(b->history, 8);
+  for (int i = 0; i < 8; i++)
+    b->histogram.pushFrame(&b->codes[i * 64]);
+  b->renderer.setScale(8);
+
+  // A warm blob in the scene so the tracker has something to follow
+  device.stepScene();
+
+  struct
+  {
+    const char *name;
+    Kernel kernel;
+    bool perPixel;
+  } kernels[] = {
+      {REFERENCE_PIXEL, runReferenceDecode, true},
+      {REFERENCE_FRAME, runReferenceRead, false},
+      {"convertSigned12ToFloat", runSigned12ToFloat, true},
+      {"convertFloatToSigned12", runFloatToSigned12, true},
+      {"convertUnsignedSigned16", runUnsignedSigned16, true},
+      {"convertSignedUnsigned16", runSignedUnsigned16, true},
+      {"GridEYECalibration::correct", runCorrect, true},
+      {"GridEYEStretch::apply", runStretch, true},
+      {"getFrameRaw", runGetFrameRaw, false},
+      {"getFrameRaw+calibration", runGetFrameRawCalibrated, false},
+      {"getFrame", runGetFrame, false},
+      {"getPixelTemperature x64", runPerPixel, false},
+      {"getRegionRaw 4x4", runRegion, false},
+      {"GridEYETracker::update", runTracker, false},
+      {"GridEYEChangeDetector::update", runChanges, false},
+      {"GridEYEHistogram::pushFrame", runHistogramPush, false},
+      {"GridEYEHistogram p1+p50+p99", runHistogramQuery, false},
+      {"GridEYERenderer 64x64 RGB565", runRender, false},
+  };
+
+  for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+  {
+    Result result;
+    result.name = kernels[k].name;
+    result.unit = kernels[k].perPixel ? "ns/pixel" : "frames/s";
+    result.relative = 0;
+    Kernel reference = kernels[k].perPixel ? runReferenceDecode : runReferenceRead;
+    bool isReference = (kernels[k].kernel == reference);
+
+    // Each attempt times the reference right before the kernel, so the ratio
+    // holds while the machine's speed drifts. A kernel that looks slow gets
+    // timed again before it counts; the best ratio is kept.
+    for (int attempt = 0; attempt <= TIMING_RETRIES; attempt++)
+    {
+      double referenceRate = isReference ? 0 : timeKernel(reference, b);
+      double rate = timeKernel(kernels[k].kernel, b);
+      double relative = isReference ? 1 : referenceRate / rate;
+      if (attempt == 0 || relative < result.relative)
+      {
+        result.value = kernels[k].perPixel ? 1e9 / (rate * 4096) : rate;
+        result.relative = relative;
+      }
+      if (isReference || slowdown(result, *results, baseline) <= tolerance)
+        break;
+    }
+    results->push_back(result);
+  }
+
+  delete b;
+}
+
+/********************************************************
+ * Baselines
+ ********************************************************
+ *
+ * One result per line: value, unit, cost relative to
+ * the reference, then the kernel name to the end of the
+ * line. Only the relative cost is compared; the value is
+ * there to read. Lines starting with # are comments.
+ *
+ ********************************************************/
+
+static bool writeBaseline(const char *path, const std::vector<Result> &results)
+{
+  FILE *file = fopen(path, "w");
+  if (file == NULL)
+  {
+    perror(path);
+    return false;
+  }
+  fprintf(file, "# bench_kernels baseline: value unit relative kernel\n");
+  for (size_t i = 0; i < results.size(); i++)
+    fprintf(file, "%.3f %s %.4f %s\n", results[i].value, results[i].unit.c_str(), relativeCost(results[i], results),
+            results[i].name.c_str());
+  fclose(file);
+  return true;
+}
+
+static bool readBaseline(const char *path, std::vector<Result> *results)
+{
+  FILE *file = fopen(path, "r");
+  if (file == NULL)
+  {
+    perror(path);
+    return false;
+  }
+  char line[256];
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    if (line[0] == '#' || line[0] == '\n')
+      continue;
+    double value;
+    double relative;
+    char unit[32];
+    int used = 0;
+    if (sscanf(line, "%lf %31s %lf %n", &value, unit, &relative, &used) != 3)
+      continue;
+    Result result;
+    result.value = value;
+    result.relative = relative;
+    result.unit = unit;
+    result.name = line + used;
+    while (!result.name.empty() && (result.name.back() == '\n' || result.name.back() == '\r'))
+      result.name.pop_back();
+    results->push_back(result);
+  }
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  const char *baselinePath = NULL;
+  const char *recordPath = NULL;
+  double tolerance = 0.50;
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "--baseline") && i + 1 < argc)
+      baselinePath = argv[++i];
+    else if (!strcmp(argv[i], "--record") && i + 1 < argc)
+      recordPath = argv[++i];
+    else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc)
+      tolerance = atof(argv[++i]);
+    else
+    {
+      printf("usage: %s [--baseline file] [--record file] [--tolerance 0.5]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  GridEYESimDevice device;
+  MemoryBus bus(&device);
+  GridEYE grideye;
+  grideye.begin(device.address(), bus);
+
+  printf("Properties\n");
+  checkConverters(grideye);
+  checkInterruptLevels(grideye);
+  checkFrames(grideye, device, bus);
+
+  std::vector<Result> baseline;
+  if (baselinePath != NULL && !readBaseline(baselinePath, &baseline))
+    return 2;
+
+  printf("\nTiming, best of %d\n", TIMING_RUNS);
+  std::vector<Result> results;
+  runTiming(grideye, device, baseline, tolerance, &results);
+
+  uint32_t regressions = 0;
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    const Result &result = results[i];
+    printf("  %-34s %12.2f %s  %7.2fx ref", result.name.c_str(), result.value, result.unit.c_str(),
+           relativeCost(result, results));
+
+    double change = slowdown(result, results, baseline);
+    if (change != 0)
+      printf("   %+6.1f%% speed vs baseline", (1 / (1 + change) - 1) * 100);
+    if (change > tolerance)
+    {
+      printf("  REGRESSION");
+      regressions++;
+    }
+    printf("\n");
+  }
+
+  if (recordPath != NULL && !writeBaseline(recordPath, results))
+    return 2;
+
+  if (failures != 0)
+    printf("\n%u property checks failed\n", failures);
+  if (regressions != 0)
+    printf("\n%u kernels slower than baseline, relative to the references, by more than %.0f%%\n", regressions,
+           tolerance * 100);
+  return (failures == 0 && regressions == 0) ? 0 : 1;
+}
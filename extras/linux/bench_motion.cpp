@@ -0,0 +1,421 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Accuracy and cycle counts for GridEYEMotion.
+
+  Usage:
+    bench_motion
+
+  Frames are rendered on the host: warm Gaussian blobs on a 22C
+  background, each pixel averaged over 4x4 sub-samples, with sensor
+  noise and rounding to the 0.25C step. Pairs of frames move a blob by
+  a known sub-pixel amount in 16 directions at speeds from 0.15 to 3
+  pixels per frame:
+    - vector error: every valid vector whose window the blob covers,
+      against the true motion
+    - dominant flow error, angle error and whether getDirection() picks
+      the right sector
+    - two blobs walking apart: the dominant flow follows the larger one
+    - a still scene with noise: how often anything is reported moving
+  Each line fails past its limit.
+
+  Then update() is timed, best of several runs, in ns and time stamp
+  counter cycles per frame on the host, next to a rough Cortex-M4 and
+  AVR estimate from the worst case operation count. The estimates are
+  scaled by the measured host time against the one recorded with them,
+  and fail if the Cortex-M4 one passes a tenth of the frame budget.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_CYCLES 1
+static inline uint64_t cycles()
+{
+  return __rdtsc();
+}
+#else
+#define HAVE_CYCLES 0
+static inline uint64_t cycles()
+{
+  return 0;
+}
+#endif
+
+#define DIRECTIONS 16
+#define STARTS 8 // Sub-pixel start positions per speed and direction
+#define NOISE_LSB 0.6
+#define BACKGROUND_LSB 88 // 22C
+#define TIMING_RUNS 11
+#define TIMING_FRAMES 20000 // Per run
+
+// Worst case work per frame, from the window sizes 3, 4, 4, 3 each way
+#define WINDOW_PIXELS (14 * 14)
+#define SAD_PIXELS (25 * WINDOW_PIXELS)
+#define SOLVES GRIDEYE_MOTION_VECTORS
+// Rough per operation costs, not measured: clamped loads, 64-bit division in software
+#define M4_CYCLES_SAD 12
+#define M4_CYCLES_LK 60
+#define M4_CYCLES_SOLVE 600
+#define M4_CLOCK_MHZ 64
+#define AVR_CYCLES_SAD 40
+#define AVR_CYCLES_LK 300
+#define AVR_CYCLES_SOLVE 3000
+#define AVR_CLOCK_MHZ 16
+// update() on the host when the estimates above were made, x86-64 at -O2;
+// the estimates are scaled by how far the measured time has moved from it
+#define HOST_CYCLES_RECORDED 13500
+#define HOST_NS_RECORDED 6700
+
+static std::mt19937 rng(11);
+static std::normal_distribution<double> noise(0.0, NOISE_LSB);
+static uint32_t failures = 0;
+
+struct Blob
+{
+  double x, y;     // Center, pixels
+  double sigma;    // Pixels
+  double strength; // LSB above background
+};
+
+static void render(const Blob *blobs, int count, int16_t *frame)
+{
+  for (int py = 0; py < 8; py++)
+  {
+    for (int px = 0; px < 8; px++)
+    {
+      double sum = 0;
+      for (int sy = 0; sy < 4; sy++)
+      {
+        for (int sx = 0; sx < 4; sx++)
+        {
+          double x = px + (sx + 0.5) / 4 - 0.5;
+          double y = py + (sy + 0.5) / 4 - 0.5;
+          for (int b = 0; b < count; b++)
+          {
+            double dx = x - blobs[b].x;
+            double dy = y - blobs[b].y;
+            sum += blobs[b].strength * exp(-(dx * dx + dy * dy) / (2 * blobs[b].sigma * blobs[b].sigma));
+          }
+        }
+      }
+      frame[py * 8 + px] = (int16_t)lround(BACKGROUND_LSB + sum / 16 + noise(rng));
+    }
+  }
+}
+
+// Either neighbour is right for a motion exactly on a sector boundary
+static bool rightSector(uint8_t sector, double dx, double dy)
+{
+  if (sector == GRIDEYE_MOTION_NONE)
+    return false;
+  double angle = atan2(dy, dx) * 180 / M_PI - sector * 45;
+  angle = fmod(angle + 720 + 180, 360) - 180;
+  return fabs(angle) <= 22.5 + 1e-6;
+}
+
+static double angleBetween(double ax, double ay, double bx, double by)
+{
+  double difference = fabs(atan2(ay, ax) - atan2(by, bx)) * 180 / M_PI;
+  return (difference > 180) ? 360 - difference : difference;
+}
+
+static void check(const char *what, bool ok)
+{
+  printf("  %-60s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok)
+    failures++;
+}
+
+/********************************************************
+ * Single blob
+ ********************************************************
+ *
+ * The blob's path is centered in the frame, so it stays in
+ * view at every speed. A vector counts when its window
+ * center is within 1.5 sigma of the blob halfway along.
+ *
+ ********************************************************/
+
+struct Errors
+{
+  std::vector<double> vector;
+  std::vector<double> dominant;
+  std::vector<double> angle;
+  uint32_t pairs = 0;
+  uint32_t rightSector = 0;
+  uint32_t covered = 0; // Windows on the blob
+  uint32_t valid = 0;   // Of those, with a vector
+};
+
+static double percentile(std::vector<double> values, double p)
+{
+  if (values.empty())
+    return 0;
+  std::sort(values.begin(), values.end());
+  return values[(size_t)(p * (values.size() - 1))];
+}
+
+static double mean(const std::vector<double> &values)
+{
+  double sum = 0;
+  for (double v : values)
+    sum += v;
+  return values.empty() ? 0 : sum / values.size();
+}
+
+static void singleBlob(double speed, double sigma, double strength, Errors *errors)
+{
+  std::uniform_real_distribution<double> jitter(-0.5, 0.5);
+  for (int d = 0; d < DIRECTIONS; d++)
+  {
+    double angle = 2 * M_PI * d / DIRECTIONS;
+    double vx = speed * cos(angle);
+    double vy = speed * sin(angle);
+    for (int s = 0; s < STARTS; s++)
+    {
+      double cx = 3.5 + jitter(rng);
+      double cy = 3.5 + jitter(rng);
+      Blob before = {cx - vx / 2, cy - vy / 2, sigma, strength};
+      Blob after = {cx + vx / 2, cy + vy / 2, sigma, strength};
+      int16_t previous[64], current[64];
+      render(&before, 1, previous);
+      render(&after, 1, current);
+
+      GridEYEMotion motion;
+      motion.update(previous);
+      motion.update(current);
+
+      for (uint8_t gy = 0; gy < GRIDEYE_MOTION_GRID; gy++)
+      {
+        for (uint8_t gx = 0; gx < GRIDEYE_MOTION_GRID; gx++)
+        {
+          double wx = gx * 2 + 0.5;
+          double wy = gy * 2 + 0.5;
+          if (hypot(wx - cx, wy - cy) > 1.5 * sigma)
+            continue;
+          errors->covered++;
+          GridEYEMotionVector vector = motion.getVector(gx, gy);
+          if (!vector.valid)
+            continue;
+          errors->valid++;
+          errors->vector.push_back(
+              hypot(vector.dx / (double)GRIDEYE_MOTION_ONE - vx, vector.dy / (double)GRIDEYE_MOTION_ONE - vy));
+        }
+      }
+
+      int16_t dx, dy;
+      motion.getDominant(&dx, &dy);
+      errors->pairs++;
+      errors->dominant.push_back(hypot(dx / (double)GRIDEYE_MOTION_ONE - vx, dy / (double)GRIDEYE_MOTION_ONE - vy));
+      if ((dx != 0) || (dy != 0))
+        errors->angle.push_back(angleBetween(dx, dy, vx, vy));
+      else
+        errors->angle.push_back(180);
+      if (rightSector(motion.getDirection(), vx, vy))
+        errors->rightSector++;
+    }
+  }
+}
+
+static void runSingleBlob()
+{
+  static const double speeds[] = {0.15, 0.25, 0.5, 0.75, 1.0, 1.5, 2.0, 3.0};
+  // Limits on the mean dominant error, pixels per frame
+  static const double limits[] = {0.08, 0.08, 0.1, 0.12, 0.15, 0.2, 0.25, 0.35};
+
+  printf("  %5s  %8s %8s %7s  %8s %8s %7s %7s\n", "speed", "vec mean", "vec p90", "valid", "dom mean", "dom p90",
+         "angle", "sector");
+  for (size_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++)
+  {
+    Errors errors;
+    singleBlob(speeds[i], 1.2, 40, &errors);
+    double dominantMean = mean(errors.dominant);
+    double sectorRate = (double)errors.rightSector / errors.pairs;
+    bool ok = (dominantMean <= limits[i]) && (sectorRate >= 0.9);
+    printf("  %5.2f  %8.3f %8.3f %6.0f%%  %8.3f %8.3f %6.1fd %6.0f%%  %s\n", speeds[i], mean(errors.vector),
+           percentile(errors.vector, 0.9), 100.0 * errors.valid / errors.covered, dominantMean,
+           percentile(errors.dominant, 0.9), mean(errors.angle), 100 * sectorRate, ok ? "ok" : "FAILED");
+    if (!ok)
+      failures++;
+  }
+
+  // A fainter, smaller blob: a person further away
+  Errors faint;
+  singleBlob(0.5, 0.8, 12, &faint);
+  char line[96];
+  snprintf(line, sizeof(line), "faint blob (3C, sigma 0.8) at 0.5 px: dominant error %.3f px",
+           mean(faint.dominant));
+  check(line, mean(faint.dominant) <= 0.2);
+}
+
+/********************************************************
+ * Scenes
+ ********************************************************/
+
+static void runTwoBlobs()
+{
+  std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+  uint32_t right = 0;
+  uint32_t pairs = 0;
+  for (int d = 0; d < DIRECTIONS; d++)
+  {
+    double angle = 2 * M_PI * d / DIRECTIONS;
+    double vx = 0.6 * cos(angle);
+    double vy = 0.6 * sin(angle);
+    for (int s = 0; s < STARTS; s++)
+    {
+      // The large blob on one side moving one way, the small one opposite
+      double ox = 1.6 * cos(angle + M_PI / 2);
+      double oy = 1.6 * sin(angle + M_PI / 2);
+      double cx = 3.5 + jitter(rng);
+      double cy = 3.5 + jitter(rng);
+      Blob before[2] = {{cx + ox - vx / 2, cy + oy - vy / 2, 1.4, 48}, {cx - ox + vx / 2, cy - oy + vy / 2, 0.7, 24}};
+      Blob after[2] = {{cx + ox + vx / 2, cy + oy + vy / 2, 1.4, 48}, {cx - ox - vx / 2, cy - oy - vy / 2, 0.7, 24}};
+      int16_t previous[64], current[64];
+      render(before, 2, previous);
+      render(after, 2, current);
+
+      GridEYEMotion motion;
+      motion.update(previous);
+      motion.update(current);
+      int16_t dx, dy;
+      motion.getDominant(&dx, &dy);
+      pairs++;
+      if (((dx != 0) || (dy != 0)) && (angleBetween(dx, dy, vx, vy) < 45))
+        right++;
+    }
+  }
+  char line[96];
+  snprintf(line, sizeof(line), "two blobs walking apart: dominant follows the larger %.0f%%", 100.0 * right / pairs);
+  check(line, right >= pairs * 0.9);
+}
+
+static void runStill()
+{
+  uint32_t moving = 0;
+  uint32_t pairs = 0;
+  for (int i = 0; i < 500; i++)
+  {
+    Blob blob = {2 + (i % 5) * 0.7, 2 + (i % 7) * 0.5, 1.2, 40};
+    int16_t previous[64], current[64];
+    render(&blob, 1, previous);
+    render(&blob, 1, current);
+
+    GridEYEMotion motion;
+    motion.update(previous);
+    motion.update(current);
+    pairs++;
+    if (motion.getDirection() != GRIDEYE_MOTION_NONE)
+      moving++;
+  }
+
+  uint32_t emptyMoving = 0;
+  for (int i = 0; i < 500; i++)
+  {
+    int16_t previous[64], current[64];
+    render(NULL, 0, previous);
+    render(NULL, 0, current);
+    GridEYEMotion motion;
+    motion.update(previous);
+    motion.update(current);
+    if (motion.getMovingCount() != 0)
+      emptyMoving++;
+  }
+
+  char line[96];
+  snprintf(line, sizeof(line), "still blob with noise: reported moving %.1f%%", 100.0 * moving / pairs);
+  check(line, moving <= pairs / 20);
+  snprintf(line, sizeof(line), "empty scene with noise: any cell moving %.1f%%", 100.0 * emptyMoving / 500);
+  check(line, emptyMoving <= 500 / 20);
+}
+
+/********************************************************
+ * Timing
+ ********************************************************/
+
+static void runTiming()
+{
+  // A blob circling the frame, so the search runs its full length
+  std::vector<int16_t> frames(64 * 64);
+  for (int n = 0; n < 64; n++)
+  {
+    double angle = 2 * M_PI * n / 64;
+    Blob blob = {3.5 + 2 * cos(angle), 3.5 + 2 * sin(angle), 1.2, 40};
+    render(&blob, 1, &frames[n * 64]);
+  }
+
+  GridEYEMotion motion;
+  double ns = 1e30;
+  double ticks = 1e30;
+  uint32_t sink = 0;
+  for (int run = 0; run < TIMING_RUNS; run++)
+  {
+    uint64_t start = hostMicros64();
+    uint64_t startCycles = cycles();
+    for (int i = 0; i < TIMING_FRAMES; i++)
+    {
+      motion.update(&frames[(i & 63) * 64]);
+      sink += motion.getMovingCount();
+    }
+    uint64_t endCycles = cycles();
+    uint64_t elapsed = hostMicros64() - start;
+    ns = std::min(ns, elapsed * 1000.0 / TIMING_FRAMES);
+    ticks = std::min(ticks, (double)(endCycles - startCycles) / TIMING_FRAMES);
+  }
+
+  printf("  %-32s %9.1f ns/frame", "update()", ns);
+  if (HAVE_CYCLES)
+    printf("  %9.0f cycles/frame", ticks);
+  printf("  (%u)\n", sink & 1);
+
+  // A slower update() on the host is taken to be as much slower on the target
+  double scale = HAVE_CYCLES ? ticks / HOST_CYCLES_RECORDED : ns / HOST_NS_RECORDED;
+  double m4 = scale * (SAD_PIXELS * (double)M4_CYCLES_SAD + WINDOW_PIXELS * M4_CYCLES_LK + SOLVES * M4_CYCLES_SOLVE);
+  double avr =
+      scale * (SAD_PIXELS * (double)AVR_CYCLES_SAD + WINDOW_PIXELS * AVR_CYCLES_LK + SOLVES * AVR_CYCLES_SOLVE);
+  printf("  worst case %d SAD pixels, %d gradient pixels, %d solves per frame\n", SAD_PIXELS, WINDOW_PIXELS, SOLVES);
+  printf("  host time %.2fx the recorded %d %s\n", scale, HAVE_CYCLES ? HOST_CYCLES_RECORDED : HOST_NS_RECORDED,
+         HAVE_CYCLES ? "cycles" : "ns");
+  printf("  Cortex-M4 estimate (scaled)       %7.0f cycles, %5.2f ms at %d MHz of the 100 ms frame\n", m4,
+         m4 / (M4_CLOCK_MHZ * 1000.0), M4_CLOCK_MHZ);
+  printf("  AVR estimate (scaled)             %7.0f cycles, %5.2f ms at %d MHz\n", avr, avr / (AVR_CLOCK_MHZ * 1000.0),
+         AVR_CLOCK_MHZ);
+  check("scaled Cortex-M4 estimate within a tenth of the frame budget", m4 / (M4_CLOCK_MHZ * 1000.0) < 10);
+}
+
+int main()
+{
+  printf("Single blob, 10C, sigma 1.2 px, %d directions x %d starts per speed\n", DIRECTIONS, STARTS);
+  runSingleBlob();
+
+  printf("\nScenes\n");
+  runTwoBlobs();
+  runStill();
+
+  printf("\nTiming, best of %d\n", TIMING_RUNS);
+  runTiming();
+
+  printf("\n%s\n", failures ? "FAILED" : "all checks passed");
+  return failures ? 1 : 0;
+}
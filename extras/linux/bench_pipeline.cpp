@@ -0,0 +1,162 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Throughput benchmark for GridEYEPipeline.
+
+  Usage:
+    bench_pipeline [sensors] [buses] [max workers] [recording]
+
+  Drives the pipeline with simulated sensors (a warm blob moving
+  across the array) or, if a recording is given, replays it. A
+  recording is a file of raw 128-byte frames in register order.
+  Runs the same load with 1..max workers and reports frames per
+  second and speedup over one worker. Every run also checks that
+  each sensor's results arrive in order with no gaps.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYEPipeline.h"
+#include "GridEYESimDevice.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define RUN_MILLISECONDS 1000
+
+// Cycles through frames held in memory
+class ReplaySource : public GridEYEFrameSource
+{
+public:
+  ReplaySource(const std::vector<uint8_t> *frames, size_t start)
+  {
+    _frames = frames;
+    _count = frames->size() / GRIDEYE_FRAME_BYTES;
+    _next = start % _count;
+  }
+
+  bool read(uint8_t *raw)
+  {
+    memcpy(raw, &(*_frames)[_next * GRIDEYE_FRAME_BYTES], GRIDEYE_FRAME_BYTES);
+    _next = (_next + 1) % _count;
+    return true;
+  }
+
+private:
+  const std::vector<uint8_t> *_frames;
+  size_t _count;
+  size_t _next;
+};
+
+struct OrderCheck
+{
+  std::vector<uint32_t> expected;
+  std::atomic<uint32_t> errors;
+};
+
+static void onResult(const GridEYEPipelineResult &result, void *context)
+{
+  OrderCheck *check = (OrderCheck *)context;
+  // Callbacks for one sensor never overlap, so the plain vector entry is safe
+  if (result.sequence != check->expected[result.sensor])
+    check->errors++;
+  check->expected[result.sensor] = result.sequence + 1;
+}
+
+int main(int argc, char **argv)
+{
+  int sensors = (argc > 1) ? atoi(argv[1]) : 32;
+  int buses = (argc > 2) ? atoi(argv[2]) : 4;
+  int maxWorkers = (argc > 3) ? atoi(argv[3]) : (int)std::max(4u, std::thread::hardware_concurrency());
+
+  std::vector<uint8_t> frames;
+  if (argc > 4)
+  {
+    FILE *file = fopen(argv[4], "rb");
+    if (file == NULL)
+    {
+      perror(argv[4]);
+      return 1;
+    }
+    uint8_t raw[GRIDEYE_FRAME_BYTES];
+    while (fread(raw, 1, sizeof(raw), file) == sizeof(raw))
+      frames.insert(frames.end(), raw, raw + sizeof(raw));
+    fclose(file);
+    if (frames.empty())
+    {
+      printf("%s holds no complete frames\n", argv[4]);
+      return 1;
+    }
+  }
+  else
+  {
+    // One blob sweep, 512 frames
+    GridEYESimDevice device;
+    uint8_t raw[GRIDEYE_FRAME_BYTES];
+    for (int i = 0; i < 512; i++)
+    {
+      device.stepScene();
+      device.read(TEMPERATURE_REGISTER_START, raw, sizeof(raw));
+      frames.insert(frames.end(), raw, raw + sizeof(raw));
+    }
+  }
+
+  std::vector<ReplaySource *> sources;
+  for (int i = 0; i < sensors; i++)
+    sources.push_back(new ReplaySource(&frames, i * 37));
+
+  printf("%d sensors on %d buses, %s, %u cores\n\n", sensors, buses, (argc > 4) ? argv[4] : "simulated",
+         std::thread::hardware_concurrency());
+  printf("workers   frames/s   speedup   stolen/s   order errors\n");
+
+  double baseline = 0;
+  bool ok = true;
+  for (int workers = 1; workers <= maxWorkers; workers++)
+  {
+    OrderCheck check;
+    check.expected.assign(sensors, 0);
+    check.errors = 0;
+
+    GridEYEPipeline pipeline;
+    for (int i = 0; i < sensors; i++)
+      pipeline.addSensor((uint16_t)(i % buses), sources[i]);
+    pipeline.setWorkers((uint16_t)workers);
+    pipeline.setCallback(onResult, &check);
+
+    uint64_t start = hostMicros64();
+    pipeline.start();
+    delay(RUN_MILLISECONDS);
+    pipeline.stop();
+    double seconds = (hostMicros64() - start) / 1e6;
+
+    double rate = pipeline.published() / seconds;
+    if (workers == 1)
+      baseline = rate;
+    printf("%7d %10.0f %9.2f %10.0f %14u\n", workers, rate, rate / baseline, pipeline.stolen() / seconds,
+           check.errors.load());
+
+    if ((check.errors != 0) || (pipeline.published() != pipeline.acquired()))
+      ok = false;
+  }
+
+  for (size_t i = 0; i < sources.size(); i++)
+    delete sources[i];
+
+  if (!ok)
+  {
+    printf("results were lost or published out of order\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,357 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Check and benchmark for GridEYEZones.
+
+  Usage:
+    bench_zones [zones]
+
+  Sets up random zones (rectangles and scattered pixels, shared and
+  unique levels, hysteresis, dwell, minimum pixel counts, one sided
+  zones) and plays a moving warm blob and a cold spot with sensor noise
+  through them, checking every frame that:
+    - every zone's state matches a plain per-pixel implementation
+    - the band programInterrupt() writes to the sensor registers trips
+      on every frame where any zone's alarm condition holds
+
+  Then times update() for 1, 8, 64 and N zones (default 512) with 8
+  distinct levels and with every level distinct, against the per-pixel
+  version.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYEMockBus.h"
+#include "GridEYESimDevice.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+#include <vector>
+
+#define CHECK_ZONES 300
+#define CHECK_FRAMES 3000
+#define TIMING_MICROSECONDS 200000
+
+static std::mt19937 rng(3);
+
+static int randomInt(int low, int high)
+{
+  return std::uniform_int_distribution<int>(low, high)(rng);
+}
+
+/********************************************************
+ * Reference
+ ********************************************************
+ *
+ * One zone at a time, counting its pixels out of band
+ * directly from the frame.
+ *
+ ********************************************************/
+
+struct ReferenceZone
+{
+  GridEYEZone config;
+  bool high;
+  bool low;
+  int highCount;
+  int lowCount;
+};
+
+static int countOutside(const GridEYEZone &zone, const int16_t *frame, bool upperSide, int level)
+{
+  int count = 0;
+  for (int i = 0; i < 64; i++)
+  {
+    if (!((zone.mask >> i) & 1))
+      continue;
+    if (upperSide ? (frame[i] > level) : (frame[i] < level))
+      count++;
+  }
+  return count;
+}
+
+// Returns true if the zone's alarm changed
+static bool referenceSide(ReferenceZone &zone, const int16_t *frame, bool upperSide)
+{
+  const GridEYEZone &c = zone.config;
+  bool &active = upperSide ? zone.high : zone.low;
+  int &count = upperSide ? zone.highCount : zone.lowCount;
+  int level = upperSide ? c.upper : c.lower;
+  if (active)
+    level += upperSide ? -c.hysteresis : c.hysteresis;
+
+  int needed = c.minPixels ? c.minPixels : 1;
+  bool out = countOutside(c, frame, upperSide, level) >= needed;
+  if (active && !out)
+  {
+    active = false;
+    return true;
+  }
+  if (!active && out)
+  {
+    if (++count >= c.dwell)
+    {
+      active = true;
+      count = 0;
+      return true;
+    }
+    return false;
+  }
+  count = 0;
+  return false;
+}
+
+static bool referenceUpdate(ReferenceZone &zone, const int16_t *frame)
+{
+  bool changed = false;
+  if (zone.config.upper != GRIDEYE_ZONE_NO_UPPER)
+    changed |= referenceSide(zone, frame, true);
+  if (zone.config.lower != GRIDEYE_ZONE_NO_LOWER)
+    changed |= referenceSide(zone, frame, false);
+  return changed;
+}
+
+// Whether the zone would start an alarm on this frame, ignoring dwell
+static bool couldFire(const GridEYEZone &zone, const int16_t *frame)
+{
+  int needed = zone.minPixels ? zone.minPixels : 1;
+  if ((zone.upper != GRIDEYE_ZONE_NO_UPPER) && countOutside(zone, frame, true, zone.upper) >= needed)
+    return true;
+  if ((zone.lower != GRIDEYE_ZONE_NO_LOWER) && countOutside(zone, frame, false, zone.lower) >= needed)
+    return true;
+  return false;
+}
+
+/********************************************************
+ * Scene and zones
+ ********************************************************/
+
+// 22C room, a warm blob wandering around and a cold spot that comes and goes
+static void sceneFrame(uint32_t step, int16_t *frame)
+{
+  double bx = 3.5 + 3.5 * sin(step * 0.031);
+  double by = 3.5 + 3.5 * sin(step * 0.017 + 1);
+  double heat = 6 + 6 * sin(step * 0.011);
+  bool cold = (step / 200) % 3 == 1;
+  for (int y = 0; y < 8; y++)
+  {
+    for (int x = 0; x < 8; x++)
+    {
+      double t = 22 + heat * exp(-((x - bx) * (x - bx) + (y - by) * (y - by)) / 2.0);
+      if (cold && x >= 5 && y >= 5)
+        t -= 8;
+      frame[y * 8 + x] = (int16_t)lround(t * 4) + randomInt(-2, 2);
+    }
+  }
+}
+
+static uint64_t randomMask()
+{
+  if (randomInt(0, 2))
+  {
+    GridEYERegion region;
+    region.x = randomInt(0, 7);
+    region.y = randomInt(0, 7);
+    region.width = randomInt(1, 8);
+    region.height = randomInt(1, 8);
+    return GridEYEZones::regionMask(region);
+  }
+  uint64_t mask = 0;
+  for (int i = 0; i < 64; i++)
+    mask |= (uint64_t)(randomInt(0, 4) == 0) << i;
+  return mask;
+}
+
+static void randomZones(GridEYEZones &zones, std::vector<GridEYEZone> &storage, uint16_t count, bool shared)
+{
+  storage.assign(count, GridEYEZone());
+  zones.begin(storage.data(), count);
+  for (uint16_t i = 0; i < count; i++)
+  {
+    int16_t upper = shared ? 22 * 4 + 8 * randomInt(1, 4) : randomInt(23 * 4, 40 * 4);
+    int16_t lower = shared ? 22 * 4 - 8 * randomInt(1, 4) : randomInt(10 * 4, 21 * 4);
+    int side = randomInt(0, 3);
+    if (side == 1)
+      upper = GRIDEYE_ZONE_NO_UPPER;
+    if (side == 2)
+      lower = GRIDEYE_ZONE_NO_LOWER;
+    zones.setZone(i, randomMask(), lower, upper, randomInt(0, 8), randomInt(0, 5), randomInt(0, 4));
+  }
+}
+
+/********************************************************
+ * Checks
+ ********************************************************/
+
+static int16_t registerLevel(GridEYESimDevice &device, uint8_t reg)
+{
+  uint16_t val = device.peek(reg) | (device.peek(reg + 1) << 8);
+  return (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800;
+}
+
+static int checkZones(uint16_t count)
+{
+  GridEYESimDevice device;
+  GridEYEMockBus bus(0, 0, 0);
+  bus.attach(&device);
+  GridEYE grideye;
+  grideye.begin(device.address(), bus);
+
+  GridEYEZones zones;
+  std::vector<GridEYEZone> storage;
+  randomZones(zones, storage, count, true);
+
+  // A few unique levels on top of the shared ones, more than the cache holds
+  for (uint16_t i = 0; i < count; i += 7)
+    storage[i].upper = (storage[i].upper == GRIDEYE_ZONE_NO_UPPER) ? storage[i].upper : randomInt(23 * 4, 40 * 4);
+
+  std::vector<ReferenceZone> reference(count);
+  for (uint16_t i = 0; i < count; i++)
+  {
+    reference[i].config = storage[i];
+    reference[i].high = reference[i].low = false;
+    reference[i].highCount = reference[i].lowCount = 0;
+  }
+
+  int errors = 0;
+  if (!zones.programInterrupt(grideye) || ((device.peek(INT_CONTROL_REGISTER) & 0x03) != 0x03))
+  {
+    printf("programInterrupt() did not enable the pin in absolute mode\n");
+    errors++;
+  }
+  int16_t upper = registerLevel(device, INT_LEVEL_REGISTER_UPPER_LSB);
+  int16_t lower = registerLevel(device, INT_LEVEL_REGISTER_LOWER_LSB);
+  int16_t bandLower, bandUpper, bandHysteresis;
+  zones.getBand(&bandLower, &bandUpper, &bandHysteresis);
+  if ((upper != bandUpper) || (lower != bandLower) ||
+      (registerLevel(device, INT_LEVEL_REGISTER_HYST_LSB) != bandHysteresis))
+  {
+    printf("interrupt registers %d..%d do not hold the band %d..%d\n", lower, upper, bandLower, bandUpper);
+    errors++;
+  }
+
+  uint32_t stateErrors = 0, missedWakes = 0, wakes = 0, firing = 0, transitions = 0;
+  for (uint32_t step = 0; step < CHECK_FRAMES; step++)
+  {
+    int16_t frame[64];
+    sceneFrame(step, frame);
+
+    uint16_t changed = zones.update(frame);
+    uint16_t expectedChanged = 0;
+    bool anyCouldFire = false;
+    for (uint16_t i = 0; i < count; i++)
+    {
+      bool refChanged = referenceUpdate(reference[i], frame);
+      expectedChanged += refChanged;
+      uint8_t expected = (reference[i].high ? GRIDEYE_ZONE_HIGH : 0) | (reference[i].low ? GRIDEYE_ZONE_LOW : 0) |
+                         (refChanged ? GRIDEYE_ZONE_CHANGED : 0);
+      if (zones.getState(i) != expected)
+        stateErrors++;
+      anyCouldFire |= couldFire(storage[i], frame);
+    }
+    if (changed != expectedChanged)
+      stateErrors++;
+    transitions += changed;
+
+    bool wake = false;
+    for (int i = 0; i < 64; i++)
+      wake |= (frame[i] > upper) || (frame[i] < lower);
+    wakes += wake;
+    firing += anyCouldFire;
+    if (anyCouldFire && !wake)
+      missedWakes++;
+  }
+
+  printf("  %u zones, %u frames: %u alarm changes, band %d..%d\n", count, CHECK_FRAMES, transitions, lower, upper);
+  printf("  %-46s %s\n", "zone states match the per-pixel reference", stateErrors ? "FAILED" : "ok");
+  printf("  %-46s %s (%u frames could fire, sensor tripped on %u)\n", "interrupt trips whenever a zone could fire",
+         missedWakes ? "FAILED" : "ok", firing, wakes);
+  return errors + (stateErrors != 0) + (missedWakes != 0);
+}
+
+/********************************************************
+ * Timing
+ ********************************************************/
+
+static double timeUpdates(GridEYEZones &zones, std::vector<ReferenceZone> *reference)
+{
+  int16_t frames[64][64];
+  for (int i = 0; i < 64; i++)
+    sceneFrame(i * 37, frames[i]);
+
+  uint64_t start = hostMicros64();
+  uint64_t calls = 0;
+  volatile uint32_t sink = 0;
+  while (hostMicros64() - start < TIMING_MICROSECONDS)
+  {
+    for (int i = 0; i < 64; i++)
+    {
+      if (reference)
+      {
+        for (size_t z = 0; z < reference->size(); z++)
+          sink += referenceUpdate((*reference)[z], frames[i]);
+      }
+      else
+      {
+        sink += zones.update(frames[i]);
+      }
+    }
+    calls += 64;
+  }
+  return (double)(hostMicros64() - start) * 1000.0 / calls; // ns per update
+}
+
+static void runTiming(uint16_t maxZones)
+{
+  printf("\nTiming, ns per frame\n");
+  printf("  %6s %14s %14s %14s\n", "zones", "8 levels", "all distinct", "per-pixel");
+  const uint16_t counts[] = {1, 8, 64, maxZones};
+  for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+  {
+    uint16_t count = counts[c];
+    GridEYEZones zones;
+    std::vector<GridEYEZone> storage;
+    randomZones(zones, storage, count, true);
+    double shared = timeUpdates(zones, NULL);
+
+    randomZones(zones, storage, count, false);
+    double distinct = timeUpdates(zones, NULL);
+
+    std::vector<ReferenceZone> reference(count);
+    for (uint16_t i = 0; i < count; i++)
+    {
+      reference[i].config = storage[i];
+      reference[i].high = reference[i].low = false;
+      reference[i].highCount = reference[i].lowCount = 0;
+    }
+    double plain = timeUpdates(zones, &reference);
+
+    printf("  %6u %14.0f %14.0f %14.0f\n", count, shared, distinct, plain);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  uint16_t maxZones = (argc > 1) ? atoi(argv[1]) : 512;
+
+  printf("Properties\n");
+  int errors = checkZones(CHECK_ZONES);
+  runTiming(maxZones);
+
+  printf("\n%s\n", errors ? "FAILED" : "all checks passed");
+  return errors ? 1 : 0;
+}
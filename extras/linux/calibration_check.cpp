@@ -0,0 +1,315 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Round trip checks for GridEYECalibration.
+
+  Usage:
+    calibration_check
+
+  The simulated sensor is given a known fixed pattern: a per-pixel
+  offset, and for the gain checks a per-pixel gain around 22C, on top
+  of uniform scenes with sensor noise. Frames go through the real
+  getFrameRaw() on the mock bus:
+    - captures with no frames fail and leave the tables alone, and a
+      calibration built over garbage memory captures the same tables
+      as one that called beginCapture()
+    - the offset table captured from a flat scene matches the pattern
+      put in, survives serialize() and deserialize(), and once
+      attached cancels the pattern at other temperatures
+    - a second, hotter capture adds gain trims that cancel a gain
+      pattern across the range
+    - a damaged blob is refused and leaves the tables alone
+  Each line fails on its own; the program returns 1 if any did.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYEMockBus.h"
+#include "GridEYESimDevice.h"
+
+#include <math.h>
+#include <new>
+#include <stdio.h>
+#include <random>
+
+#define NOISE_LSB 0.6
+#define REFERENCE_LSB 88 // 22C, where the gain pattern pivots
+#define HOT_LSB 160      // 40C, second capture for gain
+#define MAX_OFFSET_LSB 6 // Pattern spans +-1.5C
+#define MAX_GAIN 0.05    // Pattern spans +-5%
+
+static std::mt19937 rng(26);
+static std::normal_distribution<double> noise(0.0, NOISE_LSB);
+static uint32_t failures = 0;
+
+static void check(const char *what, bool ok)
+{
+  printf("  %-60s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok)
+    failures++;
+}
+
+// The sensor's fixed pattern, offsets with zero mean so a flat scene keeps its level
+struct Pattern
+{
+  double offset[64]; // LSB
+  double gain[64];   // Fraction, around REFERENCE_LSB
+};
+
+static void makePattern(Pattern *pattern, bool withGain)
+{
+  std::uniform_real_distribution<double> offsets(-MAX_OFFSET_LSB, MAX_OFFSET_LSB);
+  std::uniform_real_distribution<double> gains(-MAX_GAIN, MAX_GAIN);
+  double total = 0;
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    pattern->offset[i] = offsets(rng);
+    pattern->gain[i] = withGain ? gains(rng) : 0;
+    total += pattern->offset[i];
+  }
+  for (uint8_t i = 0; i < 64; i++)
+    pattern->offset[i] -= total / 64;
+}
+
+// One sensor on a zero latency mock bus, scenes set directly
+struct Rig
+{
+  GridEYESimDevice device;
+  GridEYEMockBus bus;
+  GridEYE grideye;
+
+  Rig() : bus(0, 0, 0)
+  {
+    bus.attach(&device);
+    grideye.begin(device.address(), bus);
+  }
+
+  bool read(const Pattern &pattern, double scene, bool noisy, int16_t *frame)
+  {
+    int16_t raw[64];
+    for (uint8_t i = 0; i < 64; i++)
+    {
+      double value = scene + pattern.offset[i] + pattern.gain[i] * (scene - REFERENCE_LSB);
+      if (noisy)
+        value += noise(rng);
+      raw[i] = (int16_t)lround(value);
+    }
+    device.setPixels(raw);
+    return grideye.getFrameRaw(frame);
+  }
+
+  void capture(GridEYECalibration *calibration, const Pattern &pattern, double scene)
+  {
+    calibration->beginCapture();
+    int16_t frame[64];
+    for (uint8_t n = 0; n < GRIDEYE_CAL_MAX_CAPTURE_FRAMES; n++)
+    {
+      read(pattern, scene, true, frame);
+      calibration->addFrame(frame);
+    }
+  }
+
+  // Largest distance of a corrected, noise free frame from the scene, in LSB
+  int16_t residual(const Pattern &pattern, double scene)
+  {
+    int16_t frame[64];
+    read(pattern, scene, false, frame);
+    int16_t worst = 0;
+    for (uint8_t i = 0; i < 64; i++)
+    {
+      int16_t error = (int16_t)abs(frame[i] - (int16_t)lround(scene));
+      if (error > worst)
+        worst = error;
+    }
+    return worst;
+  }
+};
+
+static bool sameTables(GridEYECalibration &a, GridEYECalibration &b)
+{
+  uint8_t blobA[GRIDEYE_CALIBRATION_SIZE];
+  uint8_t blobB[GRIDEYE_CALIBRATION_SIZE];
+  a.serialize(blobA);
+  b.serialize(blobB);
+  return memcmp(blobA, blobB, sizeof(blobA)) == 0;
+}
+
+/********************************************************
+ * Capture state
+ ********************************************************/
+
+static void runCaptureState()
+{
+  GridEYECalibration empty;
+  bool offsetsRefused = !empty.computeOffsets() && (empty.getFlags() == 0);
+  bool gainsRefused = !empty.computeGains() && (empty.getFlags() == 0);
+  check("computeOffsets() with no frames fails, tables untouched", offsetsRefused && (empty.getCapturedFrames() == 0));
+  check("computeGains() with no frames fails, tables untouched", gainsRefused);
+
+  // A fresh capture after tables exist still needs frames
+  empty.setOffset(5, 12);
+  empty.beginCapture();
+  check("no frames since beginCapture(): old offset table kept",
+        !empty.computeOffsets() && (empty.getOffset(5) == 12));
+
+  // addFrame() straight after construction, on memory full of junk
+  Pattern pattern;
+  makePattern(&pattern, false);
+  int16_t frames[GRIDEYE_CAL_MAX_CAPTURE_FRAMES][64];
+  Rig rig;
+  for (uint8_t n = 0; n < GRIDEYE_CAL_MAX_CAPTURE_FRAMES; n++)
+    rig.read(pattern, REFERENCE_LSB, true, frames[n]);
+
+  alignas(GridEYECalibration) uint8_t storage[sizeof(GridEYECalibration)];
+  memset(storage, 0x5A, sizeof(storage));
+  GridEYECalibration *dirty = new (storage) GridEYECalibration();
+  GridEYECalibration clean;
+  clean.beginCapture();
+  for (uint8_t n = 0; n < GRIDEYE_CAL_MAX_CAPTURE_FRAMES; n++)
+  {
+    dirty->addFrame(frames[n]);
+    clean.addFrame(frames[n]);
+  }
+  bool overflowRefused = !dirty->addFrame(frames[0]);
+  dirty->computeOffsets();
+  clean.computeOffsets();
+  check("capture without beginCapture() matches one with it", sameTables(*dirty, clean));
+  check("addFrame() refuses frames past the maximum", overflowRefused);
+  dirty->~GridEYECalibration();
+}
+
+/********************************************************
+ * Offset round trip
+ ********************************************************/
+
+static void runOffsets()
+{
+  Pattern pattern;
+  makePattern(&pattern, false);
+  Rig rig;
+
+  int16_t uncorrected = rig.residual(pattern, 100);
+
+  GridEYECalibration captured;
+  rig.capture(&captured, pattern, REFERENCE_LSB);
+  bool computed = captured.computeOffsets();
+
+  // Table is in 1/16C, the pattern in quarter degrees
+  double worstTable = 0;
+  for (uint8_t i = 0; i < 64; i++)
+    worstTable = fmax(worstTable, fabs(captured.getOffset(i) - pattern.offset[i] * 4));
+
+  uint8_t blob[GRIDEYE_CALIBRATION_SIZE];
+  size_t size = captured.serialize(blob);
+  GridEYECalibration restored;
+  bool loaded = restored.deserialize(blob) && sameTables(captured, restored);
+
+  rig.grideye.setCalibration(&restored);
+  int16_t worst = 0;
+  for (int scene = 60; scene <= 200; scene += 20)
+  {
+    int16_t residual = rig.residual(pattern, scene);
+    if (residual > worst)
+      worst = residual;
+  }
+  rig.grideye.setCalibration(NULL);
+
+  char line[96];
+  snprintf(line, sizeof(line), "offset table within 3/16C of the pattern (worst %.2f)", worstTable);
+  check(line, computed && (worstTable <= 3));
+  snprintf(line, sizeof(line), "serialize() %u bytes, deserialize() restores the tables", (unsigned)size);
+  check(line, loaded && (size == GRIDEYE_CALIBRATION_SIZE));
+  snprintf(line, sizeof(line), "15C to 50C: worst pixel %d LSB corrected, %d uncorrected", worst, uncorrected);
+  check(line, (worst <= 1) && (uncorrected >= MAX_OFFSET_LSB / 2));
+}
+
+/********************************************************
+ * Gain round trip
+ ********************************************************/
+
+static void runGains()
+{
+  Pattern pattern;
+  makePattern(&pattern, true);
+  Rig rig;
+
+  GridEYECalibration calibration;
+  rig.capture(&calibration, pattern, REFERENCE_LSB);
+  calibration.computeOffsets();
+
+  rig.grideye.setCalibration(&calibration);
+  int16_t offsetOnly = rig.residual(pattern, 240);
+  rig.grideye.setCalibration(NULL);
+
+  // The second scene is captured uncorrected, like the first
+  rig.capture(&calibration, pattern, HOT_LSB);
+  bool computed = calibration.computeGains() && (calibration.getFlags() & GRIDEYE_CAL_HAS_GAIN);
+
+  rig.grideye.setCalibration(&calibration);
+  int16_t worst = 0;
+  for (int scene = 40; scene <= 240; scene += 20)
+  {
+    int16_t residual = rig.residual(pattern, scene);
+    if (residual > worst)
+      worst = residual;
+  }
+
+  // Too small a step between the captures is refused
+  GridEYECalibration close;
+  rig.grideye.setCalibration(NULL);
+  rig.capture(&close, pattern, REFERENCE_LSB);
+  close.computeOffsets();
+  rig.capture(&close, pattern, REFERENCE_LSB + 4);
+  bool refused = !close.computeGains() && !(close.getFlags() & GRIDEYE_CAL_HAS_GAIN);
+
+  char line[96];
+  snprintf(line, sizeof(line), "10C to 60C: worst pixel %d LSB with gain, %d offset only", worst, offsetOnly);
+  check(line, computed && (worst <= 1) && (offsetOnly > worst));
+  check("computeGains() refuses a second scene under 2C hotter", refused);
+}
+
+/********************************************************
+ * Damaged blob
+ ********************************************************/
+
+static void runDamaged()
+{
+  GridEYECalibration calibration;
+  for (uint8_t i = 0; i < 64; i++)
+    calibration.setOffset(i, (int8_t)(i - 32));
+  uint8_t blob[GRIDEYE_CALIBRATION_SIZE];
+  calibration.serialize(blob);
+
+  GridEYECalibration target;
+  target.setOffset(0, 7);
+  blob[40] ^= 0x10;
+  bool refused = !target.deserialize(blob) && (target.getOffset(0) == 7);
+  check("damaged blob refused, tables untouched", refused);
+}
+
+int main()
+{
+  printf("Capture state\n");
+  runCaptureState();
+  printf("Offsets, +-%.1fC pattern, %d frame captures\n", MAX_OFFSET_LSB / 4.0, GRIDEYE_CAL_MAX_CAPTURE_FRAMES);
+  runOffsets();
+  printf("Gains, +-%.0f%% pattern around 22C, second capture at 40C\n", MAX_GAIN * 100);
+  runGains();
+  printf("Storage\n");
+  runDamaged();
+
+  printf("%s\n", failures ? "FAILED" : "all checks passed");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,206 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  GridEYE ingestion daemon.
+
+  Usage:
+    grideye_ingest [-b baud] [-n name] [-s slots] device...
+    grideye_ingest -w [-n name]
+
+  Reads every device (serial ports running Example4, in CSV or with
+  BINARY_FRAMES set, or ptys) and publishes the frames to the shared
+  memory ring name (default /grideye, 1024 slots). Prints a line of
+  counters every second. Stops on Ctrl-C or once every device has hung
+  up.
+
+  -w watches a ring instead: it follows the newest frames in place,
+  without copying them, and prints the frame rate and the center pixel
+  of each source once a second. Any number of watchers can run.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYEIngest.h"
+#include "GridEYEShmRing.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static volatile bool stopping = false;
+
+static void onSignal(int)
+{
+  stopping = true;
+}
+
+static int ingest(const char *name, uint32_t slots, uint32_t baud, char **devices, int count)
+{
+  GridEYEShmRing ring;
+  if (!ring.create(name, slots))
+  {
+    fprintf(stderr, "Can't create shared memory %s with %u slots\n", name, slots);
+    return 1;
+  }
+
+  GridEYEIngest daemon(ring);
+  for (int i = 0; i < count; i++)
+  {
+    int index = daemon.addSource(devices[i], baud);
+    if (index < 0)
+    {
+      fprintf(stderr, "Can't open %s\n", devices[i]);
+      return 1;
+    }
+    printf("source %d: %s\n", index, devices[i]);
+  }
+
+  uint64_t lastFrames = 0;
+  uint64_t lastReport = hostMicros64();
+  while (!stopping && (daemon.activeSources() > 0))
+  {
+    daemon.poll(100);
+
+    uint64_t now = hostMicros64();
+    if (now - lastReport >= 1000000)
+    {
+      uint32_t badLines = 0, badChecksums = 0;
+      for (int i = 0; i < count; i++)
+      {
+        badLines += daemon.parser(i).badLines();
+        badChecksums += daemon.parser(i).badChecksums();
+      }
+      printf("%8.1f frames/s, %llu frames, %llu bytes, %u bad lines, %u bad checksums\n",
+             (daemon.frames() - lastFrames) * 1e6 / (now - lastReport), (unsigned long long)daemon.frames(),
+             (unsigned long long)daemon.bytes(), badLines, badChecksums);
+      fflush(stdout);
+      lastFrames = daemon.frames();
+      lastReport = now;
+    }
+  }
+
+  ring.unlink();
+  return 0;
+}
+
+static int watch(const char *name)
+{
+  GridEYEShmRing ring;
+  if (!ring.open(name))
+  {
+    fprintf(stderr, "No ring at %s\n", name);
+    return 1;
+  }
+
+  uint64_t next = ring.published();
+  uint64_t seen = 0;
+  uint64_t lost = 0;
+  int16_t center[GRIDEYE_INGEST_MAX_SOURCES] = {0};
+  bool heard[GRIDEYE_INGEST_MAX_SOURCES] = {false};
+  uint64_t lastReport = hostMicros64();
+  while (!stopping)
+  {
+    if (ring.wait(next, 100))
+    {
+      if (next < ring.oldest())
+      {
+        lost += ring.oldest() - next;
+        next = ring.oldest();
+      }
+      const GridEYEShmSlot *slot = ring.acquire(next);
+      if (slot != NULL)
+      {
+        uint16_t source = slot->source;
+        int16_t pixel = slot->pixels[27];
+        if (ring.valid(slot, next) && (source < GRIDEYE_INGEST_MAX_SOURCES))
+        {
+          center[source] = pixel;
+          heard[source] = true;
+          seen++;
+        }
+        else
+        {
+          lost++;
+        }
+      }
+      else
+      {
+        lost++; // Overwritten between the check and the read
+      }
+      next++;
+    }
+
+    uint64_t now = hostMicros64();
+    if (now - lastReport >= 1000000)
+    {
+      printf("%8.1f frames/s, %llu lost, center", seen * 1e6 / (now - lastReport), (unsigned long long)lost);
+      for (int i = 0; i < GRIDEYE_INGEST_MAX_SOURCES; i++)
+      {
+        if (heard[i])
+          printf(" %d:%.2fC", i, center[i] * 0.25);
+      }
+      printf("\n");
+      fflush(stdout);
+      seen = 0;
+      lastReport = now;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  const char *name = GRIDEYE_SHM_DEFAULT_NAME;
+  uint32_t slots = GRIDEYE_SHM_DEFAULT_SLOTS;
+  uint32_t baud = 115200;
+  bool watcher = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "b:n:s:w")) != -1)
+  {
+    switch (opt)
+    {
+    case 'b':
+      baud = atoi(optarg);
+      break;
+    case 'n':
+      name = optarg;
+      break;
+    case 's':
+      slots = atoi(optarg);
+      break;
+    case 'w':
+      watcher = true;
+      break;
+    default:
+      fprintf(stderr, "usage: %s [-b baud] [-n name] [-s slots] device...\n       %s -w [-n name]\n", argv[0],
+              argv[0]);
+      return 2;
+    }
+  }
+
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+
+  if (watcher)
+    return watch(name);
+  if (optind >= argc)
+  {
+    fprintf(stderr, "No devices given\n");
+    return 2;
+  }
+  return ingest(name, slots, baud, &argv[optind], argc - optind);
+}
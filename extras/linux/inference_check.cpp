@@ -0,0 +1,470 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Host check for GridEYEModel.
+
+  Usage:
+    inference_check [--emit model.h] [models]
+
+  Builds random models (convolutions with kernels 1 to 7 and stride 1
+  or 2, depthwise, dense, ReLU, fused ReLU, every shift range) and runs
+  them on random, extreme and simulated frames, checking that:
+    - outputs are bit-exact with GridEYEModelReference
+    - no accumulator leaves int32
+    - getArenaSize() matches the reference planner, one byte less makes
+      begin() fail, and nothing outside the arena is written
+    - a corrupted or truncated blob makes begin() fail
+    - a model with over 255 outputs makes begin() fail
+
+  It then builds the small occupancy model used by Example12 (mean
+  removal, 3x3 blur and center-surround, 3x3 stride 2 pooling, dense
+  32 -> 2), checks it separates empty and occupied synthetic frames,
+  and reports MACs, RAM, host latency and a rough AVR estimate.
+  --emit writes that model as a PROGMEM array for a sketch.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYEModelBuilder.h"
+#include "GridEYESimDevice.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#define CHECK_MODELS 400
+#define FRAMES_PER_MODEL 12
+#define DEMO_FRAMES 2000
+#define TIMING_RUNS 20000
+#define ARENA_GUARD 16
+#define AVR_CYCLES_PER_MAC 30 // Rough: int8 x int8 into int32 with a pgm_read_byte per weight
+#define AVR_CLOCK_MHZ 16
+
+static std::mt19937 rng(1);
+
+static int32_t randomInt(int32_t low, int32_t high)
+{
+  return std::uniform_int_distribution<int32_t>(low, high)(rng);
+}
+
+static void readFrame(GridEYESimDevice &device, int16_t *frame)
+{
+  uint8_t raw[GRIDEYE_FRAME_BYTES];
+  device.stepScene();
+  device.read(TEMPERATURE_REGISTER_START, raw, sizeof(raw));
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    uint16_t val = (((uint16_t)raw[2 * i + 1]) << 8) | raw[2 * i];
+    frame[i] = (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800;
+  }
+}
+
+/********************************************************
+ * Random models
+ ********************************************************/
+
+static std::vector<int8_t> randomWeights(size_t count)
+{
+  std::vector<int8_t> weights(count);
+  for (size_t i = 0; i < count; i++)
+    weights[i] = (int8_t)randomInt(-128, 127);
+  return weights;
+}
+
+static std::vector<int32_t> randomBias(size_t count)
+{
+  std::vector<int32_t> bias(count);
+  for (size_t i = 0; i < count; i++)
+    bias[i] = randomInt(-(1 << 20), 1 << 20);
+  return bias;
+}
+
+static std::vector<uint8_t> randomModel()
+{
+  GridEYEModelBuilder builder;
+  builder.setInputQuantized(randomInt(-200, 200), randomInt(1, 32767), randomInt(0, 15), randomInt(0, 1));
+
+  int side = 8;
+  int channels = 1;
+  bool flat = false; // After a dense layer only dense and ReLU make sense
+  int layers = randomInt(1, 5);
+  for (int n = 0; n < layers; n++)
+  {
+    int type = flat ? (randomInt(0, 3) ? GRIDEYE_LAYER_DENSE : GRIDEYE_LAYER_RELU) : randomInt(1, 4);
+    int16_t multiplier = randomInt(1, 32767);
+    uint8_t shift = randomInt(0, 46);
+    bool relu = randomInt(0, 1);
+
+    if (type == GRIDEYE_LAYER_CONV)
+    {
+      int out = randomInt(1, 8);
+      int kernel = 2 * randomInt(0, 3) + 1;
+      int stride = randomInt(1, 2);
+      builder.addConvQuantized(out, kernel, stride, multiplier, shift, randomBias(out),
+                               randomWeights(out * kernel * kernel * channels), relu);
+      side = (side + stride - 1) / stride;
+      channels = out;
+    }
+    else if (type == GRIDEYE_LAYER_DEPTHWISE)
+    {
+      int kernel = 2 * randomInt(0, 3) + 1;
+      int stride = randomInt(1, 2);
+      builder.addDepthwiseQuantized(kernel, stride, multiplier, shift, randomBias(channels),
+                                    randomWeights(kernel * kernel * channels), relu);
+      side = (side + stride - 1) / stride;
+    }
+    else if (type == GRIDEYE_LAYER_DENSE)
+    {
+      int out = randomInt(1, 16);
+      builder.addDenseQuantized(out, multiplier, shift, randomBias(out),
+                                randomWeights(out * side * side * channels), relu);
+      side = 1;
+      channels = out;
+      flat = true;
+    }
+    else
+    {
+      builder.addReLU();
+    }
+  }
+  return builder.build();
+}
+
+static void randomFrame(int kind, GridEYESimDevice &device, int16_t *frame)
+{
+  for (int i = 0; i < 64; i++)
+  {
+    switch (kind)
+    {
+    case 0:
+      frame[i] = randomInt(-2048, 2047);
+      break;
+    case 1:
+      frame[i] = -2048;
+      break;
+    case 2:
+      frame[i] = 2047;
+      break;
+    case 3:
+      frame[i] = (i & 1) ? 2047 : -2048;
+      break;
+    default:
+      break;
+    }
+  }
+  if (kind >= 4)
+    readFrame(device, frame);
+}
+
+static int checkModels(int count)
+{
+  GridEYESimDevice device;
+  int errors = 0;
+  int wide = 0;
+
+  for (int m = 0; m < count; m++)
+  {
+    std::vector<uint8_t> blob = randomModel();
+    GridEYEModelReference reference;
+    if (!reference.load(blob))
+    {
+      printf("model %d: reference rejected a built model\n", m);
+      errors++;
+      continue;
+    }
+
+    GridEYEModel model;
+    uint32_t size = reference.arenaSize();
+    std::vector<int8_t> buffer(size + 2 * ARENA_GUARD, (int8_t)0xA5);
+    int8_t *arena = buffer.data() + ARENA_GUARD;
+
+    // getOutput() takes a byte index, so wider outputs are refused
+    int16_t zero[64] = {0};
+    std::vector<int8_t> shape;
+    reference.run(zero, &shape);
+    if (shape.size() > 255)
+    {
+      wide++;
+      if (model.begin(blob.data(), arena, size))
+      {
+        printf("model %d: begin() accepted %u outputs\n", m, (unsigned)shape.size());
+        errors++;
+      }
+      continue;
+    }
+
+    if (model.begin(blob.data(), arena, size - 1))
+    {
+      printf("model %d: begin() accepted an arena one byte short\n", m);
+      errors++;
+    }
+    if (!model.begin(blob.data(), arena, size) || (model.getArenaSize() != size))
+    {
+      printf("model %d: arena %u, reference %u\n", m, model.getArenaSize(), size);
+      errors++;
+      continue;
+    }
+
+    for (int f = 0; f < FRAMES_PER_MODEL; f++)
+    {
+      int16_t frame[64];
+      randomFrame(f % 6, device, frame);
+
+      std::vector<int8_t> expected;
+      reference.run(frame, &expected);
+      if (!model.run(frame))
+      {
+        printf("model %d: run() failed\n", m);
+        errors++;
+        break;
+      }
+
+      size_t outputs = expected.size();
+      if ((model.getOutputCount() != outputs) || memcmp(model.getOutputs(), expected.data(), outputs))
+      {
+        printf("model %d frame %d: outputs differ from the reference\n", m, f);
+        errors++;
+        break;
+      }
+    }
+
+    for (int i = 0; i < ARENA_GUARD; i++)
+    {
+      if ((buffer[i] != (int8_t)0xA5) || (buffer[ARENA_GUARD + size + i] != (int8_t)0xA5))
+      {
+        printf("model %d: wrote outside the arena\n", m);
+        errors++;
+        break;
+      }
+    }
+    if (reference.overflows())
+    {
+      printf("model %d: %u accumulators outside int32\n", m, reference.overflows());
+      errors++;
+    }
+
+    // Any single changed byte breaks the checksum
+    std::vector<uint8_t> corrupt = blob;
+    corrupt[randomInt(0, corrupt.size() - 1)] ^= (uint8_t)randomInt(1, 255);
+    if (model.begin(corrupt.data(), arena, size))
+    {
+      printf("model %d: begin() accepted a corrupted blob\n", m);
+      errors++;
+    }
+
+    // A blob whose length says it ends early must not parse either
+    std::vector<uint8_t> truncated(blob.begin(), blob.end() - 2);
+    uint16_t length = truncated.size() + 1;
+    truncated[4] = length & 0xFF;
+    truncated[5] = length >> 8;
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < truncated.size(); i++)
+      checksum += truncated[i];
+    truncated.push_back(~checksum);
+    if (model.begin(truncated.data(), arena, size))
+    {
+      printf("model %d: begin() accepted a truncated blob\n", m);
+      errors++;
+    }
+  }
+
+  printf("%d random models with over 255 outputs, all refused by begin()\n", wide);
+  return errors;
+}
+
+/********************************************************
+ * Occupancy demo
+ ********************************************************
+ *
+ * Hand-built rather than trained: the mean is removed, a
+ * 3x3 blur and a center-surround filter pick out warm
+ * spots, 2x2 pooling shrinks them to 4x4 and a dense layer
+ * compares the total response with a threshold. A trained
+ * model uses the same blob format.
+ *
+ ********************************************************/
+
+static std::vector<uint8_t> occupancyModel()
+{
+  GridEYEModelBuilder builder;
+  builder.setInput(0, 2.0f, true); // Half LSB (0.125C) per step
+
+  std::vector<float> conv;
+  for (int i = 0; i < 9; i++)
+    conv.push_back(1.0f / 9); // Blur
+  for (int i = 0; i < 9; i++)
+    conv.push_back((i == 4) ? 1.0f : -1.0f / 8); // Center-surround
+  // The bias drops sensor noise and gentle gradients below zero
+  builder.addConv(2, 3, 1, std::vector<float>(2, -2.0f), conv, 0.25f, true);
+
+  // Overlapping 3x3 stride 2 pooling down to 4x4
+  std::vector<float> pool(9 * 2, 1.0f / 4);
+  builder.addDepthwise(3, 2, std::vector<float>(2, 0.0f), pool, 0.25f, true);
+
+  // Output 0 is a constant "empty" score, output 1 the warm spot evidence
+  std::vector<float> dense(2 * 32, 0.0f);
+  for (int i = 0; i < 16; i++)
+  {
+    dense[32 + 2 * i] = 0.1f;
+    dense[32 + 2 * i + 1] = 1.0f;
+  }
+  builder.addDense(2, std::vector<float>{0.0f, -2.0f}, dense, 0.125f, false);
+
+  return builder.build();
+}
+
+// Ambient 18-30C with a gentle gradient and sensor noise, plus a blob 3-8C warmer if occupied
+static void syntheticFrame(bool occupied, int16_t *frame)
+{
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  double ambient = 18 + 12 * unit(rng);
+  double gx = (unit(rng) - 0.5) * 1.5 / 7; // Up to 0.75C each way across the frame
+  double gy = (unit(rng) - 0.5) * 1.5 / 7;
+  double bx = 7 * unit(rng);
+  double by = 7 * unit(rng);
+  double amplitude = 3 + 5 * unit(rng);
+  double sigma = 0.7 + 0.8 * unit(rng);
+
+  for (int y = 0; y < 8; y++)
+  {
+    for (int x = 0; x < 8; x++)
+    {
+      double t = ambient + gx * (x - 3.5) + gy * (y - 3.5);
+      if (occupied)
+        t += amplitude * exp(-((x - bx) * (x - bx) + (y - by) * (y - by)) / (2 * sigma * sigma));
+      frame[y * 8 + x] = (int16_t)lround(t * 4) + randomInt(-1, 1);
+    }
+  }
+}
+
+static bool emitModel(const char *path, const std::vector<uint8_t> &blob)
+{
+  FILE *file = fopen(path, "w");
+  if (file == NULL)
+  {
+    perror(path);
+    return false;
+  }
+  fprintf(file, "// Occupancy model for GridEYEModel, written by extras/linux/inference_check --emit\n");
+  fprintf(file, "// Hand-built, not trained; see inference_check.cpp for how it works\n");
+  fprintf(file, "// Outputs: 0 empty, 1 occupied\n\n");
+  fprintf(file, "const uint8_t occupancyModel[%u] PROGMEM = {", (unsigned)blob.size());
+  for (size_t i = 0; i < blob.size(); i++)
+    fprintf(file, "%s0x%02X", (i % 12) ? ", " : (i ? ",\n  " : "\n  "), blob[i]);
+  fprintf(file, "\n};\n");
+  fclose(file);
+  return true;
+}
+
+static int checkDemo(const char *emitPath)
+{
+  std::vector<uint8_t> blob = occupancyModel();
+  GridEYEModelReference reference;
+  if (!reference.load(blob))
+  {
+    printf("demo: reference rejected the model\n");
+    return 1;
+  }
+
+  GridEYEModel model;
+  static int8_t arena[512];
+  if (!model.begin(blob.data(), arena, sizeof(arena)))
+  {
+    printf("demo: begin() failed\n");
+    return 1;
+  }
+
+  int errors = 0;
+  int wrong[2] = {0, 0};
+  for (int i = 0; i < DEMO_FRAMES; i++)
+  {
+    int16_t frame[64];
+    bool occupied = i & 1;
+    syntheticFrame(occupied, frame);
+    model.run(frame);
+    if (model.getClass() != (uint8_t)occupied)
+      wrong[occupied]++;
+
+    std::vector<int8_t> expected;
+    reference.run(frame, &expected);
+    if (memcmp(model.getOutputs(), expected.data(), expected.size()))
+      errors++;
+  }
+
+  // The simulator's blob is always occupied
+  GridEYESimDevice device;
+  for (int i = 0; i < 512; i++)
+  {
+    int16_t frame[64];
+    readFrame(device, frame);
+    model.run(frame);
+    if (model.getClass() != 1)
+      wrong[1]++;
+  }
+
+  int16_t frame[64];
+  syntheticFrame(true, frame);
+  uint64_t start = hostMicros64();
+  for (int i = 0; i < TIMING_RUNS; i++)
+    model.run(frame);
+  double hostUs = (double)(hostMicros64() - start) / TIMING_RUNS;
+
+  printf("demo model: %u bytes, %u MACs, arena %u bytes, object %u bytes\n", (unsigned)blob.size(),
+         reference.macs(), model.getArenaSize(), (unsigned)sizeof(GridEYEModel));
+  printf("  empty frames called occupied   %d / %d\n", wrong[0], DEMO_FRAMES / 2);
+  printf("  occupied frames called empty   %d / %d\n", wrong[1], DEMO_FRAMES / 2 + 512);
+  printf("  host latency                   %.2f us per run\n", hostUs);
+  printf("  AVR estimate (not measured)    %.1f ms at %d cycles/MAC, %d MHz\n",
+         reference.macs() * (double)AVR_CYCLES_PER_MAC / (AVR_CLOCK_MHZ * 1000.0), AVR_CYCLES_PER_MAC,
+         AVR_CLOCK_MHZ);
+
+  if (errors)
+  {
+    printf("demo: %d frames differ from the reference\n", errors);
+  }
+  // Allow a little confusion on the faintest, widest synthetic blobs
+  if (wrong[0] + wrong[1] > DEMO_FRAMES / 100)
+  {
+    printf("demo: too many misclassified frames\n");
+    errors++;
+  }
+
+  if (emitPath && !emitModel(emitPath, blob))
+    errors++;
+  return errors;
+}
+
+int main(int argc, char **argv)
+{
+  const char *emitPath = NULL;
+  int models = CHECK_MODELS;
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "--emit") && (i + 1 < argc))
+      emitPath = argv[++i];
+    else
+      models = atoi(argv[i]);
+  }
+
+  int errors = checkModels(models);
+  printf("%d random models, %d frames each: %d errors\n", models, FRAMES_PER_MODEL, errors);
+
+  errors += checkDemo(emitPath);
+  printf("%s\n", errors ? "FAILED" : "all checks passed");
+  return errors ? 1 : 0;
+}
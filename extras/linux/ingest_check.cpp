@@ -0,0 +1,578 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Check and benchmark for the ingestion daemon parts: GridEYEStreamParser,
+  GridEYEShmRing and GridEYEIngest.
+
+  Usage:
+    ingest_check [sources] [frames per source]
+
+  Parser: random frames, CSV printed the way Example4 prints them and
+  binary frames, mixed with noise lines, cut lines, stray sync bytes and
+  corrupted binary frames, fed in random sized pieces. Every good frame
+  must come out, in order and exact, and the conversion of decimal text
+  to quarter degrees must match a reference for random values.
+
+  End to end: one pty per source (default 4, 20000 frames each), half
+  CSV and half binary, written by one thread each. The ingest loop
+  reads the slave sides like serial ports and publishes to a shared
+  memory ring, while three forked reader processes follow the ring in
+  place and check every frame they get is whole and in order.
+
+  Reports parser frames per second on one core for each format, the end
+  to end rate, ingest CPU time per frame and the heap allocations made
+  while ingesting (there should be none).
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridEYEIngest.h"
+#include "GridEYEShmRing.h"
+#include "GridEYEStreamParser.h"
+
+#include <atomic>
+#include <fcntl.h>
+#include <math.h>
+#include <new>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#define PARSER_FRAMES 4000
+#define READERS 3
+#define BENCH_MICROSECONDS 300000
+
+/********************************************************
+ * Allocation counter
+ ********************************************************/
+
+static std::atomic<uint64_t> allocations(0);
+
+void *operator new(size_t size)
+{
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == NULL)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+  free(p);
+}
+
+static std::mt19937 rng(11);
+
+static int randomInt(int low, int high)
+{
+  return std::uniform_int_distribution<int>(low, high)(rng);
+}
+
+static uint64_t threadCpuMicros()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+/********************************************************
+ * Encoders
+ ********************************************************
+ *
+ * appendCsv() - one line as Example4 prints it: Arduino's
+ *    Serial.print(float) gives two decimals
+ *
+ ********************************************************/
+
+static void appendCsv(std::string &out, const int16_t *pixels)
+{
+  char text[16];
+  for (int i = 0; i < 64; i++)
+  {
+    snprintf(text, sizeof(text), "%.2f,", pixels[i] * 0.25);
+    out += text;
+  }
+  out += "\r\n";
+}
+
+static size_t writeCsv(char *out, const int16_t *pixels)
+{
+  size_t len = 0;
+  for (int i = 0; i < 64; i++)
+    len += snprintf(out + len, 16, "%.2f,", pixels[i] * 0.25);
+  out[len++] = '\r';
+  out[len++] = '\n';
+  return len;
+}
+
+static void binaryFrame(const int16_t *pixels, int16_t thermistor, uint8_t sequence, uint8_t *out)
+{
+  uint8_t registers[GRIDEYE_FRAME_BYTES];
+  for (int i = 0; i < 64; i++)
+  {
+    registers[2 * i] = pixels[i] & 0xFF;
+    registers[2 * i + 1] = (pixels[i] >> 8) & 0x0F;
+  }
+  uint16_t therm = (thermistor < 0) ? (uint16_t)(0x0800 | (-thermistor)) : (uint16_t)thermistor;
+  GridEYEStreamParser::encodeBinary(registers, therm, sequence, out);
+}
+
+static void appendBinary(std::string &out, const int16_t *pixels, int16_t thermistor, uint8_t sequence)
+{
+  uint8_t frame[GRIDEYE_STREAM_BINARY_BYTES];
+  binaryFrame(pixels, thermistor, sequence, frame);
+  out.append((const char *)frame, sizeof(frame));
+}
+
+/********************************************************
+ * Parser properties
+ ********************************************************/
+
+struct Collected
+{
+  std::vector<GridEYEStreamFrame> frames;
+};
+
+static void collect(const GridEYEStreamFrame *frame, void *context)
+{
+  ((Collected *)context)->frames.push_back(*frame);
+}
+
+static bool sameFrame(const GridEYEStreamFrame &a, const GridEYEStreamFrame &b)
+{
+  return (a.format == b.format) && (a.thermistor == b.thermistor) && (a.sequence == b.sequence) &&
+         (memcmp(a.pixels, b.pixels, sizeof(a.pixels)) == 0);
+}
+
+static int checkParser()
+{
+  std::string stream;
+  std::vector<GridEYEStreamFrame> expected;
+
+  for (int f = 0; f < PARSER_FRAMES; f++)
+  {
+    GridEYEStreamFrame frame;
+    for (int i = 0; i < 64; i++)
+      frame.pixels[i] = (int16_t)randomInt(-2048, 2047);
+
+    if (randomInt(0, 1))
+    {
+      frame.format = GRIDEYE_STREAM_CSV;
+      frame.thermistor = GRIDEYE_STREAM_NO_THERMISTOR;
+      frame.sequence = 0;
+      appendCsv(stream, frame.pixels);
+    }
+    else
+    {
+      frame.format = GRIDEYE_STREAM_BINARY;
+      frame.thermistor = (int16_t)randomInt(-2047, 2047);
+      frame.sequence = (uint8_t)f;
+      appendBinary(stream, frame.pixels, frame.thermistor, frame.sequence);
+    }
+    expected.push_back(frame);
+
+    // Damage between frames. A corrupted binary frame is followed by a line end so
+    // whatever its bytes leave behind as text is closed off before the next frame.
+    switch (randomInt(0, 9))
+    {
+    case 0: // Noise line
+      for (int n = randomInt(1, 80); n > 0; n--)
+        stream += (char)randomInt(32, 126);
+      stream += "\n";
+      break;
+    case 1: // Line cut inside its last 63 values (a last value without a comma is fine)
+    {
+      std::string line;
+      appendCsv(line, frame.pixels);
+      stream += line.substr(0, randomInt(1, (int)line.size() - 12)) + "\n";
+      break;
+    }
+    case 2: // Sync byte in the middle of a line
+    {
+      std::string line;
+      appendCsv(line, frame.pixels);
+      line[randomInt(1, (int)line.size() - 3)] = (char)GRIDEYE_STREAM_SYNC0;
+      stream += line;
+      break;
+    }
+    case 3: // Corrupted binary frame. A sequence of 0xAA followed by pixel 0 = 0x55 looks
+            // like a sync; real senders can't avoid that, the test does.
+    {
+      uint8_t bad[GRIDEYE_STREAM_BINARY_BYTES];
+      binaryFrame(frame.pixels, frame.thermistor, 0x11, bad);
+      bad[randomInt(3, GRIDEYE_STREAM_BINARY_BYTES - 1)] ^= (uint8_t)randomInt(1, 255);
+      stream.append((const char *)bad, sizeof(bad));
+      stream += "\n";
+      break;
+    }
+    case 4: // Truncated binary frame followed by a line end
+      stream.append("\xAA\x55\x01\x02\x03\n");
+      break;
+    default:
+      break;
+    }
+  }
+  // A truncated binary frame can swallow up to a frame of what follows it; pad the end
+  stream += std::string(GRIDEYE_STREAM_BINARY_BYTES, '\n');
+
+  Collected got;
+  GridEYEStreamParser parser;
+  parser.setHandler(collect, &got);
+  size_t at = 0;
+  while (at < stream.size())
+  {
+    size_t piece = std::min((size_t)randomInt(1, 300), stream.size() - at);
+    parser.parse((const uint8_t *)stream.data() + at, piece);
+    at += piece;
+  }
+
+  int errors = 0;
+  size_t matched = 0;
+  for (size_t e = 0, g = 0; e < expected.size(); e++)
+  {
+    while ((g < got.frames.size()) && !sameFrame(got.frames[g], expected[e]))
+      g++;
+    if (g == got.frames.size())
+      break;
+    matched++;
+    g++;
+  }
+  bool allFrames = (matched == expected.size()) && (got.frames.size() == expected.size());
+  printf("  %-60s %s (%zu of %zu, %u bad lines, %u bad checksums)\n", "every good frame out, in order, exact",
+         allFrames ? "ok" : "FAILED", matched, expected.size(), parser.badLines(), parser.badChecksums());
+  errors += !allFrames;
+
+  // Decimal text to quarter degrees, half away from zero
+  int conversionErrors = 0;
+  for (int t = 0; t < 200000; t++)
+  {
+    int whole = randomInt(0, 511);
+    int digits = randomInt(0, 4);
+    int fraction = randomInt(0, (int)pow(10, digits) - 1);
+    bool negative = randomInt(0, 1);
+    char line[1024];
+    size_t len = 0;
+    for (int i = 0; i < 64; i++)
+    {
+      if (digits)
+        len += snprintf(line + len, 32, "%s%d.%0*d,", negative ? "-" : "", whole, digits, fraction);
+      else
+        len += snprintf(line + len, 32, "%s%d,", negative ? "-" : "", whole);
+    }
+    line[len++] = '\n';
+
+    long double value = strtold(line, NULL);
+    long reference = lroundl(value * 4);
+    if (reference > 2047)
+      reference = 2047;
+    if (reference < -2048)
+      reference = -2048;
+
+    Collected one;
+    GridEYEStreamParser single;
+    single.setHandler(collect, &one);
+    single.parse((const uint8_t *)line, len);
+    if ((one.frames.size() != 1) || (one.frames[0].pixels[63] != reference))
+      conversionErrors++;
+  }
+  printf("  %-60s %s\n", "decimal to quarter degrees matches the reference", conversionErrors ? "FAILED" : "ok");
+  errors += conversionErrors != 0;
+  return errors;
+}
+
+/********************************************************
+ * Parser throughput
+ ********************************************************/
+
+static void countFrame(const GridEYEStreamFrame *, void *context)
+{
+  (*(uint64_t *)context)++;
+}
+
+static double parserRate(const std::string &stream, uint32_t framesInStream, uint64_t *allocated)
+{
+  uint64_t frames = 0;
+  GridEYEStreamParser parser;
+  parser.setHandler(countFrame, &frames);
+
+  uint64_t before = allocations;
+  uint64_t start = threadCpuMicros();
+  uint64_t passes = 0;
+  while (threadCpuMicros() - start < BENCH_MICROSECONDS)
+  {
+    parser.parse((const uint8_t *)stream.data(), stream.size());
+    passes++;
+  }
+  uint64_t used = threadCpuMicros() - start;
+  *allocated = allocations - before;
+  if (frames != passes * framesInStream)
+    return -1;
+  return frames * 1e6 / used;
+}
+
+/********************************************************
+ * End to end over ptys
+ ********************************************************
+ *
+ * Frame k of source s: pixel 0 and 1 hold k, the rest are
+ * a hash of (s, k, pixel), so a reader can tell a torn
+ * frame or a mixed up source from the frame alone.
+ *
+ ********************************************************/
+
+static int16_t pattern(uint32_t source, uint32_t k, uint32_t pixel)
+{
+  uint32_t h = (source * 0x9E3779B1u) ^ (k * 0x85EBCA77u) ^ (pixel * 0xC2B2AE3Du);
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 13;
+  return (int16_t)((h & 0x0FFF) - 0x0800);
+}
+
+static void patternFrame(uint32_t source, uint32_t k, int16_t *pixels)
+{
+  pixels[0] = (int16_t)(k & 0x07FF);
+  pixels[1] = (int16_t)((k >> 11) & 0x07FF);
+  for (uint32_t i = 2; i < 64; i++)
+    pixels[i] = pattern(source, k, i);
+}
+
+static void writer(int fd, uint32_t source, uint32_t frames, bool binary)
+{
+  char buffer[4096];
+  size_t used = 0;
+  for (uint32_t k = 0; k <= frames; k++)
+  {
+    if ((k == frames) || (used + 600 > sizeof(buffer)))
+    {
+      for (size_t sent = 0; sent < used;)
+      {
+        ssize_t n = write(fd, buffer + sent, used - sent);
+        if (n > 0)
+          sent += n;
+      }
+      used = 0;
+    }
+    if (k == frames)
+      break;
+
+    int16_t pixels[64];
+    patternFrame(source, k, pixels);
+    if (binary)
+    {
+      binaryFrame(pixels, 400, (uint8_t)k, (uint8_t *)buffer + used);
+      used += GRIDEYE_STREAM_BINARY_BYTES;
+    }
+    else
+    {
+      used += writeCsv(buffer + used, pixels);
+    }
+  }
+  // Let the ingest side drain the pty before hanging up, data queued at close can be dropped
+  usleep(200000);
+  close(fd);
+}
+
+struct ReaderResult
+{
+  uint64_t seen;
+  uint64_t lost;
+  uint64_t bad;
+};
+
+static void reader(const char *name, uint64_t total, uint32_t sources, int resultFd)
+{
+  ReaderResult result = {0, 0, 0};
+  GridEYEShmRing ring;
+  if (ring.open(name))
+  {
+    std::vector<int64_t> last(sources, -1);
+    uint64_t next = 0;
+    while (next < total)
+    {
+      if (!ring.wait(next, 5000))
+        break;
+      const GridEYEShmSlot *slot = ring.acquire(next);
+      if (slot == NULL)
+      {
+        result.lost++;
+        next++;
+        continue;
+      }
+
+      // Checked in place, then confirmed not overwritten meanwhile
+      uint32_t source = slot->source;
+      uint32_t k = (uint32_t)slot->pixels[0] | ((uint32_t)slot->pixels[1] << 11);
+      bool whole = source < sources;
+      for (uint32_t i = 2; whole && (i < 64); i++)
+        whole = (slot->pixels[i] == pattern(source, k, i));
+      if (!ring.valid(slot, next))
+      {
+        result.lost++;
+      }
+      else if (!whole || ((int64_t)k <= last[source]))
+      {
+        result.bad++;
+      }
+      else
+      {
+        last[source] = k;
+        result.seen++;
+      }
+      next++;
+    }
+    result.lost += total - next;
+  }
+  if (write(resultFd, &result, sizeof(result)) != sizeof(result))
+    _exit(1);
+  _exit(0);
+}
+
+static int runPtys(uint32_t sources, uint32_t frames)
+{
+  char name[64];
+  snprintf(name, sizeof(name), "/grideye_check_%d", (int)getpid());
+  GridEYEShmRing ring;
+  if (!ring.create(name, 1 << 16))
+  {
+    printf("  can't create shared memory\n");
+    return 1;
+  }
+  uint64_t total = (uint64_t)sources * frames;
+
+  // Readers first, while this process still has one thread
+  int results[2];
+  if (pipe(results) != 0)
+    return 1;
+  std::vector<pid_t> readers;
+  for (int r = 0; r < READERS; r++)
+  {
+    pid_t pid = fork();
+    if (pid == 0)
+      reader(name, total, sources, results[1]);
+    readers.push_back(pid);
+  }
+
+  GridEYEIngest ingest(ring);
+  std::vector<int> masters;
+  for (uint32_t s = 0; s < sources; s++)
+  {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0) || (ingest.addSource(ptsname(master)) < 0))
+    {
+      printf("  can't set up pty %u\n", s);
+      return 1;
+    }
+    masters.push_back(master);
+  }
+
+  uint64_t allocatedBefore = allocations;
+  uint64_t start = hostMicros64();
+  uint64_t cpuStart = threadCpuMicros();
+  std::vector<std::thread> writers;
+  for (uint32_t s = 0; s < sources; s++)
+    writers.push_back(std::thread(writer, masters[s], s, frames, (s & 1) != 0));
+
+  // Allocations from here on are the writer threads starting; count ingest separately
+  uint64_t allocatedThreads = allocations - allocatedBefore;
+  while (ingest.activeSources() > 0)
+    ingest.poll(1000);
+  uint64_t cpu = threadCpuMicros() - cpuStart;
+  uint64_t wall = hostMicros64() - start;
+  uint64_t allocated = allocations - allocatedBefore - allocatedThreads;
+  for (size_t i = 0; i < writers.size(); i++)
+    writers[i].join();
+
+  int errors = 0;
+  bool allIn = ingest.frames() == total;
+  printf("  %-60s %s (%llu of %llu)\n", "every frame written reached the ring", allIn ? "ok" : "FAILED",
+         (unsigned long long)ingest.frames(), (unsigned long long)total);
+  errors += !allIn;
+
+  for (int r = 0; r < READERS; r++)
+  {
+    ReaderResult result;
+    int status = 0;
+    bool ok = (read(results[0], &result, sizeof(result)) == sizeof(result));
+    waitpid(readers[r], &status, 0);
+    ok = ok && WIFEXITED(status) && (WEXITSTATUS(status) == 0) && (result.bad == 0) &&
+         (result.seen + result.lost == total);
+    char what[80];
+    snprintf(what, sizeof(what), "reader %d: frames whole and in order", r);
+    printf("  %-60s %s (%llu seen, %llu lapped)\n", what, ok ? "ok" : "FAILED", (unsigned long long)result.seen,
+           (unsigned long long)result.lost);
+    errors += !ok;
+  }
+  printf("  %-60s %s (%llu)\n", "no heap allocations while ingesting", allocated ? "FAILED" : "ok",
+         (unsigned long long)allocated);
+  errors += allocated != 0;
+  ring.unlink();
+
+  printf("\nEnd to end, %u ptys, %d readers\n", sources, READERS);
+  printf("  %10.0f frames/s wall\n", total * 1e6 / wall);
+  printf("  %10.0f frames/s per core of ingest CPU (%.2f us per frame)\n", total * 1e6 / cpu,
+         (double)cpu / total);
+  return errors;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t sources = (argc > 1) ? atoi(argv[1]) : 4;
+  uint32_t frames = (argc > 2) ? atoi(argv[2]) : 20000;
+  if (sources > GRIDEYE_INGEST_MAX_SOURCES)
+    sources = GRIDEYE_INGEST_MAX_SOURCES;
+
+  printf("Parser\n");
+  int errors = checkParser();
+
+  printf("\nPty ingestion\n");
+  errors += runPtys(sources, frames);
+
+  std::string csv, binary;
+  int16_t pixels[64];
+  for (uint32_t k = 0; k < 256; k++)
+  {
+    patternFrame(0, k, pixels);
+    appendCsv(csv, pixels);
+    appendBinary(binary, pixels, 400, (uint8_t)k);
+  }
+  uint64_t csvAllocated, binaryAllocated;
+  double csvRate = parserRate(csv, 256, &csvAllocated);
+  double binaryRate = parserRate(binary, 256, &binaryAllocated);
+  printf("\nParser alone, one core\n");
+  printf("  %-8s %10.0f frames/s %8.1f MB/s (%zu bytes per frame)\n", "CSV", csvRate,
+         csvRate * csv.size() / 256 / 1e6, csv.size() / 256);
+  printf("  %-8s %10.0f frames/s %8.1f MB/s (%d bytes per frame)\n", "binary", binaryRate,
+         binaryRate * GRIDEYE_STREAM_BINARY_BYTES / 1e6, GRIDEYE_STREAM_BINARY_BYTES);
+  if ((csvRate < 0) || (binaryRate < 0) || csvAllocated || binaryAllocated)
+  {
+    printf("  parser benchmark FAILED\n");
+    errors++;
+  }
+
+  printf("\n%s\n", errors ? "FAILED" : "all checks passed");
+  return errors ? 1 : 0;
+}
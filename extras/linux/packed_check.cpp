@@ -0,0 +1,478 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Checks and timing for GridEYEPacked and GridEYEFrameRing.
+
+  Usage:
+    packed_check
+
+  On random full range frames, the simulated scene and the 12-bit
+  limits:
+    - 12-bit pack then unpack gives the frame back, getPixel() agrees
+      with unpack() on every pixel and unpackPadded() with
+      GridEYEFilter::pad()
+    - values past 12 bits are clamped and counted
+    - delta frames with 0 to 64 far pixels: exact up to
+      GRIDEYE_DELTA_ESCAPES, then clamped toward the true value and
+      counted; getDeltaPixel() and unpackDeltaPadded() agree
+    - both ring formats keep the newest frames in order through
+      several wraps
+  Then each kernel is timed in ns and cycles per frame, next to a plain
+  memcpy of the int16 frame, and the frames 2 KB holds are listed.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYESimDevice.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_CYCLES 1
+static inline uint64_t cycles()
+{
+  return __rdtsc();
+}
+#else
+#define HAVE_CYCLES 0
+static inline uint64_t cycles()
+{
+  return 0;
+}
+#endif
+
+#define CHECK_FRAMES 5000
+#define TIMING_RUNS 11
+#define TIMING_CALLS 200000 // Per run
+#define MEMORY_BYTES 2048
+
+static std::mt19937 rng(5);
+static uint32_t failures = 0;
+
+static void check(const char *what, bool ok)
+{
+  printf("  %-60s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok)
+    failures++;
+}
+
+static void randomFrame(int16_t *frame, int low, int high)
+{
+  std::uniform_int_distribution<int> value(low, high);
+  for (int i = 0; i < 64; i++)
+    frame[i] = (int16_t)value(rng);
+}
+
+// The next step of the simulated scene, decoded the way GridEYE does
+static void sceneFrame(GridEYESimDevice &device, int16_t *frame)
+{
+  uint8_t raw[GRIDEYE_FRAME_BYTES];
+  device.stepScene();
+  device.read(TEMPERATURE_REGISTER_START, raw, sizeof(raw));
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    uint16_t val = (((uint16_t)raw[2 * i + 1]) << 8) | raw[2 * i];
+    frame[i] = (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800;
+  }
+}
+
+/********************************************************
+ * 12-bit
+ ********************************************************/
+
+static void check12()
+{
+  GridEYESimDevice device;
+  uint32_t wrong = 0;
+  uint32_t wrongPixel = 0;
+  uint32_t wrongPadded = 0;
+  uint32_t wrongClamped = 0;
+  for (int n = 0; n < CHECK_FRAMES; n++)
+  {
+    int16_t frame[64], back[64];
+    if (n % 3 == 0)
+      sceneFrame(device, frame);
+    else
+      randomFrame(frame, -2048, 2047);
+    if ((n % 7) == 0)
+    {
+      frame[n % 64] = -2048;
+      frame[(n + 1) % 64] = 2047;
+    }
+
+    uint8_t packed[GRIDEYE_PACKED_BYTES];
+    if (GridEYEPacked::pack(frame, packed) != 0)
+      wrongClamped++;
+    GridEYEPacked::unpack(packed, back);
+    if (memcmp(frame, back, sizeof(frame)) != 0)
+      wrong++;
+    for (uint8_t i = 0; i < 64; i++)
+    {
+      if (GridEYEPacked::getPixel(packed, i) != frame[i])
+        wrongPixel++;
+    }
+
+    int16_t padded[GRIDEYE_PADDED_SIZE], expected[GRIDEYE_PADDED_SIZE];
+    memset(padded, 0x55, sizeof(padded));
+    GridEYEPacked::unpackPadded(packed, padded);
+    GridEYEFilter::pad(frame, expected);
+    if (memcmp(padded, expected, sizeof(padded)) != 0)
+      wrongPadded++;
+  }
+  check("12-bit pack and unpack give every frame back", wrong == 0);
+  check("12-bit getPixel() matches on every pixel", wrongPixel == 0);
+  check("12-bit unpackPadded() matches GridEYEFilter::pad()", wrongPadded == 0);
+  check("12-bit nothing clamped within range", wrongClamped == 0);
+
+  // Past 12 bits: calibration or drift can get there
+  uint32_t wrongOver = 0;
+  for (int n = 0; n < CHECK_FRAMES; n++)
+  {
+    int16_t frame[64], back[64];
+    randomFrame(frame, -4000, 4000);
+    uint8_t expected = 0;
+    for (int i = 0; i < 64; i++)
+    {
+      if ((frame[i] < -2048) || (frame[i] > 2047))
+        expected++;
+    }
+    uint8_t packed[GRIDEYE_PACKED_BYTES];
+    uint8_t clamped = GridEYEPacked::pack(frame, packed);
+    GridEYEPacked::unpack(packed, back);
+    for (int i = 0; i < 64; i++)
+    {
+      if (back[i] != std::min<int16_t>(2047, std::max<int16_t>(-2048, frame[i])))
+        wrongOver++;
+    }
+    if (clamped != expected)
+      wrongOver++;
+  }
+  check("12-bit clamps and counts values past 12 bits", wrongOver == 0);
+}
+
+/********************************************************
+ * Delta
+ ********************************************************/
+
+static void checkDelta()
+{
+  std::uniform_int_distribution<int> near(-127, 127);
+  std::uniform_int_distribution<int> far(128, 1500);
+  uint32_t wrongExact = 0;
+  uint32_t wrongClamped = 0;
+  uint32_t wrongPixel = 0;
+  uint32_t wrongPadded = 0;
+  uint32_t wrongEqual = 0;
+  for (int n = 0; n < CHECK_FRAMES; n++)
+  {
+    int16_t baseline[64], frame[64], back[64];
+    randomFrame(baseline, -500, 500);
+    int farCount = n % 65;
+    std::vector<int> order(64);
+    for (int i = 0; i < 64; i++)
+      order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    for (int i = 0; i < 64; i++)
+      frame[i] = baseline[i] + near(rng);
+    for (int k = 0; k < farCount; k++)
+    {
+      int i = order[k];
+      frame[i] = baseline[i] + ((k & 1) ? far(rng) : -far(rng));
+    }
+    if ((n % 11) == 0)
+      frame[order[63]] = baseline[order[63]] - 128; // One past the delta range
+
+    int expectedClamped = 0;
+    int escapes = 0;
+    for (int i = 0; i < 64; i++)
+    {
+      int delta = frame[i] - baseline[i];
+      if ((delta < -127) || (delta > 127))
+      {
+        if (escapes < GRIDEYE_DELTA_ESCAPES)
+          escapes++;
+        else
+          expectedClamped++;
+      }
+    }
+
+    uint8_t packed[GRIDEYE_DELTA_BYTES];
+    memset(packed, 0xAA, sizeof(packed));
+    uint8_t clamped = GridEYEPacked::packDelta(frame, baseline, packed);
+    GridEYEPacked::unpackDelta(packed, baseline, back);
+    if (clamped != expectedClamped)
+      wrongClamped++;
+    if ((expectedClamped == 0) && (memcmp(frame, back, sizeof(frame)) != 0))
+      wrongExact++;
+    if (expectedClamped != 0)
+    {
+      // Clamped pixels land on the near edge of the delta range
+      for (int i = 0; i < 64; i++)
+      {
+        int delta = frame[i] - baseline[i];
+        int got = back[i] - baseline[i];
+        if ((back[i] != frame[i]) && (got != ((delta < 0) ? -127 : 127)))
+          wrongClamped++;
+      }
+    }
+    for (uint8_t i = 0; i < 64; i++)
+    {
+      if (GridEYEPacked::getDeltaPixel(packed, baseline, i) != back[i])
+        wrongPixel++;
+    }
+
+    int16_t padded[GRIDEYE_PADDED_SIZE], expected[GRIDEYE_PADDED_SIZE];
+    GridEYEPacked::unpackDeltaPadded(packed, baseline, padded);
+    GridEYEFilter::pad(back, expected);
+    if (memcmp(padded, expected, sizeof(padded)) != 0)
+      wrongPadded++;
+
+    uint8_t again[GRIDEYE_DELTA_BYTES];
+    memset(again, 0x55, sizeof(again));
+    GridEYEPacked::packDelta(frame, baseline, again);
+    if (memcmp(packed, again, sizeof(packed)) != 0)
+      wrongEqual++;
+  }
+  check("delta exact up to GRIDEYE_DELTA_ESCAPES far pixels", wrongExact == 0);
+  check("delta clamps and counts far pixels past the escapes", wrongClamped == 0);
+  check("delta getDeltaPixel() matches on every pixel", wrongPixel == 0);
+  check("delta unpackDeltaPadded() matches GridEYEFilter::pad()", wrongPadded == 0);
+  check("delta equal frames pack to equal bytes", wrongEqual == 0);
+}
+
+/********************************************************
+ * Ring
+ ********************************************************/
+
+static void checkRing(const int16_t *baseline)
+{
+  uint8_t buffer[MEMORY_BYTES + 7]; // Not a whole number of slots
+  GridEYEFrameRing ring;
+  if (baseline == NULL)
+    ring.begin(buffer, sizeof(buffer));
+  else
+    ring.begin(buffer, sizeof(buffer), baseline);
+  uint16_t slot = (baseline == NULL) ? GRIDEYE_PACKED_BYTES : GRIDEYE_DELTA_BYTES;
+
+  std::vector<std::vector<int16_t>> pushed;
+  uint32_t wrong = 0;
+  uint16_t capacity = ring.getCapacity();
+  if (capacity != sizeof(buffer) / slot)
+    wrong++;
+  int16_t frame[64];
+  if (ring.getFrame(0, frame) || (ring.getSlot(0) != NULL) || (ring.getPixel(0, 0) != 0))
+    wrong++;
+
+  for (int n = 0; n < capacity * 4 + 3; n++)
+  {
+    std::uniform_int_distribution<int> near(-127, 127);
+    for (int i = 0; i < 64; i++)
+      frame[i] = (int16_t)(((baseline == NULL) ? 0 : baseline[i]) + near(rng));
+    frame[n % 64] = (int16_t)(n * 3); // Far from the baseline now and then
+    if (ring.push(frame) != 0)
+      wrong++;
+    pushed.push_back(std::vector<int16_t>(frame, frame + 64));
+
+    uint16_t expectedCount = std::min<uint16_t>(n + 1, capacity);
+    if (ring.getCount() != expectedCount)
+      wrong++;
+    for (uint16_t age = 0; age < ring.getCount(); age++)
+    {
+      const std::vector<int16_t> &want = pushed[pushed.size() - 1 - age];
+      int16_t back[64];
+      if (!ring.getFrame(age, back) || (memcmp(back, want.data(), sizeof(back)) != 0))
+        wrong++;
+      if (ring.getPixel(age, (uint8_t)(age % 64)) != want[age % 64])
+        wrong++;
+    }
+    if (ring.getFrame(ring.getCount(), frame))
+      wrong++;
+  }
+
+  int16_t padded[GRIDEYE_PADDED_SIZE], expected[GRIDEYE_PADDED_SIZE];
+  GridEYEFilter::pad(pushed.back().data(), expected);
+  if (!ring.getFramePadded(0, padded) || (memcmp(padded, expected, sizeof(padded)) != 0))
+    wrong++;
+
+  ring.clear();
+  if ((ring.getCount() != 0) || ring.getFrame(0, frame))
+    wrong++;
+
+  char line[96];
+  snprintf(line, sizeof(line), "%s ring of %u frames keeps the newest in order", (baseline == NULL) ? "12-bit" : "delta",
+           capacity);
+  check(line, wrong == 0);
+}
+
+/********************************************************
+ * Timing
+ ********************************************************/
+
+struct Bench
+{
+  int16_t frame[64];
+  int16_t baseline[64];
+  int16_t out[GRIDEYE_PADDED_SIZE];
+  uint8_t packed[GRIDEYE_PACKED_BYTES];
+  uint8_t delta[GRIDEYE_DELTA_BYTES];
+  uint32_t sink;
+};
+
+typedef void (*Kernel)(Bench *b, int i);
+
+static void runCopy(Bench *b, int)
+{
+  memcpy(b->out, b->frame, sizeof(b->frame));
+  asm volatile("" : : "r"(b->out) : "memory");
+}
+
+static void runPack(Bench *b, int)
+{
+  b->sink += GridEYEPacked::pack(b->frame, b->packed);
+}
+
+static void runUnpack(Bench *b, int)
+{
+  GridEYEPacked::unpack(b->packed, b->out);
+  asm volatile("" : : "r"(b->out) : "memory");
+}
+
+static void runUnpackPadded(Bench *b, int)
+{
+  GridEYEPacked::unpackPadded(b->packed, b->out);
+  asm volatile("" : : "r"(b->out) : "memory");
+}
+
+static void runGetPixel(Bench *b, int i)
+{
+  b->sink += GridEYEPacked::getPixel(b->packed, (uint8_t)(i & 63));
+  asm volatile("" : : "r"(b->packed) : "memory");
+}
+
+static void runPackDelta(Bench *b, int)
+{
+  b->sink += GridEYEPacked::packDelta(b->frame, b->baseline, b->delta);
+}
+
+static void runUnpackDelta(Bench *b, int)
+{
+  GridEYEPacked::unpackDelta(b->delta, b->baseline, b->out);
+  asm volatile("" : : "r"(b->out) : "memory");
+}
+
+static void runUnpackDeltaPadded(Bench *b, int)
+{
+  GridEYEPacked::unpackDeltaPadded(b->delta, b->baseline, b->out);
+  asm volatile("" : : "r"(b->out) : "memory");
+}
+
+static void runGetDeltaPixel(Bench *b, int i)
+{
+  b->sink += GridEYEPacked::getDeltaPixel(b->delta, b->baseline, (uint8_t)(i & 63));
+  asm volatile("" : : "r"(b->delta) : "memory");
+}
+
+static void timeKernel(Kernel kernel, Bench *b, double *ns, double *ticks)
+{
+  *ns = 1e30;
+  *ticks = 1e30;
+  for (int run = 0; run < TIMING_RUNS; run++)
+  {
+    uint64_t start = hostMicros64();
+    uint64_t startCycles = cycles();
+    for (int i = 0; i < TIMING_CALLS; i++)
+      kernel(b, i);
+    uint64_t endCycles = cycles();
+    uint64_t elapsed = hostMicros64() - start;
+    *ns = std::min(*ns, elapsed * 1000.0 / TIMING_CALLS);
+    *ticks = std::min(*ticks, (double)(endCycles - startCycles) / TIMING_CALLS);
+  }
+}
+
+static void runTiming()
+{
+  Bench b;
+  GridEYESimDevice device;
+  sceneFrame(device, b.baseline);
+  for (int n = 0; n < 40; n++)
+    sceneFrame(device, b.frame);
+  for (int i = 0; i < 4; i++)
+    b.frame[i * 9] = b.baseline[i * 9] + 400; // Four escapes
+  b.sink = 0;
+  GridEYEPacked::pack(b.frame, b.packed);
+  GridEYEPacked::packDelta(b.frame, b.baseline, b.delta);
+
+  struct
+  {
+    const char *name;
+    Kernel kernel;
+    const char *unit;
+  } kernels[] = {
+      {"memcpy int16 frame", runCopy, "frame"},
+      {"pack", runPack, "frame"},
+      {"unpack", runUnpack, "frame"},
+      {"unpackPadded", runUnpackPadded, "frame"},
+      {"getPixel", runGetPixel, "pixel"},
+      {"packDelta (4 escapes)", runPackDelta, "frame"},
+      {"unpackDelta", runUnpackDelta, "frame"},
+      {"unpackDeltaPadded", runUnpackDeltaPadded, "frame"},
+      {"getDeltaPixel", runGetDeltaPixel, "pixel"},
+  };
+
+  for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+  {
+    double ns, ticks;
+    timeKernel(kernels[k].kernel, &b, &ns, &ticks);
+    printf("  %-32s %7.1f ns/%s", kernels[k].name, ns, kernels[k].unit);
+    if (HAVE_CYCLES)
+      printf("  %7.0f cycles/%s", ticks, kernels[k].unit);
+    printf("\n");
+  }
+  printf("  (%u)\n", b.sink & 1);
+}
+
+int main()
+{
+  printf("12-bit\n");
+  check12();
+
+  printf("\nDelta\n");
+  checkDelta();
+
+  printf("\nRing\n");
+  checkRing(NULL);
+  int16_t baseline[64];
+  randomFrame(baseline, -300, 300);
+  checkRing(baseline);
+
+  printf("\nFrames in %d bytes\n", MEMORY_BYTES);
+  printf("  %-24s %3d\n", "float", MEMORY_BYTES / 256);
+  printf("  %-24s %3d\n", "int16", MEMORY_BYTES / 128);
+  printf("  %-24s %3d  (+%.0f%%)\n", "12-bit packed", MEMORY_BYTES / GRIDEYE_PACKED_BYTES,
+         100.0 * 128 / GRIDEYE_PACKED_BYTES - 100);
+  printf("  %-24s %3d  (+%.0f%%)\n", "delta", MEMORY_BYTES / GRIDEYE_DELTA_BYTES,
+         100.0 * 128 / GRIDEYE_DELTA_BYTES - 100);
+
+  printf("\nTiming, best of %d\n", TIMING_RUNS);
+  runTiming();
+
+  printf("\n%s\n", failures ? "FAILED" : "all checks passed");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,189 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Host check for GridEYERenderer.
+
+  Usage:
+    render_check [image.ppm] [palette 0-2] [scale]
+
+  Renders frames of the simulated scene at scales 1 to 16 with every
+  palette and checks that:
+    - scale 1 reproduces the stretched frame exactly
+    - upscaled levels are within 2 of a floating point bilinear
+      reference (Q8 positions and 8-bit intermediate rounding)
+    - RGB565 rows are the RGB888 rows truncated to 5/6/5 bits
+    - row output matches per-pixel getLevel()
+  and reports the time per output pixel. If a file name is given,
+  one rendered frame is also written there as a binary PPM to look at.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYESimDevice.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#define CHECK_FRAMES 64
+#define TIMING_FRAMES 2000
+
+static void readFrame(GridEYESimDevice &device, int16_t *frame)
+{
+  uint8_t raw[GRIDEYE_FRAME_BYTES];
+  device.stepScene();
+  device.read(TEMPERATURE_REGISTER_START, raw, sizeof(raw));
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    uint16_t val = (((uint16_t)raw[2 * i + 1]) << 8) | raw[2 * i];
+    frame[i] = (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800;
+  }
+}
+
+// Bilinear level at output pixel (x, y) in floating point
+static double referenceLevel(const uint8_t *levels, int scale, int x, int y)
+{
+  double sx = (x + 0.5) / scale - 0.5;
+  double sy = (y + 0.5) / scale - 0.5;
+  sx = sx < 0 ? 0 : (sx > 7 ? 7 : sx);
+  sy = sy < 0 ? 0 : (sy > 7 ? 7 : sy);
+  int x0 = (int)sx;
+  int y0 = (int)sy;
+  int x1 = x0 < 7 ? x0 + 1 : 7;
+  int y1 = y0 < 7 ? y0 + 1 : 7;
+  double fx = sx - x0;
+  double fy = sy - y0;
+  double top = levels[y0 * 8 + x0] * (1 - fx) + levels[y0 * 8 + x1] * fx;
+  double bottom = levels[y1 * 8 + x0] * (1 - fx) + levels[y1 * 8 + x1] * fx;
+  return top * (1 - fy) + bottom * fy;
+}
+
+static bool writePPM(const char *path, GridEYERenderer &renderer)
+{
+  FILE *file = fopen(path, "wb");
+  if (file == NULL)
+  {
+    perror(path);
+    return false;
+  }
+  uint16_t width = renderer.getWidth();
+  std::vector<uint8_t> row(width * 3);
+  fprintf(file, "P6\n%u %u\n255\n", width, renderer.getHeight());
+  for (uint16_t y = 0; y < renderer.getHeight(); y++)
+  {
+    renderer.renderRow888(y, row.data());
+    fwrite(row.data(), 1, row.size(), file);
+  }
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  GridEYESimDevice device;
+  GridEYERenderer renderer;
+  int16_t frame[64];
+  uint32_t errors = 0;
+  int worst = 0;
+
+  for (int n = 0; n < CHECK_FRAMES; n++)
+  {
+    // Every fourth frame moves the blob a little further
+    for (int skip = 0; skip < 4; skip++)
+      readFrame(device, frame);
+
+    for (uint8_t palette = GRIDEYE_PALETTE_IRONBOW; palette <= GRIDEYE_PALETTE_GRAYSCALE; palette++)
+    {
+      for (uint8_t scale = 1; scale <= 16; scale++)
+      {
+        renderer.setPalette(palette);
+        renderer.setScale(scale);
+        renderer.setAutoRange();
+        renderer.setFrame(frame);
+
+        GridEYEStretch stretch = renderer.getStretch();
+        uint8_t levels[64];
+        for (uint8_t i = 0; i < 64; i++)
+          levels[i] = stretch.apply(frame[i]);
+
+        uint16_t width = renderer.getWidth();
+        std::vector<uint16_t> row565(width);
+        std::vector<uint8_t> row888(width * 3);
+        for (uint16_t y = 0; y < renderer.getHeight(); y++)
+        {
+          renderer.renderRow(y, row565.data());
+          renderer.renderRow888(y, row888.data());
+          for (uint16_t x = 0; x < width; x++)
+          {
+            uint8_t level = renderer.getLevel(x, y);
+            if (scale == 1 && level != levels[y * 8 + x])
+              errors++;
+
+            int error = abs((int)level - (int)(referenceLevel(levels, scale, x, y) + 0.5));
+            if (error > worst)
+              worst = error;
+            if (error > 2)
+              errors++;
+
+            uint8_t rgb[3];
+            renderer.getColor888(level, rgb);
+            if (memcmp(rgb, &row888[x * 3], 3) != 0)
+              errors++;
+            uint16_t expected = ((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3);
+            if (row565[x] != expected)
+              errors++;
+          }
+        }
+      }
+    }
+  }
+
+  // Timing: a 64x64 RGB565 image, one row buffer at a time
+  renderer.setPalette(GRIDEYE_PALETTE_IRONBOW);
+  renderer.setScale(8);
+  uint16_t row[64];
+  volatile uint16_t sink = 0;
+  uint64_t start = hostMicros64();
+  for (int n = 0; n < TIMING_FRAMES; n++)
+  {
+    frame[n & 63] ^= 1;
+    renderer.setFrame(frame);
+    for (uint16_t y = 0; y < 64; y++)
+    {
+      renderer.renderRow(y, row);
+      sink += row[y];
+    }
+  }
+  double elapsed = (double)(hostMicros64() - start);
+
+  printf("checked %d frames x 3 palettes x scales 1-16, worst interpolation error %d, errors %u\n", CHECK_FRAMES, worst,
+         errors);
+  printf("64x64 RGB565: %.1f us/frame, %.2f ns/pixel\n", elapsed / TIMING_FRAMES,
+         elapsed * 1000.0 / (TIMING_FRAMES * 64.0 * 64.0));
+
+  if (argc > 1)
+  {
+    renderer.setPalette((argc > 2) ? (uint8_t)atoi(argv[2]) : GRIDEYE_PALETTE_IRONBOW);
+    renderer.setScale((argc > 3) ? (uint8_t)atoi(argv[3]) : 32);
+    renderer.setAutoRange();
+    readFrame(device, frame);
+    renderer.setFrame(frame);
+    if (!writePPM(argv[1], renderer))
+      return 1;
+    printf("wrote %s\n", argv[1]);
+  }
+
+  return (errors == 0) ? 0 : 1;
+}
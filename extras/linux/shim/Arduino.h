@@ -0,0 +1,42 @@
+/*
+  Minimal stand-in for Arduino.h so the GridEYE library sources build
+  on Linux hosts. Only what the library itself uses is provided.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+
+static inline uint64_t hostMicros64()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static inline unsigned long millis()
+{
+  return (unsigned long)(hostMicros64() / 1000);
+}
+
+static inline unsigned long micros()
+{
+  return (unsigned long)hostMicros64();
+}
+
+static inline void delay(unsigned long ms)
+{
+  struct timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (ms % 1000) * 1000000L;
+  nanosleep(&ts, NULL);
+}
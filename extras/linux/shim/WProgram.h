@@ -0,0 +1,8 @@
+/*
+  The library picks WProgram.h when ARDUINO isn't defined. On a Linux
+  host that is always the case, so forward to the Arduino.h stand-in.
+*/
+
+#pragma once
+
+#include "Arduino.h"
@@ -0,0 +1,22 @@
+/*
+  Stand-in for Wire.h on Linux hosts. There is no TwoWire hardware on
+  a host, so every transaction fails. Use a GridEYEBus backend instead:
+  begin(address, bus) with GridEYELinuxI2CBus or GridEYEMockBus.
+*/
+
+#pragma once
+
+#include "Arduino.h"
+
+class TwoWire
+{
+public:
+  void beginTransmission(uint8_t) {}
+  size_t write(uint8_t) { return 0; }
+  uint8_t endTransmission(bool = true) { return 4; } // 4: other error
+  uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+  int read() { return -1; }
+  int available() { return 0; }
+};
+
+inline TwoWire Wire;
@@ -0,0 +1,239 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Check for GridEYEStartup.
+
+  Usage:
+    startup_check
+
+  Runs the startup sequence against the simulated sensor with its
+  startup timing modelled (no answer for 50ms after power up, output
+  registers zero until the first frame after power up or an initial
+  reset) and checks:
+    - cold start: probe rides out the silent period, reset issued,
+      profile reads back, the first frame returned is the scene
+    - warm start: same profile again with no reset asked for, no
+      register writes; asking for an initial reset still gets one
+    - changed profile, warm start off, flag reset, sleeping sensor and
+      standby profiles all end with the profile in the registers
+    - power up with the default profile takes the warm path but still
+      waits for valid data
+    - a scene and thermistor at exactly 0.00C start normally
+    - no device and a device that isn't a GridEYE are reported
+  and prints the time to first frame of each against the fixed waits
+  a sleep based startup needs.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYEMockBus.h"
+#include "GridEYESimDevice.h"
+
+#include <stdio.h>
+
+// A sleep based startup: 50ms power up, 2ms after the reset, then two
+// frame periods so a frame is sure to have landed
+#define FIXED_WAIT_10FPS_US (50000 + 2000 + 2 * 100000)
+#define FIXED_WAIT_1FPS_US (50000 + 2000 + 2 * 1000000)
+
+static int failures = 0;
+
+static void check(const char *what, bool ok)
+{
+  printf("  %-60s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok)
+    failures++;
+}
+
+static bool profileInRegisters(GridEYESimDevice &device, const GridEYEProfile &profile)
+{
+  uint16_t upper = device.peek(INT_LEVEL_REGISTER_UPPER_LSB) | (device.peek(INT_LEVEL_REGISTER_UPPER_MSB) << 8);
+  uint16_t lower = device.peek(INT_LEVEL_REGISTER_LOWER_LSB) | (device.peek(INT_LEVEL_REGISTER_LOWER_MSB) << 8);
+  uint16_t hyst = device.peek(INT_LEVEL_REGISTER_HYST_LSB) | (device.peek(INT_LEVEL_REGISTER_HYST_MSB) << 8);
+  return (device.peek(POWER_CONTROL_REGISTER) == profile.power) &&
+         (device.peek(FRAMERATE_REGISTER) == (profile.fps10 ? 0 : 1)) &&
+         ((device.peek(INT_CONTROL_REGISTER) & 0x03) == (profile.interruptControl & 0x03)) &&
+         (((device.peek(AVERAGE_REGISTER) & 0x20) != 0) == profile.movingAverage) &&
+         (upper == ((uint16_t)profile.upper & 0x0FFF)) && (lower == ((uint16_t)profile.lower & 0x0FFF)) &&
+         (hyst == ((uint16_t)profile.hysteresis & 0x0FFF));
+}
+
+static void report(const char *name, GridEYEStartup &startup, uint32_t fixedWait)
+{
+  printf("  %-28s probe %7.1f ms, first frame %7.1f ms", name, startup.getProbeTime() / 1000.0,
+         startup.getTimeToFirstFrame() / 1000.0);
+  if (fixedWait)
+    printf(" (fixed waits %6.1f ms)", fixedWait / 1000.0);
+  printf("%s\n", startup.wasWarmStart() ? ", warm" : "");
+}
+
+int main()
+{
+  GridEYESimDevice device;
+  device.modelStartup(true);
+  GridEYEMockBus bus(0, 0, 0);
+  bus.attach(&device);
+
+  GridEYE grideye;
+  grideye.begin(device.address(), bus);
+  GridEYEStartup startup;
+
+  int16_t scene[64];
+  for (uint8_t i = 0; i < 64; i++)
+    scene[i] = 80 + i;
+  device.setPixels(scene);
+
+  GridEYEProfile profile;
+  GridEYEStartup::defaultProfile(&profile);
+  profile.interruptControl = 0x03;
+  profile.upper = 30 * 4;
+  profile.lower = -5 * 4;
+  profile.hysteresis = 2 * 4;
+
+  printf("Startup sequence\n");
+  int16_t frame[64];
+  bool sameFrame;
+
+  // Cold: just powered, initial reset
+  device.powerCycle();
+  uint32_t resets = device.resets();
+  uint8_t result = startup.start(grideye, profile, GRIDEYE_RESET_INITIAL, frame);
+  sameFrame = true;
+  for (uint8_t i = 0; i < 64; i++)
+    sameFrame &= (frame[i] == scene[i]);
+  check("cold start succeeds", result == GRIDEYE_STARTUP_OK);
+  check("probe waited out the 50ms power up", startup.getProbeTime() >= 50000);
+  check("initial reset issued", (device.resets() == resets + 1) && !startup.wasWarmStart());
+  check("profile in the registers", profileInRegisters(device, profile));
+  check("first frame is the scene, not the zeroed registers", sameFrame);
+  check("first frame no sooner than the sensor has one", startup.getTimeToFirstFrame() >= 150000);
+  GridEYEStartup cold = startup;
+
+  // Warm: MCU restarted, sensor kept power and configuration
+  resets = device.resets();
+  uint32_t writes = device.writes();
+  result = startup.start(grideye, profile, GRIDEYE_RESET_NONE, frame);
+  check("warm start succeeds", result == GRIDEYE_STARTUP_OK);
+  check("warm start skips the reset and every write",
+        startup.wasWarmStart() && (device.resets() == resets) && (device.writes() == writes));
+  check("warm start has a frame at once", startup.getTimeToFirstFrame() < 20000);
+  GridEYEStartup warm = startup;
+
+  // Same registers, but the caller asked for a reset
+  resets = device.resets();
+  result = startup.start(grideye, profile, GRIDEYE_RESET_INITIAL, NULL);
+  check("a requested initial reset is issued on a warm sensor",
+        (result == GRIDEYE_STARTUP_OK) && !startup.wasWarmStart() && (device.resets() == resets + 1) &&
+            profileInRegisters(device, profile));
+  check("and waits a frame period for the conversion", startup.getTimeToFirstFrame() >= 100000);
+
+  // Changed profile on a running sensor
+  GridEYEProfile slow = profile;
+  slow.fps10 = false;
+  slow.movingAverage = true;
+  slow.interruptControl = 0x01;
+  slow.upper = 40 * 4;
+  resets = device.resets();
+  result = startup.start(grideye, slow, GRIDEYE_RESET_INITIAL, NULL);
+  check("changed profile resets and applies",
+        (result == GRIDEYE_STARTUP_OK) && !startup.wasWarmStart() && (device.resets() == resets + 1) &&
+            profileInRegisters(device, slow));
+  check("first frame waits for the conversion after the reset", startup.getTimeToFirstFrame() >= 100000);
+  GridEYEStartup changed = startup;
+
+  // Warm start turned off
+  startup.setWarmStart(false);
+  resets = device.resets();
+  result = startup.start(grideye, slow, GRIDEYE_RESET_INITIAL, NULL);
+  check("warm start off always resets",
+        (result == GRIDEYE_STARTUP_OK) && (device.resets() == resets + 1) && profileInRegisters(device, slow));
+  startup.setWarmStart(true);
+
+  // Flag reset leaves the output valid
+  uint8_t flags = 0x0E;
+  grideye.setRegister(STATUS_REGISTER, flags);
+  result = startup.start(grideye, profile, GRIDEYE_RESET_FLAG, NULL);
+  check("flag reset clears status and applies",
+        (result == GRIDEYE_STARTUP_OK) && (device.peek(STATUS_REGISTER) == 0) && profileInRegisters(device, profile));
+  check("flag reset has a frame at once", startup.getTimeToFirstFrame() < 20000);
+  GridEYEStartup flag = startup;
+
+  // Sleeping sensor
+  grideye.sleep();
+  result = startup.start(grideye, profile, GRIDEYE_RESET_INITIAL, NULL);
+  check("sleeping sensor is woken", (result == GRIDEYE_STARTUP_OK) && profileInRegisters(device, profile));
+
+  // Standby profile: verified, no frame wait
+  GridEYEProfile standby = profile;
+  standby.power = GRIDEYE_POWER_STANDBY_10;
+  result = startup.start(grideye, standby, GRIDEYE_RESET_INITIAL, NULL);
+  check("standby profile applied without waiting for a frame",
+        (result == GRIDEYE_STARTUP_OK) && profileInRegisters(device, standby) && (startup.getTimeToFirstFrame() == 0));
+
+  // Power up with the default profile: registers match, data doesn't exist yet
+  GridEYEProfile defaults;
+  GridEYEStartup::defaultProfile(&defaults);
+  device.powerCycle();
+  resets = device.resets();
+  result = startup.start(grideye, defaults, GRIDEYE_RESET_NONE, frame);
+  sameFrame = true;
+  for (uint8_t i = 0; i < 64; i++)
+    sameFrame &= (frame[i] == scene[i]);
+  check("default profile after power up takes the warm path",
+        (result == GRIDEYE_STARTUP_OK) && startup.wasWarmStart() && (device.resets() == resets));
+  check("and still waits for valid data", sameFrame && (startup.getTimeToFirstFrame() >= 150000));
+  GridEYEStartup powerUp = startup;
+
+  // A scene at exactly 0.00C: ice water in front, a freezing room
+  int16_t zero[64] = {0};
+  device.setPixels(zero);
+  device.setThermistor(0);
+  device.powerCycle();
+  frame[0] = 1;
+  uint64_t began = hostMicros64();
+  result = startup.start(grideye, profile, GRIDEYE_RESET_INITIAL, frame);
+  uint64_t took = hostMicros64() - began;
+  check("0.00C scene starts within a frame of power up",
+        (result == GRIDEYE_STARTUP_OK) && (frame[0] == 0) && (took < 400000));
+  device.setPixels(scene);
+  device.setThermistor(25 * 16);
+
+  // Nothing at the address
+  GridEYE missing;
+  missing.begin(device.address() ^ 0x01, bus);
+  startup.setTimeout(50);
+  began = hostMicros64();
+  result = startup.start(missing, profile, GRIDEYE_RESET_INITIAL, NULL);
+  took = hostMicros64() - began;
+  check("missing device reported after the timeout",
+        (result == GRIDEYE_STARTUP_NO_DEVICE) && (took >= 50000) && (took < 500000));
+
+  // Something answers with values a GridEYE can't hold
+  uint8_t junk = 0x55;
+  grideye.setRegister(FRAMERATE_REGISTER, junk);
+  result = startup.start(grideye, profile, GRIDEYE_RESET_INITIAL, NULL);
+  check("other device reported", result == GRIDEYE_STARTUP_NOT_GRIDEYE);
+  startup.setTimeout(GRIDEYE_STARTUP_TIMEOUT_MS);
+
+  printf("\nTime to first frame\n");
+  report("cold, initial reset", cold, FIXED_WAIT_10FPS_US);
+  report("warm", warm, FIXED_WAIT_10FPS_US);
+  report("new profile at 1FPS", changed, FIXED_WAIT_1FPS_US);
+  report("flag reset", flag, FIXED_WAIT_10FPS_US);
+  report("power up, default profile", powerUp, FIXED_WAIT_10FPS_US);
+
+  printf("\n%s\n", failures ? "FAILED" : "all checks passed");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,353 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Synthetic blob checks for GridEYETracker.
+
+  Usage:
+    tracker_check
+
+  Frames are rendered on the host the same way as bench_motion (warm
+  Gaussian blobs on a 22C background, sub-sampled, with sensor noise)
+  and served by the simulated sensor on the mock bus, so the tracker
+  runs through the real getFrameRaw() and getRegionRaw() reads:
+    - persistence: a blob walking across the frame stays locked on
+      every update, the target box and hottest pixel follow it, and
+      only the scheduled refreshes read the full frame
+    - match gate: a blob under the threshold is never taken, one well
+      over it is, and a blob that jumps out of the region is not
+      matched from the region read but found again at the next full
+      frame
+    - expiry: once the blob leaves, the target is dropped after one
+      region read, the next update is a full frame, and noise alone
+      never brings a target back
+    - refresh: with an interval of N, exactly 3 full frames in 3N
+      updates, N apart, and a refresh picks up a hotter blob outside
+      the region
+  Each line fails on its own; the program returns 1 if any did.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+#include "GridEYEMockBus.h"
+#include "GridEYESimDevice.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <random>
+
+#define NOISE_LSB 0.6
+#define BACKGROUND_LSB 88 // 22C
+#define WALK_UPDATES 40
+#define EMPTY_UPDATES 200
+
+static std::mt19937 rng(31);
+static std::normal_distribution<double> noise(0.0, NOISE_LSB);
+static uint32_t failures = 0;
+
+struct Blob
+{
+  double x, y;     // Center, pixels
+  double sigma;    // Pixels
+  double strength; // LSB above background
+};
+
+static void render(const Blob *blobs, int count, int16_t *frame)
+{
+  for (int py = 0; py < 8; py++)
+  {
+    for (int px = 0; px < 8; px++)
+    {
+      double sum = 0;
+      for (int sy = 0; sy < 4; sy++)
+      {
+        for (int sx = 0; sx < 4; sx++)
+        {
+          double x = px + (sx + 0.5) / 4 - 0.5;
+          double y = py + (sy + 0.5) / 4 - 0.5;
+          for (int b = 0; b < count; b++)
+          {
+            double dx = x - blobs[b].x;
+            double dy = y - blobs[b].y;
+            sum += blobs[b].strength * exp(-(dx * dx + dy * dy) / (2 * blobs[b].sigma * blobs[b].sigma));
+          }
+        }
+      }
+      frame[py * 8 + px] = (int16_t)lround(BACKGROUND_LSB + sum / 16 + noise(rng));
+    }
+  }
+}
+
+static void check(const char *what, bool ok)
+{
+  printf("  %-60s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok)
+    failures++;
+}
+
+static bool boxContains(const GridEYERegion &box, double x, double y)
+{
+  return (x > box.x - 0.5) && (x < box.x + box.width - 0.5) && (y > box.y - 0.5) && (y < box.y + box.height - 0.5);
+}
+
+static double hottestDistance(GridEYETracker &tracker, double x, double y)
+{
+  uint8_t pixel = tracker.getHottestPixel();
+  return hypot((pixel % 8) - x, (pixel / 8) - y);
+}
+
+// One sensor on a zero latency mock bus, scenes set directly
+struct Rig
+{
+  GridEYESimDevice device;
+  GridEYEMockBus bus;
+  GridEYE grideye;
+  int16_t frame[64];
+
+  Rig() : bus(0, 0, 0)
+  {
+    bus.attach(&device);
+    grideye.begin(device.address(), bus);
+    memset(frame, 0, sizeof(frame));
+  }
+
+  bool show(GridEYETracker &tracker, const Blob *blobs, int count)
+  {
+    int16_t scene[64];
+    render(blobs, count, scene);
+    device.setPixels(scene);
+    return tracker.update(grideye, frame);
+  }
+};
+
+/********************************************************
+ * Persistence
+ ********************************************************
+ *
+ * The blob walks diagonally at half a pixel per update and
+ * back, so the region has to widen and shift with it. The
+ * tracker has one target; persistence means it is never
+ * dropped and re-found, which would show up as an extra
+ * full frame outside the refresh schedule.
+ *
+ ********************************************************/
+
+static void runPersistence()
+{
+  Rig rig;
+  GridEYETracker tracker;
+
+  uint32_t locked = 0;
+  uint32_t inBox = 0;
+  uint32_t near = 0;
+  uint32_t unscheduled = 0;
+  uint32_t regionReads = 0;
+  uint32_t bytesBefore = 0;
+
+  for (int n = 0; n < WALK_UPDATES; n++)
+  {
+    int leg = n % 20;
+    double t = (leg < 10) ? leg : 20 - leg;
+    Blob blob = {1.5 + t * 0.5, 1.5 + t * 0.4, 0.9, 40};
+
+    bytesBefore = rig.device.bytesRead();
+    if (!rig.show(tracker, &blob, 1))
+      break;
+
+    if (n == 0)
+      continue; // Acquisition frame
+    if (tracker.hasTarget())
+      locked++;
+    GridEYERegion box;
+    tracker.getTarget(&box);
+    if (boxContains(box, blob.x, blob.y))
+      inBox++;
+    if (hottestDistance(tracker, blob.x, blob.y) <= 1.0)
+      near++;
+    if (tracker.wasFullFrame())
+    {
+      if (n % GRIDEYE_TRACKER_DEFAULT_REFRESH != 0)
+        unscheduled++;
+    }
+    else
+    {
+      regionReads++;
+      if (rig.device.bytesRead() - bytesBefore >= GRIDEYE_FRAME_BYTES)
+        unscheduled++; // A region read as big as the frame tracks nothing
+    }
+  }
+
+  uint32_t updates = WALK_UPDATES - 1;
+  char line[96];
+  snprintf(line, sizeof(line), "walking blob stays locked %u/%u", locked, updates);
+  check(line, locked == updates);
+  snprintf(line, sizeof(line), "target box holds the blob center %u/%u", inBox, updates);
+  check(line, inBox == updates);
+  snprintf(line, sizeof(line), "hottest pixel within 1 px of the center %u/%u", near, updates);
+  check(line, near == updates);
+  snprintf(line, sizeof(line), "region reads %u, unscheduled full or whole-frame reads %u", regionReads, unscheduled);
+  check(line, (unscheduled == 0) && (regionReads > 0));
+}
+
+/********************************************************
+ * Match gate
+ ********************************************************/
+
+static void runGate()
+{
+  char line[96];
+
+  // The threshold is over the frame mean, which the blob itself raises a little
+  uint32_t faintTaken = 0;
+  uint32_t strongMissed = 0;
+  for (int n = 0; n < 50; n++)
+  {
+    Rig rig;
+    GridEYETracker tracker;
+    Blob faint = {3.5, 3.5, 0.6, GRIDEYE_TRACKER_DEFAULT_THRESHOLD * 0.5};
+    rig.show(tracker, &faint, 1);
+    if (tracker.hasTarget())
+      faintTaken++;
+
+    Blob strong = {3.5, 3.5, 0.6, GRIDEYE_TRACKER_DEFAULT_THRESHOLD * 3};
+    rig.show(tracker, &strong, 1);
+    if (!tracker.hasTarget())
+      strongMissed++;
+  }
+  snprintf(line, sizeof(line), "blob under the threshold taken %u/50, over it missed %u/50", faintTaken, strongMissed);
+  check(line, (faintTaken == 0) && (strongMissed == 0));
+
+  // Lock on in one corner, then jump to the other, outside the region
+  Rig rig;
+  GridEYETracker tracker;
+  Blob blob = {1.0, 1.0, 0.8, 40};
+  rig.show(tracker, &blob, 1);
+  rig.show(tracker, &blob, 1);
+  GridEYERegion region;
+  tracker.getRegion(&region);
+  bool wasRegion = !tracker.wasFullFrame() && tracker.hasTarget();
+
+  Blob jumped = {6.0, 6.0, 0.8, 40};
+  bool outside = !boxContains(region, jumped.x, jumped.y);
+  rig.show(tracker, &jumped, 1);
+  bool notMatched = !tracker.wasFullFrame() && !tracker.hasTarget();
+  rig.show(tracker, &jumped, 1);
+  bool refound = tracker.wasFullFrame() && tracker.hasTarget() && (hottestDistance(tracker, jumped.x, jumped.y) <= 1.0);
+
+  check("jump out of the region is not matched from the region read", wasRegion && outside && notMatched);
+  check("jumped blob found again at the next full frame", refound);
+}
+
+/********************************************************
+ * Expiry
+ ********************************************************/
+
+static void runExpiry()
+{
+  Rig rig;
+  GridEYETracker tracker;
+  Blob blob = {4.0, 3.0, 0.8, 40};
+  for (int n = 0; n < 3; n++)
+    rig.show(tracker, &blob, 1);
+  bool tracking = tracker.hasTarget() && !tracker.wasFullFrame();
+
+  rig.show(tracker, NULL, 0);
+  bool dropped = !tracker.wasFullFrame() && !tracker.hasTarget();
+  rig.show(tracker, NULL, 0);
+  bool fullNext = tracker.wasFullFrame() && !tracker.hasTarget();
+
+  uint32_t ghosts = 0;
+  uint32_t regionReads = 0;
+  for (int n = 0; n < EMPTY_UPDATES; n++)
+  {
+    rig.show(tracker, NULL, 0);
+    if (tracker.hasTarget())
+      ghosts++;
+    if (!tracker.wasFullFrame())
+      regionReads++;
+  }
+
+  char line[96];
+  check("blob gone: target dropped after one region read", tracking && dropped);
+  check("update after the drop reads the full frame", fullNext);
+  snprintf(line, sizeof(line), "empty scene with noise: targets %u, region reads %u of %d", ghosts, regionReads,
+           EMPTY_UPDATES);
+  check(line, (ghosts == 0) && (regionReads == 0));
+}
+
+/********************************************************
+ * Refresh
+ ********************************************************/
+
+static void runRefresh()
+{
+  const uint8_t interval = 3;
+  Rig rig;
+  GridEYETracker tracker;
+  tracker.setRefreshInterval(interval);
+
+  Blob blobs[2] = {{1.5, 1.5, 0.8, 30}, {6.0, 6.0, 0.8, 60}};
+  uint32_t fullAt[3 * interval];
+  uint32_t fulls = 0;
+  for (int n = 0; n < 3 * interval; n++)
+  {
+    rig.show(tracker, blobs, 1);
+    if (tracker.wasFullFrame())
+      fullAt[fulls++] = n;
+  }
+  bool spaced = (fulls == 3);
+  for (uint32_t i = 0; i < fulls; i++)
+  {
+    if (fullAt[i] != i * interval)
+      spaced = false;
+  }
+
+  // One more refresh, so the next full frame is the last of the loop below
+  rig.show(tracker, blobs, 1);
+  spaced = spaced && tracker.wasFullFrame();
+
+  // A hotter blob appears away from the target: the region reads keep the old
+  // one, the next refresh takes the whole frame and the hottest moves over
+  bool keptOld = true;
+  bool switched = false;
+  for (int n = 0; n < interval; n++)
+  {
+    rig.show(tracker, blobs, 2);
+    if (!tracker.wasFullFrame() && (hottestDistance(tracker, blobs[0].x, blobs[0].y) > 1.0))
+      keptOld = false;
+    if (tracker.wasFullFrame())
+      switched = hottestDistance(tracker, blobs[1].x, blobs[1].y) <= 1.0;
+  }
+
+  char line[96];
+  snprintf(line, sizeof(line), "refresh interval %u: %u full frames in %u updates, %u apart", interval, fulls,
+           3 * interval, interval);
+  check(line, spaced);
+  check("hotter blob outside the region picked up at the refresh", keptOld && switched);
+}
+
+int main()
+{
+  printf("Persistence, blob walking %d updates\n", WALK_UPDATES);
+  runPersistence();
+  printf("Match gate\n");
+  runGate();
+  printf("Expiry\n");
+  runExpiry();
+  printf("Refresh\n");
+  runRefresh();
+
+  printf("%s\n", failures ? "FAILED" : "all checks passed");
+  return failures ? 1 : 0;
+}
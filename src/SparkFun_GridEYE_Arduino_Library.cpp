@@ -29,12 +29,30 @@
 
 #include "SparkFun_GridEYE_Arduino_Library.h"
 
+GridEYE::GridEYE()
+{
+  _bus = &_wireBus;
+  _deviceAddress = DEFAULT_ADDRESS;
+  _frameTransfer.status = GRIDEYE_TRANSFER_IDLE;
+  _frameBuffer = NULL;
+  _frameDrift = 0;
+  _calibration = NULL;
+  _thermistor = NULL;
+}
+
 // Attempt communication with the device
 // Return true if we got a 'Polo' back from Marco
 void GridEYE::begin(uint8_t deviceAddress, TwoWire &wirePort)
 {
   _deviceAddress = deviceAddress;
-  _i2cPort = &wirePort;
+  _wireBus.begin(wirePort);
+  _bus = &_wireBus;
+}
+
+void GridEYE::begin(uint8_t deviceAddress, GridEYEBus &bus)
+{
+  _deviceAddress = deviceAddress;
+  _bus = &bus;
 }
 
 // Change the address we read and write to
@@ -67,6 +85,9 @@ float GridEYE::getPixelTemperature(unsigned char pixelAddr)
   if (!getRegister16(pixelLowRegister, &temperature))
     return -99.0; // Indicate a read error
 
+  if (_calibration != NULL)
+    return (_calibration->correct(pixelAddr, (int16_t)convertSigned12ToFloat(temperature)) * 0.25);
+
   return (convertSigned12ToFloat(temperature) * 0.25); // Convert to Degrees C. LSB resolution is 0.25C.
 }
 
@@ -105,9 +126,224 @@ int16_t GridEYE::getPixelTemperatureSigned(unsigned char pixelAddr)
   else
     temperature &= 0x07FF; // Clear the unused bits - just in case
 
+  if (_calibration != NULL)
+    return _calibration->correct(pixelAddr, convertUnsignedSigned16(temperature));
+
   return convertUnsignedSigned16(temperature); // Convert to int16_t without ambiguity
 }
 
+/********************************************************
+ * Functions for retreiving the whole frame in one
+ * burst read.
+ ********************************************************
+ *
+ * getFrameRaw() - fills int16_t[64] with signed pixel
+ *    values, 0.25C per LSB. Calibration, if attached, is
+ *    applied while each pixel is decoded.
+ *
+ * getFrame() - fills float[64] with Celsius
+ *
+ * setCalibration() - attach per-pixel correction tables.
+ *    Pass NULL to get uncorrected values again.
+ *
+ * attachThermistor() - attach a thermistor service. It is
+ *    polled on its own schedule from getFrameRaw() and its
+ *    drift correction is added while decoding.
+ *
+ ********************************************************/
+
+bool GridEYE::getFrameRaw(int16_t *frame)
+{
+  if (!requestFrame(frame))
+    return false;
+
+  while (frameReadBusy())
+    _bus->service();
+
+  return frameAvailable();
+}
+
+bool GridEYE::getFrame(float *frame)
+{
+  int16_t raw[GRIDEYE_PIXELS];
+  if (!getFrameRaw(raw))
+    return false;
+
+  for (uint8_t i = 0; i < GRIDEYE_PIXELS; i++)
+    frame[i] = raw[i] * 0.25; // Convert to Degrees C. LSB resolution is 0.25C.
+
+  return true;
+}
+
+/********************************************************
+ * Non-blocking frame read
+ ********************************************************
+ *
+ * requestFrame() - queue a burst read of all 64 pixels
+ *    into frame. Returns false if a read is already in
+ *    flight or the bus won't take it. frame must stay
+ *    valid until frameAvailable() returns true or
+ *    frameReadBusy() returns false.
+ *
+ * frameAvailable() - returns true once, when the read has
+ *    landed and been decoded
+ *
+ * frameReadBusy() - returns true while a read is in flight
+ *
+ * getFrameRaw() is built from these, so the blocking and
+ * non-blocking paths decode identically.
+ *
+ ********************************************************/
+
+bool GridEYE::requestFrame(int16_t *frame)
+{
+  if (frameReadBusy())
+    return false;
+
+  // Thermistor service runs before the burst, in its own transfer
+  _frameDrift = pollDrift();
+
+  // The 128 register bytes land in the caller's buffer and are
+  // decoded in place once the transfer completes
+  _frameBuffer = frame;
+  _frameTransfer.address = _deviceAddress;
+  _frameTransfer.reg = TEMPERATURE_REGISTER_START;
+  _frameTransfer.writeData = NULL;
+  _frameTransfer.writeLength = 0;
+  _frameTransfer.readData = (uint8_t *)frame;
+  _frameTransfer.readLength = GRIDEYE_FRAME_BYTES;
+  _frameTransfer.onComplete = NULL;
+  _frameTransfer.context = this;
+  _frameTransfer.status = GRIDEYE_TRANSFER_PENDING;
+
+  if (!_bus->submit(&_frameTransfer))
+  {
+    _frameTransfer.status = GRIDEYE_TRANSFER_IDLE;
+    return false;
+  }
+
+  return true;
+}
+
+bool GridEYE::frameAvailable()
+{
+  _bus->service();
+
+  uint8_t status = _frameTransfer.status;
+  if (status == GRIDEYE_TRANSFER_DONE)
+  {
+    _frameTransfer.status = GRIDEYE_TRANSFER_IDLE;
+    decodeFrame(_frameBuffer, _frameDrift);
+    return true;
+  }
+  if (status == GRIDEYE_TRANSFER_ERROR)
+    _frameTransfer.status = GRIDEYE_TRANSFER_IDLE; // Caller can request again
+
+  return false;
+}
+
+bool GridEYE::frameReadBusy()
+{
+  return (_frameTransfer.status == GRIDEYE_TRANSFER_PENDING);
+}
+
+// Let the thermistor service sample if it's due and return the drift for this read
+int16_t GridEYE::pollDrift()
+{
+  if (_thermistor == NULL)
+    return 0;
+
+  uint32_t now = millis();
+  _thermistor->poll(*this, now);
+  return _thermistor->getDriftCorrection(now);
+}
+
+/********************************************************
+ * Region of interest read
+ ********************************************************
+ *
+ * getRegionRaw() - reads from the first to the last pixel
+ *    of the region in one burst (rows in between are part
+ *    of the span since the registers are row major) and
+ *    decodes only the pixels inside the region, with the
+ *    same calibration and drift correction as full frames.
+ *    A 2x2 region in the middle costs 20 bytes on the
+ *    wire instead of 128.
+ *
+ ********************************************************/
+
+bool GridEYE::getRegionRaw(GridEYERegion region, int16_t *out)
+{
+  if ((region.width == 0) || (region.height == 0) || (region.x + region.width > 8) || (region.y + region.height > 8))
+    return false;
+
+  int16_t drift = pollDrift();
+
+  uint8_t first = region.y * 8 + region.x;
+  uint8_t last = (region.y + region.height - 1) * 8 + region.x + region.width - 1;
+  uint8_t bytes[GRIDEYE_FRAME_BYTES];
+
+  if (!readRegisters(TEMPERATURE_REGISTER_START + 2 * first, bytes, 2 * (last - first + 1)))
+    return false;
+
+  for (uint8_t row = 0; row < region.height; row++)
+  {
+    uint8_t pixel = first + row * 8;
+    const uint8_t *src = &bytes[2 * row * 8];
+    for (uint8_t col = 0; col < region.width; col++, pixel++, src += 2)
+    {
+      uint16_t val = (((uint16_t)src[1]) << 8) | src[0];
+      int16_t value = (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800; // Sign extend 12-bit two's complement
+      if (_calibration != NULL)
+        value = _calibration->correct(pixel, value);
+      *out++ = value + drift;
+    }
+  }
+
+  return true;
+}
+
+// Pixel i only ever reads bytes 2i and 2i+1, so this works in place
+void GridEYE::decodeFrame(int16_t *frame, int16_t drift)
+{
+  decodeRaw((uint8_t *)frame, frame, _calibration, drift);
+}
+
+void GridEYE::decodeRaw(const uint8_t *raw, int16_t *frame, GridEYECalibration *calibration, int16_t drift)
+{
+  if (calibration == NULL)
+  {
+    for (uint8_t i = 0; i < GRIDEYE_PIXELS; i++)
+    {
+      uint16_t val = (((uint16_t)raw[2 * i + 1]) << 8) | raw[2 * i];
+      frame[i] = (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800 + drift; // Sign extend 12-bit two's complement
+    }
+  }
+  else
+  {
+    for (uint8_t i = 0; i < GRIDEYE_PIXELS; i++)
+    {
+      uint16_t val = (((uint16_t)raw[2 * i + 1]) << 8) | raw[2 * i];
+      frame[i] = calibration->correct(i, (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800) + drift;
+    }
+  }
+}
+
+void GridEYE::setCalibration(GridEYECalibration *calibration)
+{
+  _calibration = calibration;
+}
+
+GridEYECalibration *GridEYE::getCalibration()
+{
+  return _calibration;
+}
+
+void GridEYE::attachThermistor(GridEYEThermistor *thermistor)
+{
+  _thermistor = thermistor;
+}
+
 /********************************************************
  * Functions for retreiving the temperature of
  * the device according to the embedded thermistor.
@@ -760,54 +996,64 @@ int16_t GridEYE::getInterruptHysteresisSigned()
  *
  * getRegister() - get up to INT16 value from unsigned char register
  *
+ * getRegisterBlock() - burst read len bytes starting at register
+ *
+ * All of these are a single transfer on the attached bus.
+ *
  ********************************************************/
 
 bool GridEYE::setRegister(unsigned char reg, unsigned char val)
 {
+  GridEYETransfer transfer;
+  transfer.address = _deviceAddress;
+  transfer.reg = reg;
+  transfer.writeData = &val;
+  transfer.writeLength = 1;
+  transfer.readData = NULL;
+  transfer.readLength = 0;
+  transfer.onComplete = NULL;
+  transfer.context = NULL;
 
-  _i2cPort->beginTransmission(_deviceAddress);
-  _i2cPort->write(reg);
-  _i2cPort->write(val);
-  return (_i2cPort->endTransmission() == 0);
+  return _bus->transfer(&transfer);
 }
 
 bool GridEYE::getRegister8(unsigned char reg, uint8_t *val)
 {
-
-  _i2cPort->beginTransmission(_deviceAddress);
-  _i2cPort->write(reg);
-  if (_i2cPort->endTransmission(false) != 0) // 'false' for a repeated start
-    return false;
-
-  bool result = _i2cPort->requestFrom(_deviceAddress, (uint8_t)1) == 1; // Request 1 byte
-
-  if (result)
-    *val = _i2cPort->read();
-
-  return result;
+  return readRegisters(reg, val, 1);
 }
 
 bool GridEYE::getRegister16(unsigned char reg, uint16_t *val)
 {
+  uint8_t bytes[2];
 
-  _i2cPort->beginTransmission(_deviceAddress);
-  _i2cPort->write(reg);
-  if (_i2cPort->endTransmission(false) != 0) // 'false' for a repeated start
+  if (!readRegisters(reg, bytes, 2))
     return false;
 
-  bool result = _i2cPort->requestFrom(_deviceAddress, (uint8_t)2) == 2; // Request 2 bytes
+  // Little endian (LSB first). Concat bytes into uint16_t
+  *val = (((uint16_t)bytes[1]) << 8) | bytes[0];
 
-  if (result)
-  {
-    // Get bytes from sensor. Little endian (LSB first)
-    uint8_t lsb = _i2cPort->read();
-    uint8_t msb = _i2cPort->read();
+  return true;
+}
 
-    // concat bytes into uint16_t
-    *val = (((uint16_t)msb) << 8) | lsb;
-  }
+bool GridEYE::getRegisterBlock(unsigned char reg, uint8_t *buf, uint8_t len)
+{
+  return readRegisters(reg, buf, len);
+}
 
-  return result;
+// Write the register address then read len bytes after a repeated start
+bool GridEYE::readRegisters(unsigned char reg, uint8_t *buf, uint8_t len)
+{
+  GridEYETransfer transfer;
+  transfer.address = _deviceAddress;
+  transfer.reg = reg;
+  transfer.writeData = NULL;
+  transfer.writeLength = 0;
+  transfer.readData = buf;
+  transfer.readLength = len;
+  transfer.onComplete = NULL;
+  transfer.context = NULL;
+
+  return _bus->transfer(&transfer);
 }
 
 // Provided for backward compatibility only. Not recommended...
@@ -869,10 +1115,17 @@ float GridEYE::convertSigned12ToFloat(uint16_t val)
 
 uint16_t GridEYE::convertFloatToSigned12(float val)
 {
+  // Saturate to the 12-bit range before converting, so out of range values
+  // don't wrap (or overflow int16_t)
+  if (val > 2047)
+    val = 2047;
+  else if (val < -2048)
+    val = -2048;
+
   int16_t signedVal = round(val);
   uint16_t unsignedVal = convertSignedUnsigned16(signedVal); // Convert without ambiguity
 
-  if (unsignedVal | (1 << 15)) // If the two's complement value is negative
+  if (signedVal < 0) // If the two's complement value is negative
     return ((unsignedVal & 0x0FFF) | (1 << 11)); // Limit to 12-bits
   else
     return(unsignedVal & 0x07FF);
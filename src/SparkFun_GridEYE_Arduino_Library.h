@@ -65,6 +65,11 @@
 // The catch-all default is 32
 #define I2C_BUFFER_LENGTH 32
 
+#endif
+
+// Platforms above that don't report a buffer size get the safe default for burst reads
+#ifndef I2C_BUFFER_LENGTH
+#define I2C_BUFFER_LENGTH 32
 #endif
 //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
@@ -88,19 +93,72 @@
 #define RESERVED_AVERAGE_REGISTER 0x1F
 #define TEMPERATURE_REGISTER_START 0x80
 
+// Frame geometry
+#define GRIDEYE_PIXELS 64
+#define GRIDEYE_FRAME_BYTES 128
+
+#include "SparkFun_GridEYE_Bus.h"
+#include "SparkFun_GridEYE_Calibration.h"
+#include "SparkFun_GridEYE_Thermistor.h"
+#include "SparkFun_GridEYE_Changes.h"
+#include "SparkFun_GridEYE_Histogram.h"
+#include "SparkFun_GridEYE_Render.h"
+#include "SparkFun_GridEYE_Inference.h"
+#include "SparkFun_GridEYE_Filters.h"
+#include "SparkFun_GridEYE_Zones.h"
+#include "SparkFun_GridEYE_Startup.h"
+#include "SparkFun_GridEYE_Motion.h"
+#include "SparkFun_GridEYE_Packed.h"
+
+// A rectangle of pixels. x is the column, y the row, both 0-7.
+struct GridEYERegion
+{
+  uint8_t x;
+  uint8_t y;
+  uint8_t width;
+  uint8_t height;
+};
+
+#include "SparkFun_GridEYE_Tracker.h"
+
 class GridEYE
 {
 public:
+  GridEYE();
+
   // Return values
 
   // By default use the default I2C addres, and use Wire port
   void begin(uint8_t deviceAddress = DEFAULT_ADDRESS, TwoWire &wirePort = Wire);
+  // Or talk through any other bus backend (DMA, interrupt driven, Linux i2c-dev...)
+  void begin(uint8_t deviceAddress, GridEYEBus &bus);
 
   float getPixelTemperature(unsigned char pixelAddr);
   int16_t getPixelTemperatureRaw(unsigned char pixelAddr); // The return value is somewhat ambiguous. Use getPixelTemperatureSigned for a better experience...
   int16_t getPixelTemperatureSigned(unsigned char pixelAddr);
   float getPixelTemperatureFahrenheit(unsigned char pixelAddr);
 
+  bool getFrameRaw(int16_t *frame); // Reads all 64 pixels in one burst. Signed values, 0.25C per LSB
+  bool getFrame(float *frame);      // Same as getFrameRaw but in float Celsius
+
+  // Non-blocking frame read. requestFrame() queues the burst read into frame and
+  // returns right away; frameAvailable() returns true once it has landed and been decoded.
+  bool requestFrame(int16_t *frame);
+  bool frameAvailable();
+  bool frameReadBusy();
+
+  // Reads only the register span covering region in one burst and decodes just
+  // the pixels inside it. out holds width * height values, row by row.
+  bool getRegionRaw(GridEYERegion region, int16_t *out);
+
+  // Decodes a GRIDEYE_FRAME_BYTES register burst read some other way (a recording,
+  // another thread) into 64 signed values. raw and frame may be the same buffer.
+  static void decodeRaw(const uint8_t *raw, int16_t *frame, GridEYECalibration *calibration = NULL, int16_t drift = 0);
+
+  void setCalibration(GridEYECalibration *calibration); // Pass NULL to return uncorrected values
+  GridEYECalibration *getCalibration();
+  void attachThermistor(GridEYEThermistor *thermistor); // Polled and drift corrected from getFrameRaw. NULL to detach.
+
   float getDeviceTemperature();
   int16_t getDeviceTemperatureRaw(); // The return value is somewhat ambiguous. Use getDeviceTemperatureSigned for a better experience...
   int16_t getDeviceTemperatureSigned();
@@ -168,6 +226,7 @@ public:
   int16_t getRegister(unsigned char reg, int8_t len); // Provided for backward compatibility only. Not recommended...
   bool getRegister8(unsigned char reg, uint8_t *val);
   bool getRegister16(unsigned char reg, uint16_t *val); // Note: this returns an unsigned val. Use convertUnsignedSigned to convert to int16_t
+  bool getRegisterBlock(unsigned char reg, uint8_t *buf, uint8_t len); // Burst read, split to fit I2C_BUFFER_LENGTH
   int16_t convertUnsignedSigned16(uint16_t val);
   uint16_t convertSignedUnsigned16(int16_t val);
   float convertSigned12ToFloat(uint16_t val);
@@ -176,6 +235,18 @@ public:
   void setI2CAddress(uint8_t addr); // Set the I2C address we read and write to
 
 private:
-  TwoWire *_i2cPort;      // The generic connection to user's chosen I2C hardware
-  uint8_t _deviceAddress; // Keeps track of I2C address. setI2CAddress changes this.
+  GridEYEWireBus _wireBus; // Backend used when begin() is given a TwoWire
+  GridEYEBus *_bus;        // The bus every register access goes through
+  uint8_t _deviceAddress;  // Keeps track of I2C address. setI2CAddress changes this.
+
+  GridEYETransfer _frameTransfer; // In flight burst read for requestFrame()
+  int16_t *_frameBuffer;
+  int16_t _frameDrift;
+
+  bool readRegisters(unsigned char reg, uint8_t *buf, uint8_t len);
+  int16_t pollDrift();
+  void decodeFrame(int16_t *frame, int16_t drift);
+
+  GridEYECalibration *_calibration; // Optional per-pixel correction applied while decoding
+  GridEYEThermistor *_thermistor;   // Optional ambient drift compensation applied while decoding
 };
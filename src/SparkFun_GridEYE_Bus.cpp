@@ -0,0 +1,102 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Bus abstraction for the GridEYE.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+bool GridEYEBus::transfer(GridEYETransfer *transfer)
+{
+  if (!submit(transfer))
+    return false;
+
+  while (transfer->status == GRIDEYE_TRANSFER_PENDING)
+    service();
+
+  return (transfer->status == GRIDEYE_TRANSFER_DONE);
+}
+
+GridEYEWireBus::GridEYEWireBus()
+{
+  _i2cPort = NULL;
+}
+
+void GridEYEWireBus::begin(TwoWire &wirePort)
+{
+  _i2cPort = &wirePort;
+}
+
+/********************************************************
+ * Blocking transfer over TwoWire
+ ********************************************************
+ *
+ * Writes go out as one transaction with a stop. Reads
+ * write the register with a repeated start and are split
+ * into chunks that fit the platform's I2C buffer. The
+ * register address auto-increments so each chunk just
+ * starts where the last one ended.
+ *
+ ********************************************************/
+
+bool GridEYEWireBus::submit(GridEYETransfer *transfer)
+{
+  bool result = (_i2cPort != NULL);
+
+  if (result && (transfer->readLength == 0))
+  {
+    _i2cPort->beginTransmission(transfer->address);
+    _i2cPort->write(transfer->reg);
+    for (uint8_t i = 0; i < transfer->writeLength; i++)
+      _i2cPort->write(transfer->writeData[i]);
+    result = (_i2cPort->endTransmission() == 0);
+  }
+
+  uint8_t reg = transfer->reg;
+  uint8_t *buf = transfer->readData;
+  uint8_t len = transfer->readLength;
+
+  while (result && (len > 0))
+  {
+    uint8_t chunk = (len > I2C_BUFFER_LENGTH) ? I2C_BUFFER_LENGTH : len;
+
+    _i2cPort->beginTransmission(transfer->address);
+    _i2cPort->write(reg);
+    if (_i2cPort->endTransmission(false) != 0) // 'false' for a repeated start
+    {
+      result = false;
+      break;
+    }
+
+    if (_i2cPort->requestFrom(transfer->address, chunk) != chunk)
+    {
+      result = false;
+      break;
+    }
+
+    for (uint8_t i = 0; i < chunk; i++)
+      *buf++ = _i2cPort->read();
+
+    reg += chunk;
+    len -= chunk;
+  }
+
+  transfer->status = result ? GRIDEYE_TRANSFER_DONE : GRIDEYE_TRANSFER_ERROR;
+  if (transfer->onComplete != NULL)
+    transfer->onComplete(transfer);
+
+  return true;
+}
@@ -0,0 +1,86 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Bus abstraction for the GridEYE.
+
+  Every register access the driver makes is one transfer: write
+  the register address (and optionally data), then optionally read
+  bytes back after a repeated start. A bus backend accepts transfers
+  with submit() and marks them complete later, from an interrupt,
+  DMA callback, another thread, or right away for blocking buses.
+
+  GridEYEWireBus is the blocking backend over TwoWire that the
+  driver uses by default. It completes every transfer inside
+  submit(), exactly like the driver always behaved.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Wire.h>
+
+// Transfer status
+#define GRIDEYE_TRANSFER_IDLE 0
+#define GRIDEYE_TRANSFER_PENDING 1
+#define GRIDEYE_TRANSFER_DONE 2
+#define GRIDEYE_TRANSFER_ERROR 3
+
+struct GridEYETransfer
+{
+  uint8_t address;          // 7-bit device address
+  uint8_t reg;              // Register the transfer starts at
+  const uint8_t *writeData; // Bytes written after reg, only used when readLength is 0
+  uint8_t writeLength;
+  uint8_t *readData; // Bytes read after a repeated start, may be NULL
+  uint8_t readLength;
+
+  volatile uint8_t status;
+
+  // Optional, called by the backend once status is DONE or ERROR
+  void (*onComplete)(GridEYETransfer *transfer);
+  void *context;
+};
+
+class GridEYEBus
+{
+public:
+  virtual ~GridEYEBus() {} // Backends can be deleted through a GridEYEBus pointer
+
+  // Queue a transfer. Returns false if the backend can't take it right now.
+  // status is PENDING when this returns true, or already DONE/ERROR for
+  // backends that complete inline.
+  virtual bool submit(GridEYETransfer *transfer) = 0;
+
+  // Give the backend a chance to deliver completions. Backends that
+  // complete from interrupts or inline don't need to do anything here.
+  virtual void service() {}
+
+  // Submit and wait for completion. Returns true if the transfer succeeded.
+  bool transfer(GridEYETransfer *transfer);
+};
+
+class GridEYEWireBus : public GridEYEBus
+{
+public:
+  GridEYEWireBus();
+
+  void begin(TwoWire &wirePort);
+  bool submit(GridEYETransfer *transfer);
+
+private:
+  TwoWire *_i2cPort; // The generic connection to user's chosen I2C hardware
+};
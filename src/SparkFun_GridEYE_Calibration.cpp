@@ -0,0 +1,234 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Per-pixel non-uniformity correction for the GridEYE.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Calibration.h"
+
+// Serialized blob starts with "GC"
+#define CALIBRATION_MAGIC_0 0x47
+#define CALIBRATION_MAGIC_1 0x43
+
+static int8_t clampInt8(int32_t val)
+{
+  if (val > 127)
+    return 127;
+  if (val < -128)
+    return -128;
+  return (int8_t)val;
+}
+
+GridEYECalibration::GridEYECalibration()
+{
+  clear();
+  beginCapture(); // addFrame() without a beginCapture() starts from zero too
+}
+
+void GridEYECalibration::clear()
+{
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    _offset[i] = 0;
+    _gain[i] = 0;
+  }
+  _flags = 0;
+  _reference = 0;
+}
+
+/********************************************************
+ * Functions for capturing flat-field reference frames
+ ********************************************************
+ *
+ * beginCapture() - resets the frame accumulator
+ *
+ * addFrame() - adds one uncorrected frame (from getFrameRaw
+ *    with no calibration attached) to the accumulator
+ *
+ * computeOffsets() - turns the accumulated frames into
+ *    per-pixel offsets relative to the scene mean. Clears
+ *    any gain table since gain is relative to the offsets.
+ *    Fails and leaves the tables alone with no frames.
+ *
+ * computeGains() - turns a second capture of a hotter
+ *    uniform scene into per-pixel gain trims. Offsets must
+ *    already be computed. Fails and leaves the tables alone
+ *    with no frames or a scene not 2C hotter.
+ *
+ ********************************************************/
+
+void GridEYECalibration::beginCapture()
+{
+  for (uint8_t i = 0; i < 64; i++)
+    _accumulator[i] = 0;
+  _capturedFrames = 0;
+}
+
+bool GridEYECalibration::addFrame(const int16_t *rawFrame)
+{
+  if (_capturedFrames >= GRIDEYE_CAL_MAX_CAPTURE_FRAMES)
+    return false;
+
+  for (uint8_t i = 0; i < 64; i++)
+    _accumulator[i] += rawFrame[i];
+  _capturedFrames++;
+
+  return true;
+}
+
+bool GridEYECalibration::computeOffsets()
+{
+  if (_capturedFrames == 0)
+    return false;
+
+  // Scene mean in 1/16C
+  int32_t total = 0;
+  for (uint8_t i = 0; i < 64; i++)
+    total += _accumulator[i];
+  int32_t mean = (total * 4) / (64 * (int32_t)_capturedFrames);
+
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    int32_t pixelMean = ((int32_t)_accumulator[i] * 4) / _capturedFrames;
+    _offset[i] = clampInt8(pixelMean - mean);
+    _gain[i] = 0;
+  }
+
+  _reference = (int16_t)mean;
+  _flags = GRIDEYE_CAL_HAS_OFFSET;
+
+  return true;
+}
+
+bool GridEYECalibration::computeGains()
+{
+  if ((_capturedFrames == 0) || !(_flags & GRIDEYE_CAL_HAS_OFFSET))
+    return false;
+
+  int32_t total = 0;
+  for (uint8_t i = 0; i < 64; i++)
+    total += _accumulator[i];
+  int32_t mean = (total * 4) / (64 * (int32_t)_capturedFrames);
+
+  // The second scene has to be meaningfully hotter than the first (2C)
+  int32_t span = mean - _reference;
+  if (span < 32)
+    return false;
+
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    // Offset corrected pixel response across the two scenes
+    int32_t pixelSpan = ((int32_t)_accumulator[i] * 4) / _capturedFrames - _offset[i] - _reference;
+    if (pixelSpan <= 0)
+    {
+      _gain[i] = 0;
+      continue;
+    }
+    _gain[i] = clampInt8(((span - pixelSpan) * 1024) / pixelSpan);
+  }
+
+  _flags |= GRIDEYE_CAL_HAS_GAIN;
+
+  return true;
+}
+
+uint8_t GridEYECalibration::getCapturedFrames()
+{
+  return _capturedFrames;
+}
+
+int8_t GridEYECalibration::getOffset(uint8_t pixelAddr)
+{
+  return _offset[pixelAddr];
+}
+
+int8_t GridEYECalibration::getGainTrim(uint8_t pixelAddr)
+{
+  return _gain[pixelAddr];
+}
+
+void GridEYECalibration::setOffset(uint8_t pixelAddr, int8_t offset)
+{
+  _offset[pixelAddr] = offset;
+  _flags |= GRIDEYE_CAL_HAS_OFFSET;
+}
+
+void GridEYECalibration::setGainTrim(uint8_t pixelAddr, int8_t trim)
+{
+  _gain[pixelAddr] = trim;
+  _flags |= GRIDEYE_CAL_HAS_GAIN;
+}
+
+uint8_t GridEYECalibration::getFlags()
+{
+  return _flags;
+}
+
+/********************************************************
+ * Functions for storing calibration tables
+ ********************************************************
+ *
+ * serialize() - writes GRIDEYE_CALIBRATION_SIZE bytes
+ *
+ * deserialize() - restores tables from a blob written by
+ *    serialize(). Leaves the current tables untouched if
+ *    the blob is not valid.
+ *
+ ********************************************************/
+
+size_t GridEYECalibration::serialize(uint8_t *buf)
+{
+  buf[0] = CALIBRATION_MAGIC_0;
+  buf[1] = CALIBRATION_MAGIC_1;
+  buf[2] = GRIDEYE_CALIBRATION_VERSION;
+  buf[3] = _flags;
+  buf[4] = (uint16_t)_reference & 0xFF; // Little endian, like the device registers
+  buf[5] = (uint16_t)_reference >> 8;
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    buf[6 + i] = (uint8_t)_offset[i];
+    buf[70 + i] = (uint8_t)_gain[i];
+  }
+
+  uint8_t checksum = 0;
+  for (uint8_t i = 0; i < GRIDEYE_CALIBRATION_SIZE - 1; i++)
+    checksum += buf[i];
+  buf[GRIDEYE_CALIBRATION_SIZE - 1] = ~checksum; // Inverted so an erased (0xFF) EEPROM never validates
+
+  return GRIDEYE_CALIBRATION_SIZE;
+}
+
+bool GridEYECalibration::deserialize(const uint8_t *buf)
+{
+  if ((buf[0] != CALIBRATION_MAGIC_0) || (buf[1] != CALIBRATION_MAGIC_1) || (buf[2] != GRIDEYE_CALIBRATION_VERSION))
+    return false;
+
+  uint8_t checksum = 0;
+  for (uint8_t i = 0; i < GRIDEYE_CALIBRATION_SIZE - 1; i++)
+    checksum += buf[i];
+  if ((uint8_t)~checksum != buf[GRIDEYE_CALIBRATION_SIZE - 1])
+    return false;
+
+  _flags = buf[3];
+  _reference = (int16_t)(((uint16_t)buf[5] << 8) | buf[4]);
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    _offset[i] = (int8_t)buf[6 + i];
+    _gain[i] = (int8_t)buf[70 + i];
+  }
+
+  return true;
+}
@@ -0,0 +1,90 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Per-pixel non-uniformity correction for the GridEYE.
+
+  Each pixel gets an offset (1/16C per LSB, +/-7.9C range) and an
+  optional gain trim (1/1024 per LSB, +/-12.4% range) applied around
+  the temperature of the offset reference scene. Both tables
+  are int8 so a complete calibration is 128 bytes plus a small
+  header, small enough to keep in EEPROM next to other settings.
+
+  Correction is applied by GridEYE while it decodes the frame,
+  so there is no second pass over the pixels.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Serialized calibration layout: magic(2) version(1) flags(1) reference(2) offsets(64) gains(64) checksum(1)
+#define GRIDEYE_CALIBRATION_VERSION 1
+#define GRIDEYE_CALIBRATION_SIZE 135
+
+// Calibration flags
+#define GRIDEYE_CAL_HAS_OFFSET 0x01
+#define GRIDEYE_CAL_HAS_GAIN 0x02
+
+// At most this many frames can be averaged per reference capture (keeps the accumulator int16)
+#define GRIDEYE_CAL_MAX_CAPTURE_FRAMES 16
+
+class GridEYECalibration
+{
+public:
+  GridEYECalibration();
+
+  void clear(); // Back to identity: no offset, unity gain
+
+  // Flat-field capture. Point the sensor at a uniform surface, call
+  // beginCapture(), feed uncorrected frames with addFrame() and then
+  // call computeOffsets(). For gain, repeat with a second, hotter
+  // surface and call computeGains().
+  void beginCapture();
+  bool addFrame(const int16_t *rawFrame); // Returns false once GRIDEYE_CAL_MAX_CAPTURE_FRAMES are in
+  bool computeOffsets();                  // Returns false, tables untouched, if no frames were added
+  bool computeGains();                    // Same, or if the scene isn't 2C over the offset capture
+  uint8_t getCapturedFrames();
+
+  int8_t getOffset(uint8_t pixelAddr); // 1/16C per LSB
+  int8_t getGainTrim(uint8_t pixelAddr); // gain = (1024 + trim) / 1024 around the reference
+  void setOffset(uint8_t pixelAddr, int8_t offset);
+  void setGainTrim(uint8_t pixelAddr, int8_t trim);
+  uint8_t getFlags();
+
+  // Store and restore tables. buf must hold GRIDEYE_CALIBRATION_SIZE bytes.
+  // The blob can go to EEPROM, flash or a file on a host.
+  size_t serialize(uint8_t *buf);
+  bool deserialize(const uint8_t *buf); // Returns false on a bad magic, version or checksum
+
+  // Correct one sign-extended raw value (0.25C per LSB)
+  inline int16_t correct(uint8_t pixelAddr, int16_t raw)
+  {
+    int32_t value = ((int32_t)raw << 2) - _offset[pixelAddr]; // Work in 1/16C
+    if (_flags & GRIDEYE_CAL_HAS_GAIN)
+      value += ((value - _reference) * _gain[pixelAddr]) >> 10;
+    return (int16_t)((value + 2) >> 2); // Back to 0.25C, rounded
+  }
+
+private:
+  int8_t _offset[64];
+  int8_t _gain[64];
+  uint8_t _flags;
+  int16_t _reference; // Scene mean of the offset capture, 1/16C. Gain pivots around it.
+
+  int16_t _accumulator[64]; // Sum of captured frames, raw LSB
+  uint8_t _capturedFrames;
+};
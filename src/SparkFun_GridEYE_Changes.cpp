@@ -0,0 +1,204 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Change events between consecutive GridEYE frames.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Changes.h"
+
+GridEYEChangeDetector::GridEYEChangeDetector()
+{
+  setDeadband((uint8_t)GRIDEYE_CHANGES_DEFAULT_DEADBAND);
+  reset();
+}
+
+void GridEYEChangeDetector::setDeadband(uint8_t raw)
+{
+  for (uint8_t i = 0; i < 64; i++)
+    _deadband[i] = raw;
+}
+
+void GridEYEChangeDetector::setDeadband(uint8_t pixelAddr, uint8_t raw)
+{
+  _deadband[pixelAddr] = raw;
+}
+
+uint8_t GridEYEChangeDetector::getDeadband(uint8_t pixelAddr)
+{
+  return _deadband[pixelAddr];
+}
+
+void GridEYEChangeDetector::reset()
+{
+  for (uint8_t i = 0; i < 64; i++)
+    _reference[i] = 0;
+  for (uint8_t i = 0; i < 8; i++)
+    _rowMask[i] = 0;
+  _eventCount = 0;
+  _primed = false;
+}
+
+/********************************************************
+ * Frame difference
+ ********************************************************
+ *
+ * update() - for every pixel, with d = new - reference,
+ *    |d| > deadband is the one unsigned compare
+ *    (uint16_t)(d + deadband) > 2 * deadband. Values are
+ *    12-bit, so d fits int16. A row is tested as a whole
+ *    first and skipped if nothing in it changed, the
+ *    common case, so a still scene costs eight compares
+ *    and one branch per row. Rows with changes are
+ *    compacted without branches:
+ *
+ *    reference += d & -changed          keep or replace
+ *    event[count] = (i, new)            always written
+ *    count += changed                   kept only if changed
+ *
+ ********************************************************/
+
+uint8_t GridEYEChangeDetector::update(const int16_t *frame)
+{
+  uint8_t count = 0;
+
+  // First frame: every pixel is news
+  if (!_primed)
+  {
+    for (uint8_t i = 0; i < 64; i++)
+    {
+      _reference[i] = frame[i];
+      _eventIndex[i] = i;
+      _eventValue[i] = frame[i];
+    }
+    for (uint8_t row = 0; row < 8; row++)
+      _rowMask[row] = 0xFF;
+    _primed = true;
+    _eventCount = 64;
+    return 64;
+  }
+
+  for (uint8_t row = 0; row < 8; row++)
+  {
+    const int16_t *in = &frame[row * 8];
+    int16_t *ref = &_reference[row * 8];
+    const uint8_t *band = &_deadband[row * 8];
+
+    // Test the whole row without branches, this part vectorizes on hosts
+    uint8_t changed[8];
+    uint8_t any = 0;
+    for (uint8_t x = 0; x < 8; x++)
+    {
+      changed[x] = (uint16_t)(in[x] - ref[x] + band[x]) > (uint16_t)(band[x] << 1);
+      any |= changed[x];
+    }
+    if (!any)
+    {
+      _rowMask[row] = 0;
+      continue;
+    }
+
+    // Compact the row into the events: always write, keep only if changed
+    uint8_t bits = 0;
+    for (uint8_t x = 0; x < 8; x++)
+    {
+      ref[x] += (in[x] - ref[x]) & -(int16_t)changed[x];
+      bits |= changed[x] << x;
+      _eventIndex[count] = row * 8 + x;
+      _eventValue[count] = in[x];
+      count += changed[x];
+    }
+    _rowMask[row] = bits;
+  }
+
+  _eventCount = count;
+  return count;
+}
+
+uint64_t GridEYEChangeDetector::getMask()
+{
+  uint64_t mask = 0;
+  for (uint8_t row = 8; row-- > 0;)
+    mask = (mask << 8) | _rowMask[row];
+  return mask;
+}
+
+uint8_t GridEYEChangeDetector::getEventCount()
+{
+  return _eventCount;
+}
+
+const uint8_t *GridEYEChangeDetector::getEventIndices()
+{
+  return _eventIndex;
+}
+
+const int16_t *GridEYEChangeDetector::getEventValues()
+{
+  return _eventValue;
+}
+
+const int16_t *GridEYEChangeDetector::getReference()
+{
+  return _reference;
+}
+
+/********************************************************
+ * Serial encoding
+ ********************************************************
+ *
+ * encode() - mask then changed values, see the header.
+ *    A still scene costs 8 bytes instead of 128.
+ *
+ * decode() - writes the encoded values into the frame at
+ *    the pixels named by the mask.
+ *
+ ********************************************************/
+
+size_t GridEYEChangeDetector::encode(uint8_t *buf)
+{
+  uint8_t *out = buf;
+  for (uint8_t row = 0; row < 8; row++)
+    *out++ = _rowMask[row];
+
+  for (uint8_t n = 0; n < _eventCount; n++)
+  {
+    uint16_t value = (uint16_t)_eventValue[n];
+    *out++ = value & 0xFF;
+    *out++ = value >> 8;
+  }
+
+  return out - buf;
+}
+
+size_t GridEYEChangeDetector::decode(const uint8_t *buf, int16_t *frame)
+{
+  const uint8_t *in = buf + 8;
+  for (uint8_t row = 0; row < 8; row++)
+  {
+    uint8_t bits = buf[row];
+    while (bits != 0)
+    {
+      uint8_t x = 0;
+      while (!(bits & (1 << x)))
+        x++;
+      bits &= bits - 1; // Clear the lowest set bit
+      frame[row * 8 + x] = (int16_t)(in[0] | (in[1] << 8));
+      in += 2;
+    }
+  }
+
+  return in - buf;
+}
@@ -0,0 +1,83 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Change events between consecutive GridEYE frames.
+
+  Each pixel is compared with the last value it reported. When it has
+  moved by more than that pixel's deadband it is reported as changed
+  and becomes the new reference; otherwise the reference is kept, so
+  slow drift still shows up once it adds up past the deadband.
+
+  An update produces a 64-bit change mask (bit n = pixel n) and a
+  packed list of events, the index and value of each changed pixel in
+  two parallel arrays, so later stages only touch the pixels that
+  changed. Most pixels of a typical scene don't change, so the compare
+  is a single unsigned test per pixel and only changed pixels do any
+  more work.
+
+  RAM use is 128 bytes of reference frame, 64 bytes of deadbands and
+  192 bytes of events (64 indices, 64 values, no padding).
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 0.5C either way counts as no change
+#define GRIDEYE_CHANGES_DEFAULT_DEADBAND 2
+
+// Largest encode() output: 8 mask bytes and 64 two-byte values
+#define GRIDEYE_CHANGES_MAX_ENCODED 136
+
+class GridEYEChangeDetector
+{
+public:
+  GridEYEChangeDetector();
+
+  void setDeadband(uint8_t raw); // All pixels, 0.25C per LSB
+  void setDeadband(uint8_t pixelAddr, uint8_t raw);
+  uint8_t getDeadband(uint8_t pixelAddr);
+
+  void reset(); // The next update reports every pixel
+
+  // Compare a sign-extended frame with the references. Returns the number of changed pixels.
+  uint8_t update(const int16_t *frame);
+
+  uint64_t getMask();
+  uint8_t getEventCount();
+  // Events in pixel order, getEventCount() of each
+  const uint8_t *getEventIndices();
+  const int16_t *getEventValues(); // 0.25C per LSB
+  const int16_t *getReference(); // Last reported value of every pixel
+
+  // Serial encoding of the last update: the mask, 8 bytes little endian, then the
+  // value of each changed pixel, 2 bytes little endian, in pixel order. buf must
+  // hold GRIDEYE_CHANGES_MAX_ENCODED bytes. Returns the number of bytes written.
+  size_t encode(uint8_t *buf);
+
+  // Apply an encoded update to a receiver's copy of the frame. Returns the bytes consumed.
+  static size_t decode(const uint8_t *buf, int16_t *frame);
+
+private:
+  int16_t _reference[64];
+  uint8_t _deadband[64];
+  uint8_t _eventIndex[64];
+  int16_t _eventValue[64];
+  uint8_t _rowMask[8];
+  uint8_t _eventCount;
+  bool _primed;
+};
@@ -0,0 +1,257 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Fixed-point 3x3 spatial filters for GridEYE frames.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "SparkFun_GridEYE_Filters.h"
+
+#define STRIDE GRIDEYE_PADDED_STRIDE
+
+static inline int16_t min16(int16_t a, int16_t b)
+{
+  return (a < b) ? a : b;
+}
+
+static inline int16_t max16(int16_t a, int16_t b)
+{
+  return (a > b) ? a : b;
+}
+
+static inline int16_t median3(int16_t a, int16_t b, int16_t c)
+{
+  return max16(min16(a, b), min16(max16(a, b), c));
+}
+
+GridEYEFilter::GridEYEFilter()
+{
+  _current = 0;
+  memset(_buffers, 0, sizeof(_buffers));
+}
+
+/********************************************************
+ * Padded layout
+ ********************************************************
+ *
+ * pad() - copies a frame into the middle and fills the
+ *    border
+ *
+ * refreshBorder() - repeats the edge pixels into the
+ *    border. Columns first, then the top and bottom rows
+ *    whole, which also fills the corners.
+ *
+ ********************************************************/
+
+void GridEYEFilter::pad(const int16_t *frame, int16_t *padded)
+{
+  for (uint8_t y = 0; y < 8; y++)
+  {
+    int16_t *row = &padded[GRIDEYE_PADDED_INDEX(0, y)];
+    for (uint8_t x = 0; x < 8; x++)
+      row[x] = *frame++;
+  }
+  refreshBorder(padded);
+}
+
+void GridEYEFilter::unpad(const int16_t *padded, int16_t *frame)
+{
+  for (uint8_t y = 0; y < 8; y++)
+  {
+    const int16_t *row = &padded[GRIDEYE_PADDED_INDEX(0, y)];
+    for (uint8_t x = 0; x < 8; x++)
+      *frame++ = row[x];
+  }
+}
+
+void GridEYEFilter::refreshBorder(int16_t *padded)
+{
+  for (uint8_t y = 1; y < 9; y++)
+  {
+    int16_t *row = &padded[y * STRIDE];
+    row[0] = row[1];
+    row[9] = row[8];
+  }
+  memcpy(&padded[0], &padded[STRIDE], STRIDE * sizeof(int16_t));
+  memcpy(&padded[9 * STRIDE], &padded[8 * STRIDE], STRIDE * sizeof(int16_t));
+}
+
+/********************************************************
+ * Kernels
+ ********************************************************
+ *
+ * median3x3() - the median of nine is the median of: the
+ *    largest column minimum, the median column middle and
+ *    the smallest column maximum, once each column is
+ *    sorted. Columns are sorted once per row into lo/mid/hi
+ *    and each is shared by three windows.
+ *
+ * gaussian3x3() - a row pass then a column pass. Each
+ *    carries the original value of the pixel before it,
+ *    since that has already been overwritten.
+ *
+ * sobel3x3() - per row, the vertical [1 2 1] sums and the
+ *    vertical differences of every column are taken once;
+ *    gx and gy are then short horizontal combinations.
+ *
+ ********************************************************/
+
+void GridEYEFilter::median3x3(const int16_t *in, int16_t *out)
+{
+  int16_t lo[STRIDE];
+  int16_t mid[STRIDE];
+  int16_t hi[STRIDE];
+
+  for (uint8_t y = 0; y < 8; y++)
+  {
+    const int16_t *above = &in[y * STRIDE];
+    const int16_t *center = above + STRIDE;
+    const int16_t *below = center + STRIDE;
+    for (uint8_t x = 0; x < STRIDE; x++)
+    {
+      int16_t a = above[x];
+      int16_t b = center[x];
+      int16_t c = below[x];
+      int16_t low = min16(a, b);
+      int16_t high = max16(a, b);
+      lo[x] = min16(low, c);
+      mid[x] = max16(low, min16(high, c));
+      hi[x] = max16(high, c);
+    }
+
+    int16_t *row = &out[GRIDEYE_PADDED_INDEX(0, y)];
+    for (uint8_t x = 0; x < 8; x++)
+    {
+      int16_t largestLow = max16(max16(lo[x], lo[x + 1]), lo[x + 2]);
+      int16_t smallestHigh = min16(min16(hi[x], hi[x + 1]), hi[x + 2]);
+      row[x] = median3(largestLow, median3(mid[x], mid[x + 1], mid[x + 2]), smallestHigh);
+    }
+  }
+  refreshBorder(out);
+}
+
+void GridEYEFilter::gaussian3x3(int16_t *padded)
+{
+  for (uint8_t y = 1; y < 9; y++)
+  {
+    int16_t *row = &padded[y * STRIDE];
+    int16_t previous = row[0];
+    for (uint8_t x = 1; x < 9; x++)
+    {
+      int16_t current = row[x];
+      row[x] = (previous + 2 * current + row[x + 1] + 2) >> 2;
+      previous = current;
+    }
+  }
+
+  // The column pass needs the blurred top and bottom rows in the border
+  memcpy(&padded[1], &padded[STRIDE + 1], 8 * sizeof(int16_t));
+  memcpy(&padded[9 * STRIDE + 1], &padded[8 * STRIDE + 1], 8 * sizeof(int16_t));
+
+  for (uint8_t x = 1; x < 9; x++)
+  {
+    int16_t *column = &padded[x];
+    int16_t previous = column[0];
+    for (uint8_t y = 1; y < 9; y++)
+    {
+      int16_t current = column[y * STRIDE];
+      column[y * STRIDE] = (previous + 2 * current + column[(y + 1) * STRIDE] + 2) >> 2;
+      previous = current;
+    }
+  }
+  refreshBorder(padded);
+}
+
+void GridEYEFilter::sobel3x3(const int16_t *in, int16_t *out)
+{
+  int16_t sum[STRIDE];
+  int16_t diff[STRIDE];
+
+  for (uint8_t y = 0; y < 8; y++)
+  {
+    const int16_t *above = &in[y * STRIDE];
+    const int16_t *center = above + STRIDE;
+    const int16_t *below = center + STRIDE;
+    for (uint8_t x = 0; x < STRIDE; x++)
+    {
+      sum[x] = above[x] + 2 * center[x] + below[x];
+      diff[x] = below[x] - above[x];
+    }
+
+    int16_t *row = &out[GRIDEYE_PADDED_INDEX(0, y)];
+    for (uint8_t x = 0; x < 8; x++)
+    {
+      int16_t gx = sum[x + 2] - sum[x];
+      int16_t gy = diff[x] + 2 * diff[x + 1] + diff[x + 2];
+      if (gx < 0)
+        gx = -gx;
+      if (gy < 0)
+        gy = -gy;
+      int16_t large = max16(gx, gy);
+      int16_t small = min16(gx, gy);
+      row[x] = large + (int16_t)((3 * (uint16_t)small) >> 3); // Unsigned, 3 * small can pass 32767
+    }
+  }
+  refreshBorder(out);
+}
+
+/********************************************************
+ * Working frame
+ ********************************************************/
+
+void GridEYEFilter::load(const int16_t *frame)
+{
+  pad(frame, _buffers[_current]);
+}
+
+void GridEYEFilter::store(int16_t *frame)
+{
+  unpad(_buffers[_current], frame);
+}
+
+int16_t GridEYEFilter::get(uint8_t x, uint8_t y)
+{
+  if ((x > 7) || (y > 7))
+    return 0;
+  return _buffers[_current][GRIDEYE_PADDED_INDEX(x, y)];
+}
+
+const int16_t *GridEYEFilter::getPadded()
+{
+  return _buffers[_current];
+}
+
+void GridEYEFilter::median()
+{
+  median3x3(_buffers[_current], _buffers[_current ^ 1]);
+  _current ^= 1;
+}
+
+void GridEYEFilter::gaussian()
+{
+  gaussian3x3(_buffers[_current]);
+}
+
+void GridEYEFilter::sobel()
+{
+  sobel3x3(_buffers[_current], _buffers[_current ^ 1]);
+  _current ^= 1;
+}
@@ -0,0 +1,83 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Fixed-point 3x3 spatial filters for GridEYE frames.
+
+  Frames are worked on in a padded 10x10 layout: the 8x8 pixels sit in
+  the middle with a one pixel border that repeats the nearest edge
+  pixel. Every 3x3 neighbourhood is then inside the buffer, so the
+  kernels have no edge cases and no bounds checks. Pixel (x, y) is at
+  GRIDEYE_PADDED_INDEX(x, y).
+
+  Kernels, all on int16 values of a sign-extended frame (0.25C per LSB):
+    median    3x3 median. Each column of three is sorted once per row
+              and shared by the three windows that contain it, then a
+              short merge network finds the median of the three sorted
+              columns, instead of a full 19 exchange sort per pixel.
+    gaussian  3x3 binomial blur ([1 2 1] / 4 across then down), done in
+              place with one carried value per pass, no second buffer.
+              Each pass rounds half up.
+    sobel     Gradient magnitude, max(|gx|, |gy|) + 3/8 min(|gx|, |gy|),
+              within 7% of the true length. A ramp of one LSB per pixel
+              gives 8.
+
+  Sums are kept in 16 bits so AVR stays fast. That is exact for any
+  frame from the sensor (+-2048), and the blur also takes values up to
+  +-8191, so blur before taking gradients rather than after.
+
+  The static kernels work on caller owned padded buffers. A
+  GridEYEFilter object holds two of them (400 bytes) and ping-pongs
+  between them, so a chain like median then sobel costs no copies.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define GRIDEYE_PADDED_STRIDE 10
+#define GRIDEYE_PADDED_SIZE (GRIDEYE_PADDED_STRIDE * GRIDEYE_PADDED_STRIDE)
+#define GRIDEYE_PADDED_INDEX(x, y) (((y) + 1) * GRIDEYE_PADDED_STRIDE + (x) + 1)
+
+class GridEYEFilter
+{
+public:
+  GridEYEFilter();
+
+  // Working frame, kept padded
+  void load(const int16_t *frame);
+  void store(int16_t *frame);
+  int16_t get(uint8_t x, uint8_t y);
+  const int16_t *getPadded();
+
+  // Apply a kernel to the working frame
+  void median();
+  void gaussian();
+  void sobel();
+
+  // Kernels on caller owned padded buffers. in and out must not overlap;
+  // every output includes its border, ready for the next kernel.
+  static void pad(const int16_t *frame, int16_t *padded);
+  static void unpad(const int16_t *padded, int16_t *frame);
+  static void refreshBorder(int16_t *padded); // After editing the middle by hand
+  static void median3x3(const int16_t *in, int16_t *out);
+  static void gaussian3x3(int16_t *padded); // In place
+  static void sobel3x3(const int16_t *in, int16_t *out);
+
+private:
+  int16_t _buffers[2][GRIDEYE_PADDED_SIZE];
+  uint8_t _current;
+};
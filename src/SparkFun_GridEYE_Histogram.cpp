@@ -0,0 +1,232 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Counting histogram and percentiles over raw GridEYE frames.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Histogram.h"
+
+GridEYEHistogram::GridEYEHistogram()
+{
+  _history = NULL;
+  _windowFrames = 0;
+  setRange(GRIDEYE_HISTOGRAM_DEFAULT_LOW, GRIDEYE_HISTOGRAM_DEFAULT_SHIFT);
+}
+
+void GridEYEHistogram::setRange(int16_t low, uint8_t shift)
+{
+  _low = low;
+  _shift = shift;
+  clear();
+}
+
+void GridEYEHistogram::clear()
+{
+  for (uint8_t i = 0; i < GRIDEYE_HISTOGRAM_BINS; i++)
+    _bins[i] = 0;
+  for (uint8_t i = 0; i < GRIDEYE_HISTOGRAM_COARSE_BINS; i++)
+    _coarse[i] = 0;
+  _total = 0;
+  _windowFill = 0;
+  _windowNext = 0;
+}
+
+/********************************************************
+ * Counting
+ ********************************************************
+ *
+ * getBin() - clamps values outside the range into the
+ *    end bins
+ *
+ * Every count goes into its fine bin and the coarse bin
+ * above it, so the two always agree.
+ *
+ ********************************************************/
+
+uint8_t GridEYEHistogram::getBin(int16_t raw)
+{
+  int16_t offset = raw - _low;
+  if (offset < 0)
+    return 0;
+  offset >>= _shift;
+  if (offset >= GRIDEYE_HISTOGRAM_BINS)
+    return GRIDEYE_HISTOGRAM_BINS - 1;
+  return (uint8_t)offset;
+}
+
+int16_t GridEYEHistogram::getBinValue(uint8_t bin)
+{
+  return _low + ((int16_t)bin << _shift) + ((1 << _shift) >> 1);
+}
+
+void GridEYEHistogram::addValue(int16_t raw)
+{
+  uint8_t bin = getBin(raw);
+  _bins[bin]++;
+  _coarse[bin >> 3]++;
+  _total++;
+}
+
+void GridEYEHistogram::removeValue(int16_t raw)
+{
+  uint8_t bin = getBin(raw);
+  _bins[bin]--;
+  _coarse[bin >> 3]--;
+  _total--;
+}
+
+void GridEYEHistogram::addFrame(const int16_t *frame)
+{
+  for (uint8_t i = 0; i < 64; i++)
+    addValue(frame[i]);
+}
+
+void GridEYEHistogram::removeFrame(const int16_t *frame)
+{
+  for (uint8_t i = 0; i < 64; i++)
+    removeValue(frame[i]);
+}
+
+uint16_t GridEYEHistogram::getTotal()
+{
+  return _total;
+}
+
+uint16_t GridEYEHistogram::getCount(uint8_t bin)
+{
+  return _bins[bin];
+}
+
+/********************************************************
+ * Sliding window
+ ********************************************************
+ *
+ * The window keeps the bin of every pixel of the frames
+ * in it, not the values, so dropping the oldest frame is
+ * 64 decrements with no need to re-bin.
+ *
+ ********************************************************/
+
+void GridEYEHistogram::setWindow(uint8_t *history, uint8_t frames)
+{
+  _history = history;
+  _windowFrames = frames;
+  clear();
+}
+
+void GridEYEHistogram::pushFrame(const int16_t *frame)
+{
+  if ((_history == NULL) || (_windowFrames == 0))
+  {
+    addFrame(frame);
+    return;
+  }
+
+  uint8_t *slot = &_history[(uint16_t)_windowNext * 64];
+
+  if (_windowFill == _windowFrames)
+  {
+    for (uint8_t i = 0; i < 64; i++)
+    {
+      _bins[slot[i]]--;
+      _coarse[slot[i] >> 3]--;
+    }
+    _total -= 64;
+  }
+  else
+  {
+    _windowFill++;
+  }
+
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    uint8_t bin = getBin(frame[i]);
+    slot[i] = bin;
+    _bins[bin]++;
+    _coarse[bin >> 3]++;
+  }
+  _total += 64;
+
+  if (++_windowNext == _windowFrames)
+    _windowNext = 0;
+}
+
+uint8_t GridEYEHistogram::getWindowFill()
+{
+  return _windowFill;
+}
+
+/********************************************************
+ * Queries
+ ********************************************************
+ *
+ * getPercentilePermille() - the bin holding the pixel of
+ *    rank ceil(total * permille / 1000), counting from 1.
+ *    Walks the coarse bins to find the block of 8, then
+ *    the fine bins inside it.
+ *
+ * getStretch() - maps the two percentiles to 0 and 255,
+ *    widening the span around its middle to minSpan
+ *
+ ********************************************************/
+
+int16_t GridEYEHistogram::getPercentilePermille(uint16_t permille)
+{
+  if (_total == 0)
+    return 0;
+  if (permille > 1000)
+    permille = 1000;
+
+  uint16_t rank = (uint16_t)(((uint32_t)_total * permille + 999) / 1000);
+  if (rank == 0)
+    rank = 1;
+
+  uint16_t seen = 0;
+  uint8_t block = 0;
+  while (seen + _coarse[block] < rank)
+    seen += _coarse[block++];
+
+  uint8_t bin = block << 3;
+  while (seen + _bins[bin] < rank)
+    seen += _bins[bin++];
+
+  return getBinValue(bin);
+}
+
+int16_t GridEYEHistogram::getPercentile(uint8_t percent)
+{
+  return getPercentilePermille((uint16_t)percent * 10);
+}
+
+void GridEYEHistogram::getStretch(GridEYEStretch *stretch, uint8_t lowPercent, uint8_t highPercent, int16_t minSpan)
+{
+  int16_t low = getPercentile(lowPercent);
+  int16_t high = getPercentile(highPercent);
+
+  if (minSpan < 1)
+    minSpan = 1;
+  if (high - low < minSpan)
+  {
+    int16_t middle = low + (high - low) / 2;
+    low = middle - minSpan / 2;
+    high = low + minSpan;
+  }
+
+  stretch->low = low;
+  stretch->high = high;
+  uint16_t span = (uint16_t)(high - low);
+  stretch->scale = (uint16_t)(((255UL << 8) + span - 1) / span); // Rounded up so high lands on 255
+}
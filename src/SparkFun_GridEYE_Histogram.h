@@ -0,0 +1,116 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Counting histogram and percentiles over raw GridEYE frames.
+
+  Pixels are 12-bit quarter degree values, so instead of sorting a
+  frame to find its percentiles they are counted into fixed bins.
+  Adding or removing a frame is 64 increments or decrements, and a
+  percentile query walks 16 coarse bins and then at most 8 fine ones,
+  whatever the number of frames counted.
+
+  The default range is -20C to 108C in 1C bins, the sensor's whole
+  -20C to 80C span with room to spare for calibrated or drift
+  corrected values. Values outside the range are clamped: anything
+  below it counts in bin 0 and anything above it in the last bin, so
+  a percentile that lands there reads as the end of the range, not
+  the true value. setRange() trades span for finer bins, e.g. 0.5C
+  bins over -10C to 54C for indoor scenes.
+
+  For a sliding histogram over the last N frames, give setWindow() a
+  buffer of N * 64 bytes. pushFrame() then counts the new frame and
+  uncounts the one that drops out of the window.
+
+  Fixed RAM use is 288 bytes for the counts, plus the window buffer
+  if one is used.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define GRIDEYE_HISTOGRAM_BINS 128
+#define GRIDEYE_HISTOGRAM_COARSE_BINS 16 // Each covers 8 fine bins
+
+// Default range: -20C upwards, 4 raw LSB (1C) per bin, up to 108C
+#define GRIDEYE_HISTOGRAM_DEFAULT_LOW (-20 * 4)
+#define GRIDEYE_HISTOGRAM_DEFAULT_SHIFT 2
+
+// Linear mapping of raw values onto 0..255, from getStretch()
+struct GridEYEStretch
+{
+  int16_t low;    // Raw value mapped to 0
+  int16_t high;   // Raw value mapped to 255
+  uint16_t scale; // 255 / (high - low), Q8
+
+  inline uint8_t apply(int16_t raw)
+  {
+    int32_t value = ((int32_t)(raw - low) * scale) >> 8;
+    if (value < 0)
+      return 0;
+    if (value > 255)
+      return 255;
+    return (uint8_t)value;
+  }
+};
+
+class GridEYEHistogram
+{
+public:
+  GridEYEHistogram();
+
+  // Bin n covers raw values low + (n << shift) up to the next bin; values past
+  // either end count in the end bins. Clears the counts.
+  void setRange(int16_t low, uint8_t shift);
+
+  void clear();
+  void addFrame(const int16_t *frame); // Up to 1023 frames in total
+  void removeFrame(const int16_t *frame); // Must be a frame that was added
+  void addValue(int16_t raw);
+  void removeValue(int16_t raw);
+
+  // Sliding window. history holds frames * 64 bytes and belongs to the caller.
+  void setWindow(uint8_t *history, uint8_t frames);
+  void pushFrame(const int16_t *frame); // Adds the frame, dropping the oldest once the window is full
+  uint8_t getWindowFill();
+
+  uint16_t getTotal();
+  uint16_t getCount(uint8_t bin);
+  uint8_t getBin(int16_t raw);
+  int16_t getBinValue(uint8_t bin); // Raw value at the middle of the bin
+
+  // Raw value below which the given share of counted pixels fall, to the bin
+  int16_t getPercentile(uint8_t percent);
+  int16_t getPercentilePermille(uint16_t permille);
+
+  // Mapping for rendering or thresholding that puts the lowPercent pixel at 0
+  // and the highPercent pixel at 255. minSpan keeps a flat scene from turning
+  // noise into full contrast.
+  void getStretch(GridEYEStretch *stretch, uint8_t lowPercent = 1, uint8_t highPercent = 99, int16_t minSpan = 8);
+
+private:
+  uint16_t _bins[GRIDEYE_HISTOGRAM_BINS];
+  uint16_t _coarse[GRIDEYE_HISTOGRAM_COARSE_BINS];
+  uint16_t _total;
+  int16_t _low;
+  uint8_t _shift;
+
+  uint8_t *_history;
+  uint8_t _windowFrames;
+  uint8_t _windowFill;
+  uint8_t _windowNext;
+};
@@ -0,0 +1,421 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Small int8 neural network runtime for GridEYE frames.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "SparkFun_GridEYE_Inference.h"
+
+#define MODEL_MAGIC_0 'G'
+#define MODEL_MAGIC_1 'M'
+
+GridEYEModel::GridEYEModel()
+{
+  _model = NULL;
+  _progmem = false;
+  _arena = NULL;
+  _arenaSize = 0;
+  _required = 0;
+  _ready = false;
+  _output = NULL;
+  _outputCount = 0;
+  _latency = 0;
+}
+
+/********************************************************
+ * Model access
+ ********************************************************
+ *
+ * Everything is read through readByte() so the same code
+ * runs on a model in RAM or in AVR program memory.
+ *
+ ********************************************************/
+
+inline uint8_t GridEYEModel::readByte(uint16_t offset)
+{
+#if defined(__AVR__)
+  if (_progmem)
+    return pgm_read_byte(_model + offset);
+#endif
+  return _model[offset];
+}
+
+int16_t GridEYEModel::readInt16(uint16_t offset)
+{
+  return (int16_t)((uint16_t)readByte(offset) | ((uint16_t)readByte(offset + 1) << 8));
+}
+
+int32_t GridEYEModel::readInt32(uint16_t offset)
+{
+  return (int32_t)((uint32_t)readByte(offset) | ((uint32_t)readByte(offset + 1) << 8) |
+                   ((uint32_t)readByte(offset + 2) << 16) | ((uint32_t)readByte(offset + 3) << 24));
+}
+
+bool GridEYEModel::begin(const uint8_t *model, int8_t *arena, uint16_t arenaSize, bool inProgmem)
+{
+  _model = model;
+  _progmem = inProgmem;
+  _arena = arena;
+  _arenaSize = arenaSize;
+  _required = 0;
+  _ready = false;
+
+  if ((readByte(0) != MODEL_MAGIC_0) || (readByte(1) != MODEL_MAGIC_1) || (readByte(2) != GRIDEYE_MODEL_VERSION))
+    return false;
+
+  uint16_t length = (uint16_t)readInt16(4);
+  if (length <= GRIDEYE_MODEL_HEADER_SIZE)
+    return false;
+
+  uint8_t checksum = 0;
+  for (uint16_t i = 0; i < length - 1; i++)
+    checksum += readByte(i);
+  if ((uint8_t)~checksum != readByte(length - 1))
+    return false;
+
+  if (!walk(NULL))
+  {
+    _required = 0;
+    return false;
+  }
+
+  _ready = (arena != NULL) && (arenaSize >= _required);
+  return _ready;
+}
+
+uint16_t GridEYEModel::getArenaSize()
+{
+  return _required;
+}
+
+bool GridEYEModel::run(const int16_t *frame)
+{
+  if (!_ready)
+    return false;
+
+  unsigned long start = micros();
+  bool result = walk(frame);
+  _latency = micros() - start;
+  return result;
+}
+
+/********************************************************
+ * Arithmetic
+ ********************************************************
+ *
+ * These two define the numbers the model produces; the
+ * host reference in extras/linux repeats them exactly.
+ * Right shifts of negative values are arithmetic on every
+ * compiler the library supports.
+ *
+ ********************************************************/
+
+void GridEYEModel::quantizeInput(const int16_t *frame, int8_t *out)
+{
+  uint8_t flags = readByte(6);
+  int32_t offset = readInt16(7);
+  int32_t multiplier = readInt16(9);
+  uint8_t shift = readByte(11);
+
+  if (flags & GRIDEYE_MODEL_INPUT_MEAN)
+  {
+    int32_t total = 0;
+    for (uint8_t i = 0; i < 64; i++)
+      total += frame[i];
+    offset += total >> 6;
+  }
+
+  int32_t round = (shift > 0) ? ((int32_t)1 << (shift - 1)) : 0;
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    int32_t value = ((frame[i] - offset) * multiplier + round) >> shift;
+    if (value > 127)
+      value = 127;
+    else if (value < -128)
+      value = -128;
+    out[i] = (int8_t)value;
+  }
+}
+
+int8_t GridEYEModel::requantize(int32_t acc, int16_t multiplier, uint8_t shift, bool relu)
+{
+  int32_t value;
+  if (shift >= 15)
+  {
+    uint8_t right = shift - 15;
+    // Round half up without forming acc + 2^(right - 1), which could overflow
+    value = (right > 0) ? (((acc >> (right - 1)) + 1) >> 1) : acc;
+  }
+  else
+  {
+    uint8_t left = 15 - shift;
+    if (acc > (32767L >> left))
+      value = 32767;
+    else if (acc < -(32768L >> left))
+      value = -32768;
+    else
+      value = acc * ((int32_t)1 << left);
+  }
+
+  if (value > 32767)
+    value = 32767;
+  else if (value < -32768)
+    value = -32768;
+
+  value = (value * multiplier + 16384) >> 15;
+
+  if (value > 127)
+    return 127;
+  if (value < (relu ? 0 : -128))
+    return relu ? 0 : -128;
+  return (int8_t)value;
+}
+
+/********************************************************
+ * Layers
+ ********************************************************
+ *
+ * walk() - steps through the layers, tracking the tensor
+ *    shape. Each layer's input is at one end of the arena
+ *    and its output goes to the other end; ReLU works in
+ *    place. Without a frame it only validates the model
+ *    and records the largest input plus output size. A
+ *    final tensor over 255 values is refused.
+ *
+ ********************************************************/
+
+bool GridEYEModel::walk(const int16_t *frame)
+{
+  bool execute = (frame != NULL);
+  uint16_t length = (uint16_t)readInt16(4);
+  uint8_t layers = readByte(3);
+  uint16_t offset = GRIDEYE_MODEL_HEADER_SIZE;
+
+  uint16_t height = 8;
+  uint16_t width = 8;
+  uint16_t channels = 1;
+  uint16_t required = 64;
+
+  int8_t *in = _arena;
+  bool atEnd = false; // Which end of the arena the current tensor is at
+  if (execute)
+    quantizeInput(frame, in);
+
+  for (uint8_t n = 0; n < layers; n++)
+  {
+    if ((uint32_t)offset + 2 > (uint32_t)length - 1)
+      return false;
+
+    uint8_t type = readByte(offset);
+    bool relu = (readByte(offset + 1) & GRIDEYE_MODEL_FUSED_RELU);
+    offset += 2;
+
+    uint16_t inSize = height * width * channels;
+
+    if (type == GRIDEYE_LAYER_RELU)
+    {
+      if (execute)
+      {
+        for (uint16_t i = 0; i < inSize; i++)
+        {
+          if (in[i] < 0)
+            in[i] = 0;
+        }
+      }
+      continue;
+    }
+
+    uint16_t outHeight = height;
+    uint16_t outWidth = width;
+    uint16_t outChannels = channels;
+    uint8_t kernel = 1;
+    uint8_t stride = 1;
+    int16_t multiplier;
+    uint8_t shift;
+    uint32_t weightCount;
+
+    if (type == GRIDEYE_LAYER_CONV)
+    {
+      outChannels = readByte(offset);
+      kernel = readByte(offset + 1);
+      stride = readByte(offset + 2);
+      multiplier = readInt16(offset + 3);
+      shift = readByte(offset + 5);
+      offset += 6;
+      weightCount = (uint32_t)outChannels * kernel * kernel * channels;
+    }
+    else if (type == GRIDEYE_LAYER_DEPTHWISE)
+    {
+      kernel = readByte(offset);
+      stride = readByte(offset + 1);
+      multiplier = readInt16(offset + 2);
+      shift = readByte(offset + 4);
+      offset += 5;
+      weightCount = (uint32_t)kernel * kernel * channels;
+    }
+    else if (type == GRIDEYE_LAYER_DENSE)
+    {
+      outChannels = readByte(offset);
+      multiplier = readInt16(offset + 1);
+      shift = readByte(offset + 3);
+      offset += 4;
+      outHeight = 1;
+      outWidth = 1;
+      weightCount = (uint32_t)outChannels * inSize;
+    }
+    else
+    {
+      return false;
+    }
+
+    if ((outChannels == 0) || !(kernel & 1) || (kernel > 7) || (stride < 1) || (stride > 2) || (shift > 46))
+      return false;
+
+    if (type != GRIDEYE_LAYER_DENSE)
+    {
+      outHeight = (height + stride - 1) / stride;
+      outWidth = (width + stride - 1) / stride;
+    }
+
+    uint16_t bias = offset;
+    uint32_t end = (uint32_t)offset + 4UL * outChannels + weightCount;
+    if (end > (uint32_t)length - 1)
+      return false;
+    uint16_t weights = offset + 4 * outChannels;
+    offset = (uint16_t)end;
+
+    uint32_t outSize = (uint32_t)outHeight * outWidth * outChannels;
+    if ((uint32_t)inSize + outSize > 0xFFFF)
+      return false;
+    if (inSize + outSize > required)
+      required = inSize + outSize;
+
+    if (execute)
+    {
+      int8_t *out = atEnd ? _arena : _arena + _arenaSize - outSize;
+      uint8_t pad = kernel / 2;
+
+      if (type == GRIDEYE_LAYER_DENSE)
+      {
+        for (uint16_t o = 0; o < outChannels; o++)
+        {
+          int32_t acc = readInt32(bias + 4 * o);
+          uint16_t row = weights + o * inSize;
+          for (uint16_t i = 0; i < inSize; i++)
+            acc += (int16_t)in[i] * (int8_t)readByte(row + i);
+          out[o] = requantize(acc, multiplier, shift, relu);
+        }
+      }
+      else
+      {
+        int8_t *dst = out;
+        for (uint16_t oy = 0; oy < outHeight; oy++)
+        {
+          for (uint16_t ox = 0; ox < outWidth; ox++)
+          {
+            for (uint16_t oc = 0; oc < outChannels; oc++)
+            {
+              int32_t acc = readInt32(bias + 4 * oc);
+              for (uint8_t ky = 0; ky < kernel; ky++)
+              {
+                int16_t iy = (int16_t)(oy * stride + ky) - pad;
+                if ((iy < 0) || (iy >= (int16_t)height))
+                  continue;
+                for (uint8_t kx = 0; kx < kernel; kx++)
+                {
+                  int16_t ix = (int16_t)(ox * stride + kx) - pad;
+                  if ((ix < 0) || (ix >= (int16_t)width))
+                    continue;
+
+                  const int8_t *pixel = &in[(iy * width + ix) * channels];
+                  if (type == GRIDEYE_LAYER_CONV)
+                  {
+                    uint16_t tap = weights + ((oc * kernel + ky) * kernel + kx) * channels;
+                    for (uint16_t ic = 0; ic < channels; ic++)
+                      acc += (int16_t)pixel[ic] * (int8_t)readByte(tap + ic);
+                  }
+                  else
+                  {
+                    acc += (int16_t)pixel[oc] * (int8_t)readByte(weights + (ky * kernel + kx) * channels + oc);
+                  }
+                }
+              }
+              *dst++ = requantize(acc, multiplier, shift, relu);
+            }
+          }
+        }
+      }
+
+      in = out;
+      atEnd = !atEnd;
+    }
+
+    height = outHeight;
+    width = outWidth;
+    channels = outChannels;
+  }
+
+  if (offset != length - 1)
+    return false;
+  if ((uint32_t)height * width * channels > 255)
+    return false; // getOutput() indexes with a byte
+
+  _required = required;
+  _output = in;
+  _outputCount = (uint8_t)(height * width * channels);
+  return true;
+}
+
+/********************************************************
+ * Results
+ ********************************************************/
+
+uint8_t GridEYEModel::getOutputCount()
+{
+  return _outputCount;
+}
+
+int8_t GridEYEModel::getOutput(uint8_t index)
+{
+  return (index < _outputCount) ? _output[index] : 0;
+}
+
+const int8_t *GridEYEModel::getOutputs()
+{
+  return _output;
+}
+
+uint8_t GridEYEModel::getClass()
+{
+  uint8_t best = 0;
+  for (uint8_t i = 1; i < _outputCount; i++)
+  {
+    if (_output[i] > _output[best])
+      best = i;
+  }
+  return best;
+}
+
+unsigned long GridEYEModel::getLatency()
+{
+  return _latency;
+}
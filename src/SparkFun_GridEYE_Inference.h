@@ -0,0 +1,121 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Small int8 neural network runtime for GridEYE frames.
+
+  Runs convolution, depthwise convolution, dense and ReLU layers on
+  an 8x8 frame, quantized to int8 straight from the raw frame buffer.
+  All arithmetic is integer (int8 x int8 into int32, then a 16-bit
+  requantize), so any platform gives bit-identical outputs.
+
+  The model is a compact blob, in RAM or in flash (PROGMEM), that is
+  read layer by layer as it runs; nothing from it is copied to RAM.
+  Activations live in a caller supplied arena. Each layer reads its
+  input from one end of the arena and writes its output to the other,
+  so the arena only has to hold the largest input plus output pair;
+  begin() works that size out and getArenaSize() reports it.
+
+  Model blob, all values little endian:
+    header   'G' 'M' version(1) layers(1) length(2)
+             inputFlags(1) inputOffset(2) inputMultiplier(2) inputShift(1)
+    layers   type(1) flags(1) then per type:
+               conv       outChannels(1) kernel(1) stride(1) multiplier(2) shift(1)
+                          bias(4 x out) weights(out x kernel x kernel x in)
+               depthwise  kernel(1) stride(1) multiplier(2) shift(1)
+                          bias(4 x channels) weights(kernel x kernel x channels)
+               dense      outputs(1) multiplier(2) shift(1)
+                          bias(4 x out) weights(out x in)
+               relu       nothing
+    checksum inverted 8-bit sum of every byte before it
+
+  length counts every byte including the checksum. Tensors are height x
+  width x channels, row by row. Convolutions pad with zeros to keep the
+  size at stride 1 and halve it (rounding up) at stride 2. Dense layers
+  take the whole input tensor in that order.
+
+  Input: q = (raw - inputOffset [- frame mean] ) * inputMultiplier,
+  rounded and shifted right by inputShift, saturated to int8. The frame
+  mean (sum >> 6) is subtracted if inputFlags has GRIDEYE_MODEL_INPUT_MEAN.
+
+  Requantize: the int32 accumulator (bias plus products) is scaled by
+  multiplier / 2^shift. For shift >= 15 it is first rounded and shifted
+  right by shift - 15, for shift < 15 shifted left; either way it is
+  saturated to int16, multiplied by multiplier, rounded and shifted
+  right by 15, then saturated to int8 (or 0..127 with
+  GRIDEYE_MODEL_FUSED_RELU).
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define GRIDEYE_MODEL_VERSION 1
+#define GRIDEYE_MODEL_HEADER_SIZE 12
+
+// Layer types
+#define GRIDEYE_LAYER_CONV 1
+#define GRIDEYE_LAYER_DEPTHWISE 2
+#define GRIDEYE_LAYER_DENSE 3
+#define GRIDEYE_LAYER_RELU 4
+
+// Layer flags
+#define GRIDEYE_MODEL_FUSED_RELU 0x01
+
+// Input flags
+#define GRIDEYE_MODEL_INPUT_MEAN 0x01 // Subtract the frame mean first
+
+class GridEYEModel
+{
+public:
+  GridEYEModel();
+
+  // Check the model and plan the arena. Returns false if the model is not
+  // valid, has over 255 outputs, or arena is smaller than getArenaSize().
+  // Set inProgmem for a model stored with PROGMEM on AVR.
+  bool begin(const uint8_t *model, int8_t *arena, uint16_t arenaSize, bool inProgmem = false);
+  uint16_t getArenaSize(); // Bytes of arena the model needs, 0 if it is not valid
+
+  // Run the model on a sign-extended frame, 0.25C per LSB
+  bool run(const int16_t *frame);
+
+  uint8_t getOutputCount();
+  int8_t getOutput(uint8_t index);
+  const int8_t *getOutputs();
+  uint8_t getClass();          // Index of the largest output
+  unsigned long getLatency();  // Microseconds taken by the last run()
+
+private:
+  uint8_t readByte(uint16_t offset);
+  int16_t readInt16(uint16_t offset);
+  int32_t readInt32(uint16_t offset);
+
+  // Walks the layers. With frame NULL only checks them and sizes the arena.
+  bool walk(const int16_t *frame);
+  void quantizeInput(const int16_t *frame, int8_t *out);
+  int8_t requantize(int32_t acc, int16_t multiplier, uint8_t shift, bool relu);
+
+  const uint8_t *_model;
+  bool _progmem;
+  int8_t *_arena;
+  uint16_t _arenaSize;
+  uint16_t _required;
+  bool _ready;
+
+  const int8_t *_output;
+  uint8_t _outputCount;
+  unsigned long _latency;
+};
@@ -0,0 +1,379 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Block matching and Lucas-Kanade motion vectors for GridEYE frames.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "SparkFun_GridEYE_Motion.h"
+
+#define SEARCH_OFFSETS 25
+#define GRADIENT_LIMIT 1023 // Scaled so 16 products of two fit 32 bits with room
+#define TAN_22_5 106        // tan(22.5 degrees) in Q8
+
+// Whole pixel offsets within GRIDEYE_MOTION_RANGE, nearest first
+static const int8_t searchOffsets[SEARCH_OFFSETS][2] = {
+    {0, 0},   {1, 0},   {-1, 0}, {0, 1},  {0, -1}, {1, 1},  {-1, 1},  {1, -1}, {-1, -1},
+    {2, 0},   {-2, 0},  {0, 2},  {0, -2}, {2, 1},  {-2, 1}, {2, -1},  {-2, -1}, {1, 2},
+    {-1, 2},  {1, -2},  {-1, -2}, {2, 2}, {-2, 2}, {2, -2}, {-2, -2}};
+
+// Pixels outside the frame repeat the edge
+static inline int16_t pixelAt(const int16_t *frame, int8_t x, int8_t y)
+{
+  if (x < 0)
+    x = 0;
+  else if (x > 7)
+    x = 7;
+  if (y < 0)
+    y = 0;
+  else if (y > 7)
+    y = 7;
+  return frame[(y << 3) + x];
+}
+
+static inline int16_t abs16(int16_t value)
+{
+  return (value < 0) ? -value : value;
+}
+
+static int32_t divideRounded(int64_t numerator, int64_t denominator)
+{
+  if (numerator < 0)
+    return (int32_t)-((-numerator + denominator / 2) / denominator);
+  return (int32_t)((numerator + denominator / 2) / denominator);
+}
+
+GridEYEMotion::GridEYEMotion()
+{
+  _minTexture = GRIDEYE_MOTION_MIN_TEXTURE;
+  _minSpeed = GRIDEYE_MOTION_MIN_SPEED;
+  reset();
+}
+
+void GridEYEMotion::reset()
+{
+  _havePrevious = false;
+  memset(_field, 0, sizeof(_field));
+  _dominantX = 0;
+  _dominantY = 0;
+  _votes = 0;
+  _moving = 0;
+}
+
+void GridEYEMotion::setMinTexture(uint16_t minTexture)
+{
+  _minTexture = minTexture;
+}
+
+void GridEYEMotion::setMinSpeed(int16_t minSpeed)
+{
+  _minSpeed = minSpeed;
+}
+
+bool GridEYEMotion::update(const int16_t *frame)
+{
+  bool ready = _havePrevious;
+  if (ready)
+  {
+    estimate(_previous, frame, _field, _minTexture);
+    _votes = dominant(_field, _minSpeed, &_dominantX, &_dominantY);
+    _moving = 0;
+    for (uint8_t i = 0; i < GRIDEYE_MOTION_VECTORS; i++)
+    {
+      if (isMoving(_field[i], _minSpeed))
+        _moving++;
+    }
+  }
+  memcpy(_previous, frame, sizeof(_previous));
+  _havePrevious = true;
+  return ready;
+}
+
+/********************************************************
+ * Vector field
+ ********************************************************
+ *
+ * estimate() - per cell, the whole pixel offset d with the
+ *    smallest SAD between the current window and the
+ *    previous frame read at p - d, then one Lucas-Kanade
+ *    step for the rest. With S the sum of both frames'
+ *    central differences (four times the gradient) and
+ *    It = current - shifted previous, the shift solves
+ *
+ *      [sum Sx*Sx  sum Sx*Sy] [dx]        [sum Sx*It]
+ *      [sum Sx*Sy  sum Sy*Sy] [dy]  = -4  [sum Sy*It]
+ *
+ *    A frame spanning more than GRADIENT_LIMIT is scaled
+ *    down first, S and It alike so the shift is unchanged.
+ *    The texture is det / trace of the matrix, close to its
+ *    smaller eigenvalue, in the frame's own units. A window
+ *    that differs from the previous frame by no more than
+ *    GRIDEYE_MOTION_STILL per pixel is noise: it keeps its
+ *    texture and validity with a zero vector.
+ *
+ ********************************************************/
+
+void GridEYEMotion::estimate(const int16_t *previous, const int16_t *current, GridEYEMotionVector *field,
+                             uint16_t minTexture)
+{
+  int16_t lowest = current[0];
+  int16_t highest = current[0];
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    if (current[i] < lowest)
+      lowest = current[i];
+    if (current[i] > highest)
+      highest = current[i];
+    if (previous[i] < lowest)
+      lowest = previous[i];
+    if (previous[i] > highest)
+      highest = previous[i];
+  }
+  // |S| is at most twice the span, |It| at most the span
+  int32_t span = 2 * ((int32_t)highest - lowest);
+  uint8_t shift = 0;
+  while ((span >> shift) > GRADIENT_LIMIT)
+    shift++;
+
+  for (uint8_t cy = 0; cy < GRIDEYE_MOTION_GRID; cy++)
+  {
+    int8_t y0 = (cy == 0) ? 0 : (int8_t)(2 * cy - 1);
+    int8_t y1 = (cy == GRIDEYE_MOTION_GRID - 1) ? 7 : (int8_t)(2 * cy + 2);
+    for (uint8_t cx = 0; cx < GRIDEYE_MOTION_GRID; cx++)
+    {
+      int8_t x0 = (cx == 0) ? 0 : (int8_t)(2 * cx - 1);
+      int8_t x1 = (cx == GRIDEYE_MOTION_GRID - 1) ? 7 : (int8_t)(2 * cx + 2);
+      GridEYEMotionVector *vector = &field[cy * GRIDEYE_MOTION_GRID + cx];
+
+      // Whole pixels. The first offset tried is none.
+      int8_t bestX = 0;
+      int8_t bestY = 0;
+      uint32_t bestSad = 0xFFFFFFFF;
+      uint32_t stillSad = (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1) * GRIDEYE_MOTION_STILL;
+      bool still = false;
+      for (uint8_t o = 0; o < SEARCH_OFFSETS; o++)
+      {
+        int8_t ox = searchOffsets[o][0];
+        int8_t oy = searchOffsets[o][1];
+        uint32_t sad = 0;
+        for (int8_t y = y0; (y <= y1) && (sad < bestSad); y++)
+        {
+          for (int8_t x = x0; x <= x1; x++)
+            sad += abs16(current[(y << 3) + x] - pixelAt(previous, x - ox, y - oy));
+        }
+        if (sad < bestSad)
+        {
+          bestSad = sad;
+          bestX = ox;
+          bestY = oy;
+          if (sad == 0)
+            break;
+        }
+        if ((o == 0) && (sad <= stillSad))
+        {
+          still = true;
+          break;
+        }
+      }
+
+      // Sub-pixel
+      int32_t sxx = 0, sxy = 0, syy = 0, sxt = 0, syt = 0;
+      for (int8_t y = y0; y <= y1; y++)
+      {
+        for (int8_t x = x0; x <= x1; x++)
+        {
+          int8_t px = x - bestX;
+          int8_t py = y - bestY;
+          int16_t sx = pixelAt(previous, px + 1, py) - pixelAt(previous, px - 1, py) + pixelAt(current, x + 1, y) -
+                       pixelAt(current, x - 1, y);
+          int16_t sy = pixelAt(previous, px, py + 1) - pixelAt(previous, px, py - 1) + pixelAt(current, x, y + 1) -
+                       pixelAt(current, x, y - 1);
+          int16_t it = current[(y << 3) + x] - pixelAt(previous, px, py);
+          sx >>= shift;
+          sy >>= shift;
+          it >>= shift;
+          sxx += (int32_t)sx * sx;
+          sxy += (int32_t)sx * sy;
+          syy += (int32_t)sy * sy;
+          sxt += (int32_t)sx * it;
+          syt += (int32_t)sy * it;
+        }
+      }
+
+      int64_t det = (int64_t)sxx * syy - (int64_t)sxy * sxy;
+      int32_t trace = sxx + syy;
+      uint32_t texture = 0;
+      if ((det > 0) && (trace > 0))
+      {
+        // S is four times the gradient, so its products sixteen times
+        texture = (uint32_t)(((det << (2 * shift)) / trace) >> 4);
+        if (texture > 0xFFFF)
+          texture = 0xFFFF;
+      }
+      vector->texture = (uint16_t)texture;
+      vector->valid = (texture >= minTexture) && (texture > 0);
+      if (!vector->valid || still)
+      {
+        vector->dx = 0;
+        vector->dy = 0;
+        continue;
+      }
+
+      int32_t fineX = divideRounded(-4 * GRIDEYE_MOTION_ONE * ((int64_t)syy * sxt - (int64_t)sxy * syt), det);
+      int32_t fineY = divideRounded(-4 * GRIDEYE_MOTION_ONE * ((int64_t)sxx * syt - (int64_t)sxy * sxt), det);
+      // Past a pixel the linear model no longer holds; the search should have caught it
+      if (fineX > GRIDEYE_MOTION_ONE)
+        fineX = GRIDEYE_MOTION_ONE;
+      else if (fineX < -GRIDEYE_MOTION_ONE)
+        fineX = -GRIDEYE_MOTION_ONE;
+      if (fineY > GRIDEYE_MOTION_ONE)
+        fineY = GRIDEYE_MOTION_ONE;
+      else if (fineY < -GRIDEYE_MOTION_ONE)
+        fineY = -GRIDEYE_MOTION_ONE;
+      vector->dx = (int16_t)(bestX * GRIDEYE_MOTION_ONE + fineX);
+      vector->dy = (int16_t)(bestY * GRIDEYE_MOTION_ONE + fineY);
+    }
+  }
+}
+
+/********************************************************
+ * Dominant flow
+ ********************************************************
+ *
+ * isMoving() - valid and at least minSpeed along either
+ *    axis
+ *
+ * sector() - octant by comparing the components against
+ *    tan(22.5 degrees), no trigonometry
+ *
+ * dominant() - valid vectors at least minSpeed long vote
+ *    for their sector. The three neighbouring sectors with
+ *    the most votes win, so a flow on a sector boundary is
+ *    not split; their vectors are averaged. A lone vector
+ *    is more likely noise than a person, who covers several
+ *    overlapping windows.
+ *
+ ********************************************************/
+
+bool GridEYEMotion::isMoving(const GridEYEMotionVector &vector, int16_t minSpeed)
+{
+  if (!vector.valid)
+    return false;
+  int16_t longest = abs16(vector.dx) > abs16(vector.dy) ? abs16(vector.dx) : abs16(vector.dy);
+  return longest >= minSpeed;
+}
+
+uint8_t GridEYEMotion::sector(int16_t dx, int16_t dy)
+{
+  int32_t ax = abs16(dx);
+  int32_t ay = abs16(dy);
+  if (ay * 256 <= ax * TAN_22_5)
+    return (dx >= 0) ? 0 : 4;
+  if (ax * 256 <= ay * TAN_22_5)
+    return (dy >= 0) ? 2 : 6;
+  if (dx >= 0)
+    return (dy >= 0) ? 1 : 7;
+  return (dy >= 0) ? 3 : 5;
+}
+
+uint8_t GridEYEMotion::dominant(const GridEYEMotionVector *field, int16_t minSpeed, int16_t *dx, int16_t *dy)
+{
+  uint8_t votes[8] = {0};
+  uint8_t sectors[GRIDEYE_MOTION_VECTORS];
+  for (uint8_t i = 0; i < GRIDEYE_MOTION_VECTORS; i++)
+  {
+    sectors[i] = GRIDEYE_MOTION_NONE;
+    if (!isMoving(field[i], minSpeed))
+      continue;
+    sectors[i] = sector(field[i].dx, field[i].dy);
+    votes[sectors[i]]++;
+  }
+
+  uint8_t best = 0;
+  uint8_t bestVotes = 0;
+  for (uint8_t s = 0; s < 8; s++)
+  {
+    uint8_t around = votes[(s + 7) & 7] + votes[s] + votes[(s + 1) & 7];
+    if (around > bestVotes)
+    {
+      bestVotes = around;
+      best = s;
+    }
+  }
+  if (bestVotes < GRIDEYE_MOTION_MIN_VOTES)
+    bestVotes = 0;
+
+  int32_t sumX = 0;
+  int32_t sumY = 0;
+  for (uint8_t i = 0; (i < GRIDEYE_MOTION_VECTORS) && (bestVotes > 0); i++)
+  {
+    if ((sectors[i] == best) || (sectors[i] == ((best + 1) & 7)) || (sectors[i] == ((best + 7) & 7)))
+    {
+      sumX += field[i].dx;
+      sumY += field[i].dy;
+    }
+  }
+  *dx = (bestVotes > 0) ? (int16_t)divideRounded(sumX, bestVotes) : 0;
+  *dy = (bestVotes > 0) ? (int16_t)divideRounded(sumY, bestVotes) : 0;
+  return bestVotes;
+}
+
+/********************************************************
+ * Results
+ ********************************************************/
+
+const GridEYEMotionVector *GridEYEMotion::getField()
+{
+  return _field;
+}
+
+GridEYEMotionVector GridEYEMotion::getVector(uint8_t x, uint8_t y)
+{
+  if ((x >= GRIDEYE_MOTION_GRID) || (y >= GRIDEYE_MOTION_GRID))
+  {
+    GridEYEMotionVector none = {0, 0, 0, false};
+    return none;
+  }
+  return _field[y * GRIDEYE_MOTION_GRID + x];
+}
+
+void GridEYEMotion::getDominant(int16_t *dx, int16_t *dy)
+{
+  *dx = _dominantX;
+  *dy = _dominantY;
+}
+
+uint8_t GridEYEMotion::getDirection()
+{
+  if (_votes == 0)
+    return GRIDEYE_MOTION_NONE;
+  return sector(_dominantX, _dominantY);
+}
+
+uint8_t GridEYEMotion::getMovingCount()
+{
+  return _moving;
+}
+
+uint8_t GridEYEMotion::getDominantVotes()
+{
+  return _votes;
+}
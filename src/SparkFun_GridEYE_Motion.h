@@ -0,0 +1,114 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Motion vectors between consecutive GridEYE frames.
+
+  The frame is split into a 4x4 grid of 2x2 pixel cells. Each cell's
+  vector is measured over the 4x4 pixel window centered on it (3 wide
+  at the frame edges):
+    1. Block matching: the whole pixel offset, up to
+       GRIDEYE_MOTION_RANGE each way, with the smallest sum of absolute
+       differences between the window and the previous frame. Offsets
+       are tried nearest first, so ties keep the smaller motion.
+    2. One Lucas-Kanade step on what is left: with the previous frame
+       shifted by that offset, the least squares sub-pixel shift from
+       the window's gradients and frame difference, up to one pixel.
+  Vectors are Q8 (GRIDEYE_MOTION_ONE = one pixel per frame), x to the
+  right and y down, pointing the way the scene moved.
+
+  A window with too little texture (flat background, or an edge that
+  only shows motion across it) gives no reliable vector and is marked
+  invalid. The dominant flow is what most moving cells agree on: cells
+  vote by direction in 8 sectors, the best run of three neighbouring
+  sectors wins and its vectors are averaged. Two people walking apart
+  give the flow of the larger one rather than cancelling out.
+
+  All integer: sums are 32-bit with values scaled to 10 bits first when
+  a frame spans more than that (over 128C), and the 16 small 2x2
+  solves use 64-bit. At most 4900 absolute differences per frame; well
+  under a millisecond on a Cortex-M4.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define GRIDEYE_MOTION_GRID 4 // Vectors per row and per column
+#define GRIDEYE_MOTION_VECTORS (GRIDEYE_MOTION_GRID * GRIDEYE_MOTION_GRID)
+#define GRIDEYE_MOTION_RANGE 2 // Whole pixels searched each way
+#define GRIDEYE_MOTION_ONE 256 // Q8, one pixel per frame
+
+#define GRIDEYE_MOTION_MIN_TEXTURE 16 // Default, in squared quarter degrees per pixel
+#define GRIDEYE_MOTION_MIN_SPEED 32   // Default, Q8: an eighth of a pixel per frame
+#define GRIDEYE_MOTION_STILL 1        // Mean absolute difference per pixel taken as noise
+#define GRIDEYE_MOTION_MIN_VOTES 2    // Moving vectors needed for a dominant flow
+
+#define GRIDEYE_MOTION_NONE 0xFF // getDirection() when nothing moves
+
+struct GridEYEMotionVector
+{
+  int16_t dx; // Q8 pixels per frame
+  int16_t dy;
+  uint16_t texture; // Smaller eigenvalue of the window's gradient matrix, saturated
+  bool valid;
+};
+
+class GridEYEMotion
+{
+public:
+  GridEYEMotion();
+
+  void reset(); // Forget the previous frame
+
+  // Windows whose gradient matrix has a smaller eigenvalue under this are invalid
+  void setMinTexture(uint16_t minTexture);
+  // Vectors shorter than this (Q8) don't count as moving
+  void setMinSpeed(int16_t minSpeed);
+
+  // Feed sign-extended frames in order. Returns true once there is a field,
+  // from the second frame on.
+  bool update(const int16_t *frame);
+
+  const GridEYEMotionVector *getField(); // GRIDEYE_MOTION_VECTORS, row by row
+  GridEYEMotionVector getVector(uint8_t x, uint8_t y);
+
+  void getDominant(int16_t *dx, int16_t *dy); // Q8, 0 when nothing moves
+  uint8_t getDirection();                     // Sector of the dominant flow, or GRIDEYE_MOTION_NONE
+  uint8_t getMovingCount();                   // Valid vectors at least the minimum speed
+  uint8_t getDominantVotes();                 // Of those, the ones averaged into the dominant flow
+
+  // Kernels. field holds GRIDEYE_MOTION_VECTORS.
+  static void estimate(const int16_t *previous, const int16_t *current, GridEYEMotionVector *field,
+                       uint16_t minTexture = GRIDEYE_MOTION_MIN_TEXTURE);
+  // Returns the number of vectors that voted; dx, dy get 0 if too few did
+  static uint8_t dominant(const GridEYEMotionVector *field, int16_t minSpeed, int16_t *dx, int16_t *dy);
+  // 0 is +x, counting 45 degree steps toward +y (down): 2 is down, 4 is -x, 6 is up
+  static uint8_t sector(int16_t dx, int16_t dy);
+  static bool isMoving(const GridEYEMotionVector &vector, int16_t minSpeed);
+
+private:
+  int16_t _previous[64];
+  bool _havePrevious;
+  uint16_t _minTexture;
+  int16_t _minSpeed;
+
+  GridEYEMotionVector _field[GRIDEYE_MOTION_VECTORS];
+  int16_t _dominantX;
+  int16_t _dominantY;
+  uint8_t _votes;
+  uint8_t _moving;
+};
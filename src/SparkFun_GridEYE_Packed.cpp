@@ -0,0 +1,325 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  12-bit and delta packed GridEYE frames.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "SparkFun_GridEYE_Packed.h"
+#include "SparkFun_GridEYE_Filters.h"
+
+#define PIXEL_MIN -2048
+#define PIXEL_MAX 2047
+
+static inline int16_t signExtend12(uint16_t val)
+{
+  return (int16_t)((val ^ 0x0800) & 0x0FFF) - 0x0800;
+}
+
+/********************************************************
+ * 12-bit
+ ********************************************************
+ *
+ * Pixels 2n and 2n+1 share bytes 3n to 3n+2, low bits
+ * first:
+ *
+ *   byte 3n     pixel 2n bits 0-7
+ *   byte 3n+1   pixel 2n bits 8-11, pixel 2n+1 bits 0-3
+ *   byte 3n+2   pixel 2n+1 bits 4-11
+ *
+ ********************************************************/
+
+uint8_t GridEYEPacked::pack(const int16_t *frame, uint8_t *packed)
+{
+  uint8_t clamped = 0;
+  for (uint8_t i = 0; i < 64; i += 2)
+  {
+    int16_t a = frame[i];
+    int16_t b = frame[i + 1];
+    if ((a < PIXEL_MIN) || (a > PIXEL_MAX))
+    {
+      a = (a < PIXEL_MIN) ? PIXEL_MIN : PIXEL_MAX;
+      clamped++;
+    }
+    if ((b < PIXEL_MIN) || (b > PIXEL_MAX))
+    {
+      b = (b < PIXEL_MIN) ? PIXEL_MIN : PIXEL_MAX;
+      clamped++;
+    }
+    packed[0] = (uint8_t)a;
+    packed[1] = (uint8_t)(((uint16_t)a >> 8) & 0x0F) | (uint8_t)((uint16_t)b << 4);
+    packed[2] = (uint8_t)((uint16_t)b >> 4);
+    packed += 3;
+  }
+  return clamped;
+}
+
+void GridEYEPacked::unpack(const uint8_t *packed, int16_t *frame)
+{
+  for (uint8_t i = 0; i < 64; i += 2)
+  {
+    frame[i] = signExtend12(packed[0] | ((uint16_t)packed[1] << 8));
+    frame[i + 1] = signExtend12((packed[1] >> 4) | ((uint16_t)packed[2] << 4));
+    packed += 3;
+  }
+}
+
+void GridEYEPacked::unpackPadded(const uint8_t *packed, int16_t *padded)
+{
+  for (uint8_t y = 0; y < 8; y++)
+  {
+    int16_t *row = &padded[GRIDEYE_PADDED_INDEX(0, y)];
+    for (uint8_t x = 0; x < 8; x += 2)
+    {
+      row[x] = signExtend12(packed[0] | ((uint16_t)packed[1] << 8));
+      row[x + 1] = signExtend12((packed[1] >> 4) | ((uint16_t)packed[2] << 4));
+      packed += 3;
+    }
+  }
+  GridEYEFilter::refreshBorder(padded);
+}
+
+int16_t GridEYEPacked::getPixel(const uint8_t *packed, uint8_t pixelAddr)
+{
+  const uint8_t *pair = &packed[(pixelAddr >> 1) * 3];
+  if (pixelAddr & 1)
+    return signExtend12((pair[1] >> 4) | ((uint16_t)pair[2] << 4));
+  return signExtend12(pair[0] | ((uint16_t)pair[1] << 8));
+}
+
+/********************************************************
+ * Delta
+ ********************************************************
+ *
+ * 64 signed delta bytes, then GRIDEYE_DELTA_ESCAPES
+ * little endian int16 values. A delta byte of
+ * GRIDEYE_DELTA_ESCAPE takes the next escape slot; unused
+ * slots are zero so equal frames pack to equal bytes.
+ *
+ * packDelta() - once the slots are used up, further far
+ *    pixels get the largest delta with their sign
+ *
+ ********************************************************/
+
+uint8_t GridEYEPacked::packDelta(const int16_t *frame, const int16_t *baseline, uint8_t *packed)
+{
+  uint8_t *escapes = &packed[64];
+  uint8_t used = 0;
+  uint8_t clamped = 0;
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    int32_t delta = (int32_t)frame[i] - baseline[i];
+    if ((delta >= -127) && (delta <= 127))
+    {
+      packed[i] = (uint8_t)(int8_t)delta;
+    }
+    else if (used < GRIDEYE_DELTA_ESCAPES)
+    {
+      packed[i] = (uint8_t)(int8_t)GRIDEYE_DELTA_ESCAPE;
+      escapes[2 * used] = (uint8_t)frame[i];
+      escapes[2 * used + 1] = (uint8_t)((uint16_t)frame[i] >> 8);
+      used++;
+    }
+    else
+    {
+      packed[i] = (uint8_t)(int8_t)((delta < 0) ? -127 : 127);
+      clamped++;
+    }
+  }
+  memset(&escapes[2 * used], 0, 2 * (GRIDEYE_DELTA_ESCAPES - used));
+  return clamped;
+}
+
+void GridEYEPacked::unpackDelta(const uint8_t *packed, const int16_t *baseline, int16_t *frame)
+{
+  const uint8_t *escape = &packed[64];
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    int8_t delta = (int8_t)packed[i];
+    if (delta != GRIDEYE_DELTA_ESCAPE)
+    {
+      frame[i] = baseline[i] + delta;
+    }
+    else
+    {
+      frame[i] = (int16_t)(escape[0] | ((uint16_t)escape[1] << 8));
+      escape += 2;
+    }
+  }
+}
+
+void GridEYEPacked::unpackDeltaPadded(const uint8_t *packed, const int16_t *baseline, int16_t *padded)
+{
+  const uint8_t *escape = &packed[64];
+  for (uint8_t y = 0; y < 8; y++)
+  {
+    int16_t *row = &padded[GRIDEYE_PADDED_INDEX(0, y)];
+    for (uint8_t x = 0; x < 8; x++)
+    {
+      int8_t delta = (int8_t)packed[(y << 3) + x];
+      if (delta != GRIDEYE_DELTA_ESCAPE)
+      {
+        row[x] = baseline[(y << 3) + x] + delta;
+      }
+      else
+      {
+        row[x] = (int16_t)(escape[0] | ((uint16_t)escape[1] << 8));
+        escape += 2;
+      }
+    }
+  }
+  GridEYEFilter::refreshBorder(padded);
+}
+
+int16_t GridEYEPacked::getDeltaPixel(const uint8_t *packed, const int16_t *baseline, uint8_t pixelAddr)
+{
+  int8_t delta = (int8_t)packed[pixelAddr];
+  if (delta != GRIDEYE_DELTA_ESCAPE)
+    return baseline[pixelAddr] + delta;
+
+  uint8_t slot = 0;
+  for (uint8_t i = 0; i < pixelAddr; i++)
+  {
+    if ((int8_t)packed[i] == GRIDEYE_DELTA_ESCAPE)
+      slot++;
+  }
+  const uint8_t *escape = &packed[64 + 2 * slot];
+  return (int16_t)(escape[0] | ((uint16_t)escape[1] << 8));
+}
+
+/********************************************************
+ * Ring
+ ********************************************************/
+
+GridEYEFrameRing::GridEYEFrameRing()
+{
+  _buffer = NULL;
+  _baseline = NULL;
+  _slotBytes = GRIDEYE_PACKED_BYTES;
+  _capacity = 0;
+  clear();
+}
+
+void GridEYEFrameRing::begin(uint8_t *buffer, size_t bytes)
+{
+  _buffer = buffer;
+  _baseline = NULL;
+  _slotBytes = GRIDEYE_PACKED_BYTES;
+  _capacity = (buffer == NULL) ? 0 : (uint16_t)(bytes / GRIDEYE_PACKED_BYTES);
+  clear();
+}
+
+void GridEYEFrameRing::begin(uint8_t *buffer, size_t bytes, const int16_t *baseline)
+{
+  if (baseline == NULL)
+  {
+    begin(buffer, bytes);
+    return;
+  }
+  _buffer = buffer;
+  _baseline = baseline;
+  _slotBytes = GRIDEYE_DELTA_BYTES;
+  _capacity = (buffer == NULL) ? 0 : (uint16_t)(bytes / GRIDEYE_DELTA_BYTES);
+  clear();
+}
+
+void GridEYEFrameRing::clear()
+{
+  _count = 0;
+  _next = 0;
+}
+
+uint8_t GridEYEFrameRing::push(const int16_t *frame)
+{
+  if (_capacity == 0)
+    return 0;
+
+  uint8_t *slot = &_buffer[(size_t)_next * _slotBytes];
+  uint8_t clamped;
+  if (_baseline == NULL)
+    clamped = GridEYEPacked::pack(frame, slot);
+  else
+    clamped = GridEYEPacked::packDelta(frame, _baseline, slot);
+
+  _next++;
+  if (_next == _capacity)
+    _next = 0;
+  if (_count < _capacity)
+    _count++;
+  return clamped;
+}
+
+uint16_t GridEYEFrameRing::getCount()
+{
+  return _count;
+}
+
+uint16_t GridEYEFrameRing::getCapacity()
+{
+  return _capacity;
+}
+
+bool GridEYEFrameRing::isDelta()
+{
+  return (_baseline != NULL);
+}
+
+const uint8_t *GridEYEFrameRing::getSlot(uint16_t age)
+{
+  if (age >= _count)
+    return NULL;
+  uint16_t index = (_next > age) ? (_next - 1 - age) : (_capacity + _next - 1 - age);
+  return &_buffer[(size_t)index * _slotBytes];
+}
+
+bool GridEYEFrameRing::getFrame(uint16_t age, int16_t *frame)
+{
+  const uint8_t *slot = getSlot(age);
+  if (slot == NULL)
+    return false;
+  if (_baseline == NULL)
+    GridEYEPacked::unpack(slot, frame);
+  else
+    GridEYEPacked::unpackDelta(slot, _baseline, frame);
+  return true;
+}
+
+bool GridEYEFrameRing::getFramePadded(uint16_t age, int16_t *padded)
+{
+  const uint8_t *slot = getSlot(age);
+  if (slot == NULL)
+    return false;
+  if (_baseline == NULL)
+    GridEYEPacked::unpackPadded(slot, padded);
+  else
+    GridEYEPacked::unpackDeltaPadded(slot, _baseline, padded);
+  return true;
+}
+
+int16_t GridEYEFrameRing::getPixel(uint16_t age, uint8_t pixelAddr)
+{
+  const uint8_t *slot = getSlot(age);
+  if ((slot == NULL) || (pixelAddr >= 64))
+    return 0;
+  if (_baseline == NULL)
+    return GridEYEPacked::getPixel(slot, pixelAddr);
+  return GridEYEPacked::getDeltaPixel(slot, _baseline, pixelAddr);
+}
@@ -0,0 +1,105 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Packed storage for buffered GridEYE frames.
+
+  A decoded frame is 128 bytes of int16, but the sensor only has 12
+  bits per pixel. Two formats keep frames smaller, for history buffers
+  and rings:
+    - 12-bit, GRIDEYE_PACKED_BYTES (96): two pixels in three bytes,
+      lossless for anything the sensor reads. Values past 12 bits (a
+      calibration or drift correction can push them there) are clamped.
+      One third more frames in the same memory.
+    - Delta, GRIDEYE_DELTA_BYTES (80): one signed byte per pixel, the
+      difference from a baseline frame the caller keeps, e.g. the
+      background. Up to +-31.75C from the baseline is exact. Further
+      out the byte is an escape and the full value goes in one of
+      GRIDEYE_DELTA_ESCAPES two-byte slots after the deltas, in pixel
+      order; any more are clamped to the nearest delta. 60% more
+      frames in the same memory.
+  Pack functions return how many pixels were clamped, 0 when the frame
+  comes back exactly.
+
+  Single pixels can be read in place: 12-bit is three byte loads, a
+  delta pixel counts the escapes before it only when it is one. Bulk
+  unpack writes either the plain layout or GridEYEFilter's padded
+  layout, border filled, ready for the filter and motion kernels.
+
+  GridEYEFrameRing keeps the newest frames in a caller owned buffer in
+  either format: 2 KB holds 21 12-bit frames or 25 delta frames,
+  against 16 unpacked.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define GRIDEYE_PACKED_BYTES 96 // 64 x 12 bits
+#define GRIDEYE_DELTA_ESCAPES 8
+#define GRIDEYE_DELTA_BYTES (64 + 2 * GRIDEYE_DELTA_ESCAPES)
+#define GRIDEYE_DELTA_ESCAPE (-128) // Delta byte meaning "see the escape slots"
+
+class GridEYEPacked
+{
+public:
+  // 12-bit. packed holds GRIDEYE_PACKED_BYTES.
+  static uint8_t pack(const int16_t *frame, uint8_t *packed);
+  static void unpack(const uint8_t *packed, int16_t *frame);
+  static void unpackPadded(const uint8_t *packed, int16_t *padded); // GRIDEYE_PADDED_SIZE, border filled
+  static int16_t getPixel(const uint8_t *packed, uint8_t pixelAddr);
+
+  // Delta to baseline. packed holds GRIDEYE_DELTA_BYTES.
+  static uint8_t packDelta(const int16_t *frame, const int16_t *baseline, uint8_t *packed);
+  static void unpackDelta(const uint8_t *packed, const int16_t *baseline, int16_t *frame);
+  static void unpackDeltaPadded(const uint8_t *packed, const int16_t *baseline, int16_t *padded);
+  static int16_t getDeltaPixel(const uint8_t *packed, const int16_t *baseline, uint8_t pixelAddr);
+};
+
+class GridEYEFrameRing
+{
+public:
+  GridEYEFrameRing();
+
+  // buffer belongs to the caller and holds bytes / GRIDEYE_PACKED_BYTES 12-bit frames
+  void begin(uint8_t *buffer, size_t bytes);
+  // Delta frames of GRIDEYE_DELTA_BYTES. baseline belongs to the caller; frames
+  // already stored read back against whatever it holds now.
+  void begin(uint8_t *buffer, size_t bytes, const int16_t *baseline);
+
+  void clear();
+
+  // Stores a frame, dropping the oldest when full. Returns the pixels clamped.
+  uint8_t push(const int16_t *frame);
+
+  uint16_t getCount();
+  uint16_t getCapacity();
+  bool isDelta();
+
+  // age 0 is the newest. Return false past getCount().
+  bool getFrame(uint16_t age, int16_t *frame);
+  bool getFramePadded(uint16_t age, int16_t *padded);
+  int16_t getPixel(uint16_t age, uint8_t pixelAddr); // 0 past getCount()
+  const uint8_t *getSlot(uint16_t age);              // Packed bytes in place, NULL past getCount()
+
+private:
+  uint8_t *_buffer;
+  const int16_t *_baseline; // NULL for 12-bit slots
+  uint8_t _slotBytes;
+  uint16_t _capacity;
+  uint16_t _count;
+  uint16_t _next; // Slot the next push goes to
+};
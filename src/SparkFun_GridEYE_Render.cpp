@@ -0,0 +1,522 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  False color rendering of GridEYE frames.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "SparkFun_GridEYE_Render.h"
+
+// Palettes are 256 RGB888 entries in flash. Ironbow is a linear blend through
+// black, (32,0,140), (180,0,155), (235,80,30), (255,190,0) and (255,255,230) at
+// levels 0, 38, 102, 153, 204 and 255. Rainbow is full saturation and brightness
+// from hue 240 (blue) down to hue 0 (red).
+static const uint8_t ironbowPalette[256 * 3] PROGMEM = {
+    0,   0,   0,   1,   0,   4,   2,   0,   7,   3,   0,  11,
+    3,   0,  15,   4,   0,  18,   5,   0,  22,   6,   0,  26,
+    7,   0,  29,   8,   0,  33,   8,   0,  37,   9,   0,  40,
+   10,   0,  44,  11,   0,  48,  12,   0,  51,  13,   0,  55,
+   13,   0,  59,  14,   0,  62,  15,   0,  66,  16,   0,  70,
+   17,   0,  73,  18,   0,  77,  18,   0,  81,  19,   0,  84,
+   20,   0,  88,  21,   0,  92,  22,   0,  95,  23,   0,  99,
+   23,   0, 102,  24,   0, 106,  25,   0, 110,  26,   0, 113,
+   27,   0, 117,  28,   0, 121,  28,   0, 124,  29,   0, 128,
+   30,   0, 132,  31,   0, 135,  32,   0, 139,  34,   0, 140,
+   36,   0, 140,  38,   0, 141,  41,   0, 141,  43,   0, 141,
+   45,   0, 141,  48,   0, 142,  50,   0, 142,  52,   0, 142,
+   55,   0, 142,  57,   0, 143,  59,   0, 143,  62,   0, 143,
+   64,   0, 143,  66,   0, 143,  69,   0, 144,  71,   0, 144,
+   73,   0, 144,  76,   0, 144,  78,   0, 145,  80,   0, 145,
+   82,   0, 145,  85,   0, 145,  87,   0, 146,  89,   0, 146,
+   92,   0, 146,  94,   0, 146,  96,   0, 147,  99,   0, 147,
+  101,   0, 147, 103,   0, 147, 106,   0, 147, 108,   0, 148,
+  110,   0, 148, 113,   0, 148, 115,   0, 148, 117,   0, 149,
+  120,   0, 149, 122,   0, 149, 124,   0, 149, 127,   0, 150,
+  129,   0, 150, 131,   0, 150, 134,   0, 150, 136,   0, 151,
+  138,   0, 151, 141,   0, 151, 143,   0, 151, 145,   0, 151,
+  147,   0, 152, 150,   0, 152, 152,   0, 152, 154,   0, 152,
+  157,   0, 153, 159,   0, 153, 161,   0, 153, 164,   0, 153,
+  166,   0, 154, 168,   0, 154, 171,   0, 154, 173,   0, 154,
+  175,   0, 155, 178,   0, 155, 180,   0, 155, 181,   2, 153,
+  182,   3, 150, 183,   5, 148, 184,   6, 145, 185,   8, 143,
+  186,   9, 140, 188,  11, 138, 189,  13, 135, 190,  14, 133,
+  191,  16, 130, 192,  17, 128, 193,  19, 126, 194,  20, 123,
+  195,  22, 121, 196,  24, 118, 197,  25, 116, 198,  27, 113,
+  199,  28, 111, 200,  30, 108, 202,  31, 106, 203,  33, 104,
+  204,  35, 101, 205,  36,  99, 206,  38,  96, 207,  39,  94,
+  208,  41,  91, 209,  42,  89, 210,  44,  86, 211,  45,  84,
+  212,  47,  81, 213,  49,  79, 215,  50,  77, 216,  52,  74,
+  217,  53,  72, 218,  55,  69, 219,  56,  67, 220,  58,  64,
+  221,  60,  62, 222,  61,  59, 223,  63,  57, 224,  64,  55,
+  225,  66,  52, 226,  67,  50, 227,  69,  47, 229,  71,  45,
+  230,  72,  42, 231,  74,  40, 232,  75,  37, 233,  77,  35,
+  234,  78,  32, 235,  80,  30, 235,  82,  29, 236,  84,  29,
+  236,  86,  28, 237,  89,  28, 237,  91,  27, 237,  93,  26,
+  238,  95,  26, 238,  97,  25, 239,  99,  25, 239, 102,  24,
+  239, 104,  24, 240, 106,  23, 240, 108,  22, 240, 110,  22,
+  241, 112,  21, 241, 115,  21, 242, 117,  20, 242, 119,  19,
+  242, 121,  19, 243, 123,  18, 243, 125,  18, 244, 127,  17,
+  244, 130,  16, 244, 132,  16, 245, 134,  15, 245, 136,  15,
+  246, 138,  14, 246, 140,  14, 246, 143,  13, 247, 145,  12,
+  247, 147,  12, 248, 149,  11, 248, 151,  11, 248, 153,  10,
+  249, 155,   9, 249, 158,   9, 250, 160,   8, 250, 162,   8,
+  250, 164,   7, 251, 166,   6, 251, 168,   6, 251, 171,   5,
+  252, 173,   5, 252, 175,   4, 253, 177,   4, 253, 179,   3,
+  253, 181,   2, 254, 184,   2, 254, 186,   1, 255, 188,   1,
+  255, 190,   0, 255, 191,   5, 255, 193,   9, 255, 194,  14,
+  255, 195,  18, 255, 196,  23, 255, 198,  27, 255, 199,  32,
+  255, 200,  36, 255, 201,  41, 255, 203,  45, 255, 204,  50,
+  255, 205,  54, 255, 207,  59, 255, 208,  63, 255, 209,  68,
+  255, 210,  72, 255, 212,  77, 255, 213,  81, 255, 214,  86,
+  255, 215,  90, 255, 217,  95, 255, 218,  99, 255, 219, 104,
+  255, 221, 108, 255, 222, 113, 255, 223, 117, 255, 224, 122,
+  255, 226, 126, 255, 227, 131, 255, 228, 135, 255, 230, 140,
+  255, 231, 144, 255, 232, 149, 255, 233, 153, 255, 235, 158,
+  255, 236, 162, 255, 237, 167, 255, 238, 171, 255, 240, 176,
+  255, 241, 180, 255, 242, 185, 255, 244, 189, 255, 245, 194,
+  255, 246, 198, 255, 247, 203, 255, 249, 207, 255, 250, 212,
+  255, 251, 216, 255, 252, 221, 255, 254, 225, 255, 255, 230,
+};
+
+static const uint8_t rainbowPalette[256 * 3] PROGMEM = {
+    0,   0, 255,   0,   4, 255,   0,   8, 255,   0,  12, 255,
+    0,  16, 255,   0,  20, 255,   0,  24, 255,   0,  28, 255,
+    0,  32, 255,   0,  36, 255,   0,  40, 255,   0,  44, 255,
+    0,  48, 255,   0,  52, 255,   0,  56, 255,   0,  60, 255,
+    0,  64, 255,   0,  68, 255,   0,  72, 255,   0,  76, 255,
+    0,  80, 255,   0,  84, 255,   0,  88, 255,   0,  92, 255,
+    0,  96, 255,   0, 100, 255,   0, 104, 255,   0, 108, 255,
+    0, 112, 255,   0, 116, 255,   0, 120, 255,   0, 124, 255,
+    0, 128, 255,   0, 132, 255,   0, 136, 255,   0, 140, 255,
+    0, 144, 255,   0, 148, 255,   0, 152, 255,   0, 156, 255,
+    0, 160, 255,   0, 164, 255,   0, 168, 255,   0, 172, 255,
+    0, 176, 255,   0, 180, 255,   0, 184, 255,   0, 188, 255,
+    0, 192, 255,   0, 196, 255,   0, 200, 255,   0, 204, 255,
+    0, 208, 255,   0, 212, 255,   0, 216, 255,   0, 220, 255,
+    0, 224, 255,   0, 228, 255,   0, 232, 255,   0, 236, 255,
+    0, 240, 255,   0, 244, 255,   0, 248, 255,   0, 252, 255,
+    0, 255, 254,   0, 255, 250,   0, 255, 246,   0, 255, 242,
+    0, 255, 238,   0, 255, 234,   0, 255, 230,   0, 255, 226,
+    0, 255, 222,   0, 255, 218,   0, 255, 214,   0, 255, 210,
+    0, 255, 206,   0, 255, 202,   0, 255, 198,   0, 255, 194,
+    0, 255, 190,   0, 255, 186,   0, 255, 182,   0, 255, 178,
+    0, 255, 174,   0, 255, 170,   0, 255, 166,   0, 255, 162,
+    0, 255, 158,   0, 255, 154,   0, 255, 150,   0, 255, 146,
+    0, 255, 142,   0, 255, 138,   0, 255, 134,   0, 255, 130,
+    0, 255, 126,   0, 255, 122,   0, 255, 118,   0, 255, 114,
+    0, 255, 110,   0, 255, 106,   0, 255, 102,   0, 255,  98,
+    0, 255,  94,   0, 255,  90,   0, 255,  86,   0, 255,  82,
+    0, 255,  78,   0, 255,  74,   0, 255,  70,   0, 255,  66,
+    0, 255,  62,   0, 255,  58,   0, 255,  54,   0, 255,  50,
+    0, 255,  46,   0, 255,  42,   0, 255,  38,   0, 255,  34,
+    0, 255,  30,   0, 255,  26,   0, 255,  22,   0, 255,  18,
+    0, 255,  14,   0, 255,  10,   0, 255,   6,   0, 255,   2,
+    2, 255,   0,   6, 255,   0,  10, 255,   0,  14, 255,   0,
+   18, 255,   0,  22, 255,   0,  26, 255,   0,  30, 255,   0,
+   34, 255,   0,  38, 255,   0,  42, 255,   0,  46, 255,   0,
+   50, 255,   0,  54, 255,   0,  58, 255,   0,  62, 255,   0,
+   66, 255,   0,  70, 255,   0,  74, 255,   0,  78, 255,   0,
+   82, 255,   0,  86, 255,   0,  90, 255,   0,  94, 255,   0,
+   98, 255,   0, 102, 255,   0, 106, 255,   0, 110, 255,   0,
+  114, 255,   0, 118, 255,   0, 122, 255,   0, 126, 255,   0,
+  130, 255,   0, 134, 255,   0, 138, 255,   0, 142, 255,   0,
+  146, 255,   0, 150, 255,   0, 154, 255,   0, 158, 255,   0,
+  162, 255,   0, 166, 255,   0, 170, 255,   0, 174, 255,   0,
+  178, 255,   0, 182, 255,   0, 186, 255,   0, 190, 255,   0,
+  194, 255,   0, 198, 255,   0, 202, 255,   0, 206, 255,   0,
+  210, 255,   0, 214, 255,   0, 218, 255,   0, 222, 255,   0,
+  226, 255,   0, 230, 255,   0, 234, 255,   0, 238, 255,   0,
+  242, 255,   0, 246, 255,   0, 250, 255,   0, 254, 255,   0,
+  255, 252,   0, 255, 248,   0, 255, 244,   0, 255, 240,   0,
+  255, 236,   0, 255, 232,   0, 255, 228,   0, 255, 224,   0,
+  255, 220,   0, 255, 216,   0, 255, 212,   0, 255, 208,   0,
+  255, 204,   0, 255, 200,   0, 255, 196,   0, 255, 192,   0,
+  255, 188,   0, 255, 184,   0, 255, 180,   0, 255, 176,   0,
+  255, 172,   0, 255, 168,   0, 255, 164,   0, 255, 160,   0,
+  255, 156,   0, 255, 152,   0, 255, 148,   0, 255, 144,   0,
+  255, 140,   0, 255, 136,   0, 255, 132,   0, 255, 128,   0,
+  255, 124,   0, 255, 120,   0, 255, 116,   0, 255, 112,   0,
+  255, 108,   0, 255, 104,   0, 255, 100,   0, 255,  96,   0,
+  255,  92,   0, 255,  88,   0, 255,  84,   0, 255,  80,   0,
+  255,  76,   0, 255,  72,   0, 255,  68,   0, 255,  64,   0,
+  255,  60,   0, 255,  56,   0, 255,  52,   0, 255,  48,   0,
+  255,  44,   0, 255,  40,   0, 255,  36,   0, 255,  32,   0,
+  255,  28,   0, 255,  24,   0, 255,  20,   0, 255,  16,   0,
+  255,  12,   0, 255,   8,   0, 255,   4,   0, 255,   0,   0,
+};
+
+// The same palettes packed to RGB565, so a row costs one flash read per pixel
+static const uint16_t ironbowPalette565[256] PROGMEM = {
+  0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0002, 0x0002, 0x0003,
+  0x0003, 0x0804, 0x0804, 0x0805, 0x0805, 0x0806, 0x0806, 0x0806,
+  0x0807, 0x0807, 0x0808, 0x1008, 0x1009, 0x1009, 0x100A, 0x100A,
+  0x100B, 0x100B, 0x100B, 0x100C, 0x100C, 0x180D, 0x180D, 0x180E,
+  0x180E, 0x180F, 0x180F, 0x1810, 0x1810, 0x1810, 0x2011, 0x2011,
+  0x2011, 0x2011, 0x2811, 0x2811, 0x2811, 0x3011, 0x3011, 0x3011,
+  0x3011, 0x3811, 0x3811, 0x3811, 0x4011, 0x4011, 0x4012, 0x4012,
+  0x4812, 0x4812, 0x4812, 0x5012, 0x5012, 0x5012, 0x5012, 0x5812,
+  0x5812, 0x5812, 0x6012, 0x6012, 0x6012, 0x6012, 0x6812, 0x6812,
+  0x6812, 0x7012, 0x7012, 0x7012, 0x7812, 0x7812, 0x7812, 0x7812,
+  0x8012, 0x8012, 0x8012, 0x8812, 0x8812, 0x8812, 0x8812, 0x9012,
+  0x9013, 0x9013, 0x9813, 0x9813, 0x9813, 0x9813, 0xA013, 0xA013,
+  0xA013, 0xA813, 0xA813, 0xA813, 0xA813, 0xB013, 0xB013, 0xB013,
+  0xB012, 0xB032, 0xB832, 0xB851, 0xB851, 0xB851, 0xB870, 0xB870,
+  0xB890, 0xC090, 0xC08F, 0xC0AF, 0xC0AF, 0xC0CE, 0xC0CE, 0xC0CE,
+  0xC0ED, 0xC8ED, 0xC8ED, 0xC90D, 0xC90C, 0xC92C, 0xC92C, 0xC92B,
+  0xD14B, 0xD14B, 0xD16A, 0xD16A, 0xD16A, 0xD189, 0xD189, 0xD9A9,
+  0xD9A9, 0xD9A8, 0xD9C8, 0xD9C8, 0xD9E7, 0xD9E7, 0xD9E7, 0xE206,
+  0xE206, 0xE206, 0xE225, 0xE225, 0xE245, 0xE245, 0xEA44, 0xEA64,
+  0xEA64, 0xEA83, 0xEA83, 0xEAA3, 0xEAA3, 0xEAC3, 0xEAC3, 0xEAE3,
+  0xEAE3, 0xEB03, 0xEB03, 0xEB23, 0xEB43, 0xF342, 0xF362, 0xF362,
+  0xF382, 0xF382, 0xF3A2, 0xF3A2, 0xF3C2, 0xF3C2, 0xF3E2, 0xF3E2,
+  0xF402, 0xF422, 0xF421, 0xF441, 0xF441, 0xF461, 0xF461, 0xF481,
+  0xF481, 0xFCA1, 0xFCA1, 0xFCC1, 0xFCC1, 0xFCE1, 0xFD01, 0xFD01,
+  0xFD20, 0xFD20, 0xFD40, 0xFD40, 0xFD60, 0xFD60, 0xFD80, 0xFD80,
+  0xFDA0, 0xFDC0, 0xFDC0, 0xFDE0, 0xFDE0, 0xFDE0, 0xFE01, 0xFE01,
+  0xFE02, 0xFE22, 0xFE23, 0xFE24, 0xFE44, 0xFE45, 0xFE45, 0xFE66,
+  0xFE66, 0xFE67, 0xFE87, 0xFE88, 0xFE89, 0xFEA9, 0xFEAA, 0xFEAA,
+  0xFEAB, 0xFECB, 0xFECC, 0xFECD, 0xFEED, 0xFEEE, 0xFEEE, 0xFF0F,
+  0xFF0F, 0xFF10, 0xFF30, 0xFF31, 0xFF32, 0xFF52, 0xFF53, 0xFF53,
+  0xFF74, 0xFF74, 0xFF75, 0xFF96, 0xFF96, 0xFF97, 0xFFB7, 0xFFB8,
+  0xFFB8, 0xFFB9, 0xFFD9, 0xFFDA, 0xFFDB, 0xFFFB, 0xFFFC, 0xFFFC,
+};
+
+static const uint16_t rainbowPalette565[256] PROGMEM = {
+  0x001F, 0x003F, 0x005F, 0x007F, 0x009F, 0x00BF, 0x00DF, 0x00FF,
+  0x011F, 0x013F, 0x015F, 0x017F, 0x019F, 0x01BF, 0x01DF, 0x01FF,
+  0x021F, 0x023F, 0x025F, 0x027F, 0x029F, 0x02BF, 0x02DF, 0x02FF,
+  0x031F, 0x033F, 0x035F, 0x037F, 0x039F, 0x03BF, 0x03DF, 0x03FF,
+  0x041F, 0x043F, 0x045F, 0x047F, 0x049F, 0x04BF, 0x04DF, 0x04FF,
+  0x051F, 0x053F, 0x055F, 0x057F, 0x059F, 0x05BF, 0x05DF, 0x05FF,
+  0x061F, 0x063F, 0x065F, 0x067F, 0x069F, 0x06BF, 0x06DF, 0x06FF,
+  0x071F, 0x073F, 0x075F, 0x077F, 0x079F, 0x07BF, 0x07DF, 0x07FF,
+  0x07FF, 0x07FF, 0x07FE, 0x07FE, 0x07FD, 0x07FD, 0x07FC, 0x07FC,
+  0x07FB, 0x07FB, 0x07FA, 0x07FA, 0x07F9, 0x07F9, 0x07F8, 0x07F8,
+  0x07F7, 0x07F7, 0x07F6, 0x07F6, 0x07F5, 0x07F5, 0x07F4, 0x07F4,
+  0x07F3, 0x07F3, 0x07F2, 0x07F2, 0x07F1, 0x07F1, 0x07F0, 0x07F0,
+  0x07EF, 0x07EF, 0x07EE, 0x07EE, 0x07ED, 0x07ED, 0x07EC, 0x07EC,
+  0x07EB, 0x07EB, 0x07EA, 0x07EA, 0x07E9, 0x07E9, 0x07E8, 0x07E8,
+  0x07E7, 0x07E7, 0x07E6, 0x07E6, 0x07E5, 0x07E5, 0x07E4, 0x07E4,
+  0x07E3, 0x07E3, 0x07E2, 0x07E2, 0x07E1, 0x07E1, 0x07E0, 0x07E0,
+  0x07E0, 0x07E0, 0x0FE0, 0x0FE0, 0x17E0, 0x17E0, 0x1FE0, 0x1FE0,
+  0x27E0, 0x27E0, 0x2FE0, 0x2FE0, 0x37E0, 0x37E0, 0x3FE0, 0x3FE0,
+  0x47E0, 0x47E0, 0x4FE0, 0x4FE0, 0x57E0, 0x57E0, 0x5FE0, 0x5FE0,
+  0x67E0, 0x67E0, 0x6FE0, 0x6FE0, 0x77E0, 0x77E0, 0x7FE0, 0x7FE0,
+  0x87E0, 0x87E0, 0x8FE0, 0x8FE0, 0x97E0, 0x97E0, 0x9FE0, 0x9FE0,
+  0xA7E0, 0xA7E0, 0xAFE0, 0xAFE0, 0xB7E0, 0xB7E0, 0xBFE0, 0xBFE0,
+  0xC7E0, 0xC7E0, 0xCFE0, 0xCFE0, 0xD7E0, 0xD7E0, 0xDFE0, 0xDFE0,
+  0xE7E0, 0xE7E0, 0xEFE0, 0xEFE0, 0xF7E0, 0xF7E0, 0xFFE0, 0xFFE0,
+  0xFFE0, 0xFFC0, 0xFFA0, 0xFF80, 0xFF60, 0xFF40, 0xFF20, 0xFF00,
+  0xFEE0, 0xFEC0, 0xFEA0, 0xFE80, 0xFE60, 0xFE40, 0xFE20, 0xFE00,
+  0xFDE0, 0xFDC0, 0xFDA0, 0xFD80, 0xFD60, 0xFD40, 0xFD20, 0xFD00,
+  0xFCE0, 0xFCC0, 0xFCA0, 0xFC80, 0xFC60, 0xFC40, 0xFC20, 0xFC00,
+  0xFBE0, 0xFBC0, 0xFBA0, 0xFB80, 0xFB60, 0xFB40, 0xFB20, 0xFB00,
+  0xFAE0, 0xFAC0, 0xFAA0, 0xFA80, 0xFA60, 0xFA40, 0xFA20, 0xFA00,
+  0xF9E0, 0xF9C0, 0xF9A0, 0xF980, 0xF960, 0xF940, 0xF920, 0xF900,
+  0xF8E0, 0xF8C0, 0xF8A0, 0xF880, 0xF860, 0xF840, 0xF820, 0xF800,
+};
+
+static const uint16_t grayscalePalette565[256] PROGMEM = {
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0020, 0x0020, 0x0020, 0x0020,
+  0x0841, 0x0841, 0x0841, 0x0841, 0x0861, 0x0861, 0x0861, 0x0861,
+  0x1082, 0x1082, 0x1082, 0x1082, 0x10A2, 0x10A2, 0x10A2, 0x10A2,
+  0x18C3, 0x18C3, 0x18C3, 0x18C3, 0x18E3, 0x18E3, 0x18E3, 0x18E3,
+  0x2104, 0x2104, 0x2104, 0x2104, 0x2124, 0x2124, 0x2124, 0x2124,
+  0x2945, 0x2945, 0x2945, 0x2945, 0x2965, 0x2965, 0x2965, 0x2965,
+  0x3186, 0x3186, 0x3186, 0x3186, 0x31A6, 0x31A6, 0x31A6, 0x31A6,
+  0x39C7, 0x39C7, 0x39C7, 0x39C7, 0x39E7, 0x39E7, 0x39E7, 0x39E7,
+  0x4208, 0x4208, 0x4208, 0x4208, 0x4228, 0x4228, 0x4228, 0x4228,
+  0x4A49, 0x4A49, 0x4A49, 0x4A49, 0x4A69, 0x4A69, 0x4A69, 0x4A69,
+  0x528A, 0x528A, 0x528A, 0x528A, 0x52AA, 0x52AA, 0x52AA, 0x52AA,
+  0x5ACB, 0x5ACB, 0x5ACB, 0x5ACB, 0x5AEB, 0x5AEB, 0x5AEB, 0x5AEB,
+  0x630C, 0x630C, 0x630C, 0x630C, 0x632C, 0x632C, 0x632C, 0x632C,
+  0x6B4D, 0x6B4D, 0x6B4D, 0x6B4D, 0x6B6D, 0x6B6D, 0x6B6D, 0x6B6D,
+  0x738E, 0x738E, 0x738E, 0x738E, 0x73AE, 0x73AE, 0x73AE, 0x73AE,
+  0x7BCF, 0x7BCF, 0x7BCF, 0x7BCF, 0x7BEF, 0x7BEF, 0x7BEF, 0x7BEF,
+  0x8410, 0x8410, 0x8410, 0x8410, 0x8430, 0x8430, 0x8430, 0x8430,
+  0x8C51, 0x8C51, 0x8C51, 0x8C51, 0x8C71, 0x8C71, 0x8C71, 0x8C71,
+  0x9492, 0x9492, 0x9492, 0x9492, 0x94B2, 0x94B2, 0x94B2, 0x94B2,
+  0x9CD3, 0x9CD3, 0x9CD3, 0x9CD3, 0x9CF3, 0x9CF3, 0x9CF3, 0x9CF3,
+  0xA514, 0xA514, 0xA514, 0xA514, 0xA534, 0xA534, 0xA534, 0xA534,
+  0xAD55, 0xAD55, 0xAD55, 0xAD55, 0xAD75, 0xAD75, 0xAD75, 0xAD75,
+  0xB596, 0xB596, 0xB596, 0xB596, 0xB5B6, 0xB5B6, 0xB5B6, 0xB5B6,
+  0xBDD7, 0xBDD7, 0xBDD7, 0xBDD7, 0xBDF7, 0xBDF7, 0xBDF7, 0xBDF7,
+  0xC618, 0xC618, 0xC618, 0xC618, 0xC638, 0xC638, 0xC638, 0xC638,
+  0xCE59, 0xCE59, 0xCE59, 0xCE59, 0xCE79, 0xCE79, 0xCE79, 0xCE79,
+  0xD69A, 0xD69A, 0xD69A, 0xD69A, 0xD6BA, 0xD6BA, 0xD6BA, 0xD6BA,
+  0xDEDB, 0xDEDB, 0xDEDB, 0xDEDB, 0xDEFB, 0xDEFB, 0xDEFB, 0xDEFB,
+  0xE71C, 0xE71C, 0xE71C, 0xE71C, 0xE73C, 0xE73C, 0xE73C, 0xE73C,
+  0xEF5D, 0xEF5D, 0xEF5D, 0xEF5D, 0xEF7D, 0xEF7D, 0xEF7D, 0xEF7D,
+  0xF79E, 0xF79E, 0xF79E, 0xF79E, 0xF7BE, 0xF7BE, 0xF7BE, 0xF7BE,
+  0xFFDF, 0xFFDF, 0xFFDF, 0xFFDF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+};
+
+GridEYERenderer::GridEYERenderer()
+{
+  _palette = GRIDEYE_PALETTE_IRONBOW;
+  _scale = 1;
+  setAutoRange();
+  for (uint8_t i = 0; i < 64; i++)
+    _levels[i] = 0;
+}
+
+void GridEYERenderer::setPalette(uint8_t palette)
+{
+  _palette = palette;
+}
+
+void GridEYERenderer::setScale(uint8_t scale)
+{
+  _scale = (scale > 0) ? scale : 1;
+}
+
+void GridEYERenderer::setAutoRange(int16_t minSpan)
+{
+  _autoRange = true;
+  _minSpan = (minSpan > 0) ? minSpan : 1;
+  makeStretch(0, _minSpan);
+}
+
+void GridEYERenderer::setRange(int16_t low, int16_t high)
+{
+  _autoRange = false;
+  makeStretch(low, high);
+}
+
+void GridEYERenderer::setStretch(const GridEYEStretch &stretch)
+{
+  _autoRange = false;
+  _stretch = stretch;
+}
+
+void GridEYERenderer::makeStretch(int16_t low, int16_t high)
+{
+  if (high <= low)
+    high = low + 1;
+
+  uint16_t span = (uint16_t)(high - low);
+  _stretch.low = low;
+  _stretch.high = high;
+  _stretch.scale = (uint16_t)(((255UL << 8) + span - 1) / span); // Rounded up so high lands on 255
+}
+
+const GridEYEStretch &GridEYERenderer::getStretch()
+{
+  return _stretch;
+}
+
+uint16_t GridEYERenderer::getWidth()
+{
+  return 8 * _scale;
+}
+
+uint16_t GridEYERenderer::getHeight()
+{
+  return 8 * _scale;
+}
+
+void GridEYERenderer::setFrame(const int16_t *frame)
+{
+  if (_autoRange)
+  {
+    int16_t low = frame[0];
+    int16_t high = frame[0];
+    for (uint8_t i = 1; i < 64; i++)
+    {
+      if (frame[i] < low)
+        low = frame[i];
+      if (frame[i] > high)
+        high = frame[i];
+    }
+    if (high - low < _minSpan)
+    {
+      low -= (_minSpan - (high - low)) / 2;
+      high = low + _minSpan;
+    }
+    makeStretch(low, high);
+  }
+
+  for (uint8_t i = 0; i < 64; i++)
+    _levels[i] = _stretch.apply(frame[i]);
+}
+
+/********************************************************
+ * Upscaling
+ ********************************************************
+ *
+ * Output pixel n has its center at (n + 0.5) / scale - 0.5
+ * source pixels, clamped to the outer source centers, so
+ * scale 1 reproduces the frame exactly. Positions are Q8:
+ * the source pixel to the left or above and the weight of
+ * the next one.
+ *
+ * Along a row the position is stepped with a quotient and
+ * remainder instead of divided per pixel, which matters
+ * on parts without a hardware divider.
+ *
+ ********************************************************/
+
+// Tracks (2n + 1) * 128 / scale for n = 0, 1, 2...
+struct GridEYEScaleStep
+{
+  int16_t quotient;
+  uint16_t remainder;
+  uint8_t scale;
+  uint16_t stepQuotient;
+  uint16_t stepRemainder;
+
+  GridEYEScaleStep(uint8_t factor, uint16_t start)
+  {
+    scale = factor;
+    uint32_t numerator = (2UL * start + 1) * 128;
+    quotient = (int16_t)(numerator / scale);
+    remainder = (uint16_t)(numerator % scale);
+    stepQuotient = 256 / scale;
+    stepRemainder = 256 % scale;
+  }
+
+  // Source index and Q8 weight of the next source pixel at the current position
+  inline void get(uint8_t *index, uint8_t *weight)
+  {
+    int16_t pos = quotient - 128;
+    if (pos < 0)
+      pos = 0;
+    if (pos > 7 * 256)
+      pos = 7 * 256;
+    *index = pos >> 8;
+    *weight = pos & 0xFF;
+  }
+
+  inline void next()
+  {
+    quotient += stepQuotient;
+    remainder += stepRemainder;
+    if (remainder >= scale)
+    {
+      quotient++;
+      remainder -= scale;
+    }
+  }
+};
+
+static inline uint8_t blend(uint8_t a, uint8_t b, uint8_t weight)
+{
+  return (uint8_t)(((uint16_t)a * (256 - weight) + (uint16_t)b * weight + 128) >> 8);
+}
+
+void GridEYERenderer::rowSources(uint16_t row, const uint8_t **top, const uint8_t **bottom, uint8_t *weight)
+{
+  GridEYEScaleStep step(_scale, row);
+  uint8_t index;
+  step.get(&index, weight);
+  *top = &_levels[index * 8];
+  *bottom = &_levels[((index < 7) ? index + 1 : 7) * 8];
+}
+
+uint8_t GridEYERenderer::getLevel(uint16_t x, uint16_t y)
+{
+  const uint8_t *top;
+  const uint8_t *bottom;
+  uint8_t weightY;
+  rowSources(y, &top, &bottom, &weightY);
+
+  GridEYEScaleStep step(_scale, x);
+  uint8_t index;
+  uint8_t weightX;
+  step.get(&index, &weightX);
+  uint8_t next = (index < 7) ? index + 1 : 7;
+  return blend(blend(top[index], top[next], weightX), blend(bottom[index], bottom[next], weightX), weightY);
+}
+
+/********************************************************
+ * Row output
+ ********************************************************/
+
+void GridEYERenderer::renderRow(uint16_t row, uint16_t *rgb565)
+{
+  const uint8_t *top;
+  const uint8_t *bottom;
+  uint8_t weightY;
+  rowSources(row, &top, &bottom, &weightY);
+
+  const uint16_t *palette = getPalette565();
+  GridEYEScaleStep step(_scale, 0);
+  uint16_t width = getWidth();
+  for (uint16_t x = 0; x < width; x++, step.next())
+  {
+    uint8_t index;
+    uint8_t weightX;
+    step.get(&index, &weightX);
+    uint8_t next = (index < 7) ? index + 1 : 7;
+    uint8_t level = blend(blend(top[index], top[next], weightX), blend(bottom[index], bottom[next], weightX), weightY);
+    rgb565[x] = pgm_read_word(&palette[level]);
+  }
+}
+
+void GridEYERenderer::renderRow888(uint16_t row, uint8_t *rgb888)
+{
+  const uint8_t *top;
+  const uint8_t *bottom;
+  uint8_t weightY;
+  rowSources(row, &top, &bottom, &weightY);
+
+  GridEYEScaleStep step(_scale, 0);
+  uint16_t width = getWidth();
+  for (uint16_t x = 0; x < width; x++, step.next(), rgb888 += 3)
+  {
+    uint8_t index;
+    uint8_t weightX;
+    step.get(&index, &weightX);
+    uint8_t next = (index < 7) ? index + 1 : 7;
+    uint8_t level = blend(blend(top[index], top[next], weightX), blend(bottom[index], bottom[next], weightX), weightY);
+    getColor888(level, rgb888);
+  }
+}
+
+/********************************************************
+ * Palette lookups
+ ********************************************************/
+
+void GridEYERenderer::getColor888(uint8_t level, uint8_t *rgb)
+{
+  if (_palette == GRIDEYE_PALETTE_GRAYSCALE)
+  {
+    rgb[0] = rgb[1] = rgb[2] = level;
+    return;
+  }
+
+  const uint8_t *entry = ((_palette == GRIDEYE_PALETTE_RAINBOW) ? rainbowPalette : ironbowPalette) + level * 3;
+  rgb[0] = pgm_read_byte(entry);
+  rgb[1] = pgm_read_byte(entry + 1);
+  rgb[2] = pgm_read_byte(entry + 2);
+}
+
+const uint16_t *GridEYERenderer::getPalette565()
+{
+  if (_palette == GRIDEYE_PALETTE_GRAYSCALE)
+    return grayscalePalette565;
+  return (_palette == GRIDEYE_PALETTE_RAINBOW) ? rainbowPalette565 : ironbowPalette565;
+}
+
+uint16_t GridEYERenderer::getColor565(uint8_t level)
+{
+  return pgm_read_word(&getPalette565()[level]);
+}
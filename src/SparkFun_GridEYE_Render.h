@@ -0,0 +1,82 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  False color rendering of GridEYE frames.
+
+  A frame is mapped onto 0..255 once per frame (auto-ranged from
+  the frame's minimum and maximum, or with a fixed or histogram
+  stretch), then colored through a 256 entry palette held in flash,
+  with an RGB565 copy so a 565 pixel is a single table read.
+  Output can be upscaled by any whole factor with bilinear
+  interpolation and is produced one row at a time, as RGB565 for
+  SPI displays or RGB888, so a 64x64 image can be streamed to a
+  display from a 128 byte row buffer.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "SparkFun_GridEYE_Histogram.h"
+
+// Palettes
+#define GRIDEYE_PALETTE_IRONBOW 0   // Black, purple, red, orange, yellow, white
+#define GRIDEYE_PALETTE_RAINBOW 1   // Blue through green to red
+#define GRIDEYE_PALETTE_GRAYSCALE 2
+
+class GridEYERenderer
+{
+public:
+  GridEYERenderer();
+
+  void setPalette(uint8_t palette);
+  void setScale(uint8_t scale); // Output is 8 * scale pixels square, 1 is no upscaling
+
+  // Range used by the next setFrame(). Auto-ranging stretches the frame's
+  // minimum to maximum, but never less than minSpan raw LSB.
+  void setAutoRange(int16_t minSpan = 8);
+  void setRange(int16_t low, int16_t high);
+  void setStretch(const GridEYEStretch &stretch); // e.g. from a GridEYEHistogram
+
+  // Take a sign-extended raw frame. Only the 64 mapped levels are kept, so the
+  // frame does not have to stay around while rows are rendered.
+  void setFrame(const int16_t *frame);
+
+  uint16_t getWidth();
+  uint16_t getHeight();
+  const GridEYEStretch &getStretch(); // Range applied to the current frame
+
+  // One output row, getWidth() pixels
+  void renderRow(uint16_t row, uint16_t *rgb565);
+  void renderRow888(uint16_t row, uint8_t *rgb888);
+  uint8_t getLevel(uint16_t x, uint16_t y); // Interpolated 0..255 level before the palette
+
+  // Palette lookups
+  uint16_t getColor565(uint8_t level);
+  void getColor888(uint8_t level, uint8_t *rgb);
+
+private:
+  void makeStretch(int16_t low, int16_t high);
+  void rowSources(uint16_t row, const uint8_t **top, const uint8_t **bottom, uint8_t *weight);
+  const uint16_t *getPalette565(); // In flash, read with pgm_read_word()
+
+  GridEYEStretch _stretch;
+  bool _autoRange;
+  int16_t _minSpan;
+  uint8_t _palette;
+  uint8_t _scale;
+  uint8_t _levels[64];
+};
@@ -0,0 +1,281 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Verified startup for the GridEYE.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+// Bits of each configuration register that hold configuration. RESET,
+// STATUS, STATUS_CLEAR and the reserved 0x06 are not compared.
+static const uint8_t configMask[GRIDEYE_CONFIG_BYTES] = {
+    0xFF, 0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 0x20, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F};
+
+GridEYEStartup::GridEYEStartup()
+{
+  memset(_shadow, 0, sizeof(_shadow));
+  _warmEnabled = true;
+  _timeout = GRIDEYE_STARTUP_TIMEOUT_MS;
+  _start = 0;
+  _phaseStart = 0;
+  _readyAt = 0;
+  _result = GRIDEYE_STARTUP_NO_DEVICE;
+  _warm = false;
+  _firstFrame = 0;
+  _probe = 0;
+}
+
+void GridEYEStartup::defaultProfile(GridEYEProfile *profile)
+{
+  profile->power = GRIDEYE_POWER_NORMAL;
+  profile->fps10 = true;
+  profile->movingAverage = false;
+  profile->interruptControl = 0;
+  profile->upper = 0;
+  profile->lower = 0;
+  profile->hysteresis = 0;
+}
+
+void GridEYEStartup::setWarmStart(bool enable)
+{
+  _warmEnabled = enable;
+}
+
+void GridEYEStartup::setTimeout(uint16_t ms)
+{
+  _timeout = ms;
+}
+
+/********************************************************
+ * Startup sequence
+ ********************************************************
+ *
+ * start() - probe, then either take the warm path or wake,
+ *    reset, write the profile and read it back. In normal
+ *    power mode it then waits for the first valid frame.
+ *    The warm path is only taken with GRIDEYE_RESET_NONE;
+ *    a reset the caller asked for is always issued.
+ *    Standby modes only convert every 10 or 60 seconds, so
+ *    there start() returns once the profile is verified
+ *    and the time to first frame stays 0.
+ *
+ * probe() - retries the configuration burst until the
+ *    device answers, which also rides out the 50ms after
+ *    power up when the sensor doesn't respond, then checks
+ *    the values are ones a GridEYE can hold
+ *
+ * settleFrom() - moves the time the output is valid to a
+ *    frame period after now, if that is later
+ *
+ * waitForFrame() - waits for that time, then reads the
+ *    first frame. No register value is taken to mean
+ *    "not ready": 0.00C is a real reading.
+ *
+ ********************************************************/
+
+uint8_t GridEYEStartup::start(GridEYE &sensor, const GridEYEProfile &profile, uint8_t resetMode, int16_t *frame)
+{
+  _start = (uint32_t)micros();
+  _warm = false;
+  _firstFrame = 0;
+  _probe = 0;
+
+  memset(_shadow, 0, sizeof(_shadow));
+  _shadow[POWER_CONTROL_REGISTER] = profile.power;
+  _shadow[FRAMERATE_REGISTER] = profile.fps10 ? 0 : 1;
+  _shadow[INT_CONTROL_REGISTER] = profile.interruptControl & 0x03;
+  _shadow[AVERAGE_REGISTER] = profile.movingAverage ? 0x20 : 0;
+  _shadow[INT_LEVEL_REGISTER_UPPER_LSB] = profile.upper & 0xFF;
+  _shadow[INT_LEVEL_REGISTER_UPPER_MSB] = (profile.upper >> 8) & 0x0F;
+  _shadow[INT_LEVEL_REGISTER_LOWER_LSB] = profile.lower & 0xFF;
+  _shadow[INT_LEVEL_REGISTER_LOWER_MSB] = (profile.lower >> 8) & 0x0F;
+  _shadow[INT_LEVEL_REGISTER_HYST_LSB] = profile.hysteresis & 0xFF;
+  _shadow[INT_LEVEL_REGISTER_HYST_MSB] = (profile.hysteresis >> 8) & 0x0F;
+
+  // A sensor powered with the MCU has no frame before this
+  _readyAt = _start;
+  uint32_t powerUp = GRIDEYE_STARTUP_POWER_UP_MS + (profile.fps10 ? 100 : 1000) + GRIDEYE_STARTUP_SETTLE_MS;
+  uint32_t uptime = millis();
+  if (uptime < powerUp)
+    _readyAt += (powerUp - uptime) * 1000UL;
+
+  uint8_t config[GRIDEYE_CONFIG_BYTES];
+  if (!probe(sensor, config))
+    return _result;
+  _probe = (uint32_t)micros() - _start;
+
+  if (_warmEnabled && (resetMode == GRIDEYE_RESET_NONE) && matches(config))
+  {
+    _warm = true;
+  }
+  else
+  {
+    // Wake first, the reset and the other registers need normal mode
+    bool ok = true;
+    bool restarted = (resetMode == GRIDEYE_RESET_INITIAL); // Output registers cleared
+    if (config[POWER_CONTROL_REGISTER] != GRIDEYE_POWER_NORMAL)
+    {
+      ok = sensor.setRegister(POWER_CONTROL_REGISTER, GRIDEYE_POWER_NORMAL);
+      restarted = true;
+    }
+    if (ok && (resetMode != GRIDEYE_RESET_NONE))
+      ok = sensor.setRegister(RESET_REGISTER, resetMode);
+    if (ok)
+      ok = apply(sensor, profile);
+    if (ok)
+      ok = sensor.getRegisterBlock(POWER_CONTROL_REGISTER, config, GRIDEYE_CONFIG_BYTES);
+    if (!ok || !matches(config))
+    {
+      _result = GRIDEYE_STARTUP_CONFIG;
+      return _result;
+    }
+    if (restarted)
+      settleFrom((uint32_t)micros(), profile);
+  }
+
+  if (profile.power == GRIDEYE_POWER_NORMAL)
+  {
+    if (!waitForFrame(sensor, frame))
+    {
+      _result = GRIDEYE_STARTUP_NO_FRAME;
+      return _result;
+    }
+    _firstFrame = (uint32_t)micros() - _start;
+  }
+
+  _result = GRIDEYE_STARTUP_OK;
+  return _result;
+}
+
+bool GridEYEStartup::probe(GridEYE &sensor, uint8_t *config)
+{
+  _phaseStart = _start;
+  bool silent = false;
+  while (!sensor.getRegisterBlock(POWER_CONTROL_REGISTER, config, GRIDEYE_CONFIG_BYTES))
+  {
+    if (expired())
+    {
+      _result = GRIDEYE_STARTUP_NO_DEVICE;
+      return false;
+    }
+    silent = true;
+    delay(GRIDEYE_STARTUP_POLL_MS);
+  }
+
+  // Just powered up: the first conversion starts now, at the power on frame rate
+  if (silent)
+  {
+    GridEYEProfile defaults;
+    defaultProfile(&defaults);
+    settleFrom((uint32_t)micros(), defaults);
+  }
+
+  uint8_t power = config[POWER_CONTROL_REGISTER];
+  bool powerOK = (power == GRIDEYE_POWER_NORMAL) || (power == GRIDEYE_POWER_SLEEP) ||
+                 (power == GRIDEYE_POWER_STANDBY_60) || (power == GRIDEYE_POWER_STANDBY_10);
+  if (!powerOK || (config[FRAMERATE_REGISTER] & 0xFE) || (config[INT_CONTROL_REGISTER] & 0xFC))
+  {
+    _result = GRIDEYE_STARTUP_NOT_GRIDEYE;
+    return false;
+  }
+  return true;
+}
+
+bool GridEYEStartup::matches(const uint8_t *config)
+{
+  for (uint8_t i = 0; i < GRIDEYE_CONFIG_BYTES; i++)
+  {
+    if ((config[i] ^ _shadow[i]) & configMask[i])
+      return false;
+  }
+  return true;
+}
+
+// Levels before the interrupt control so the pin can't fire on stale levels.
+// Power mode last, once everything else is in place.
+bool GridEYEStartup::apply(GridEYE &sensor, const GridEYEProfile &profile)
+{
+  bool ok = sensor.setRegister(FRAMERATE_REGISTER, _shadow[FRAMERATE_REGISTER]);
+  for (uint8_t reg = INT_LEVEL_REGISTER_UPPER_LSB; ok && (reg <= INT_LEVEL_REGISTER_HYST_MSB); reg++)
+    ok = sensor.setRegister(reg, _shadow[reg]);
+  if (ok)
+    ok = sensor.setRegister(INT_CONTROL_REGISTER, _shadow[INT_CONTROL_REGISTER]);
+  if (!ok)
+    return false;
+
+  if (profile.movingAverage)
+    sensor.movingAverageEnable();
+  else
+    sensor.movingAverageDisable();
+
+  if (profile.power != GRIDEYE_POWER_NORMAL)
+    return sensor.setRegister(POWER_CONTROL_REGISTER, profile.power);
+  return true;
+}
+
+void GridEYEStartup::settleFrom(uint32_t now, const GridEYEProfile &profile)
+{
+  uint32_t readyAt = now + ((profile.fps10 ? 100UL : 1000UL) + GRIDEYE_STARTUP_SETTLE_MS) * 1000UL;
+  if ((int32_t)(readyAt - _readyAt) > 0)
+    _readyAt = readyAt;
+}
+
+bool GridEYEStartup::waitForFrame(GridEYE &sensor, int16_t *frame)
+{
+  while ((int32_t)((uint32_t)micros() - _readyAt) < 0)
+    delay(GRIDEYE_STARTUP_POLL_MS);
+
+  if (frame == NULL)
+    return true;
+
+  _phaseStart = (uint32_t)micros();
+  while (!sensor.getFrameRaw(frame))
+  {
+    if (expired())
+      return false;
+    delay(GRIDEYE_STARTUP_POLL_MS);
+  }
+  return true;
+}
+
+bool GridEYEStartup::expired()
+{
+  return ((uint32_t)micros() - _phaseStart) >= (uint32_t)(_timeout * 1000UL);
+}
+
+/********************************************************
+ * Results
+ ********************************************************/
+
+uint8_t GridEYEStartup::getResult()
+{
+  return _result;
+}
+
+bool GridEYEStartup::wasWarmStart()
+{
+  return _warm;
+}
+
+uint32_t GridEYEStartup::getTimeToFirstFrame()
+{
+  return _firstFrame;
+}
+
+uint32_t GridEYEStartup::getProbeTime()
+{
+  return _probe;
+}
@@ -0,0 +1,134 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Verified startup for the GridEYE.
+
+  GridEYE::begin() only records the address and the bus. GridEYEStartup
+  brings the sensor up and checks that it did: it probes the device
+  until it answers, optionally issues a flag reset (0x30) or an initial
+  reset (0x3F), writes a configuration profile, reads it back, and then
+  waits only as long as the sensor needs for a valid frame instead of
+  a fixed worst case. The time from start() to that frame is kept in
+  microseconds.
+
+  Readiness is decided by time, not by register values: a real scene
+  can read 0.00C, so zeroed output registers can't tell "no frame yet"
+  from ice water. The output is valid one frame period
+  (GRIDEYE_STARTUP_SETTLE_MS margin included) after whichever came
+  last of:
+    - the sensor first answering, if it didn't at the start of start()
+    - an initial reset, which clears the output, or a wake from sleep
+      or standby, which left it stale
+    - power up, taken as no earlier than the MCU's, so until millis()
+      passes GRIDEYE_STARTUP_POWER_UP_MS plus a frame period
+  A flag reset or a profile write to a running sensor leaves the last
+  frame in place. After the wait the first frame is read, retrying bus
+  errors until the timeout.
+
+  Warm start: the configuration registers are read in one burst before
+  anything is written. If they already hold the profile and no reset
+  was asked for (GRIDEYE_RESET_NONE), as after an MCU reset with the
+  sensor left powered, the profile writes are skipped and the first
+  frame is available at once. A flag or initial reset is always
+  issued, so asking for one means a cold start.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class GridEYE;
+
+// Values for RESET_REGISTER
+#define GRIDEYE_RESET_NONE 0x00
+#define GRIDEYE_RESET_FLAG 0x30    // Clears the status flags only
+#define GRIDEYE_RESET_INITIAL 0x3F // Restores every register to its default
+
+// Values for POWER_CONTROL_REGISTER
+#define GRIDEYE_POWER_NORMAL 0x00
+#define GRIDEYE_POWER_SLEEP 0x10
+#define GRIDEYE_POWER_STANDBY_60 0x20
+#define GRIDEYE_POWER_STANDBY_10 0x21
+
+// start() results
+#define GRIDEYE_STARTUP_OK 0
+#define GRIDEYE_STARTUP_NO_DEVICE 1 // Nothing answered before the timeout
+#define GRIDEYE_STARTUP_NOT_GRIDEYE 2 // Answered, but with register values a GridEYE can't hold
+#define GRIDEYE_STARTUP_CONFIG 3    // The profile didn't read back
+#define GRIDEYE_STARTUP_NO_FRAME 4  // No valid frame before the timeout
+
+#define GRIDEYE_STARTUP_POLL_MS 1
+#define GRIDEYE_STARTUP_TIMEOUT_MS 1500 // Probe, and frame read retries after the settle wait
+#define GRIDEYE_STARTUP_POWER_UP_MS 50  // No I2C answer before this after power up
+#define GRIDEYE_STARTUP_SETTLE_MS 2     // Margin on top of a frame period
+
+// Configuration registers POWER_CONTROL_REGISTER to INT_LEVEL_REGISTER_HYST_MSB
+#define GRIDEYE_CONFIG_BYTES 14
+
+struct GridEYEProfile
+{
+  uint8_t power;            // GRIDEYE_POWER_*
+  bool fps10;               // 10FPS, else 1FPS
+  bool movingAverage;       // Twice moving average output
+  uint8_t interruptControl; // INT_CONTROL_REGISTER: 0x01 pin enable, 0x02 absolute mode
+  int16_t upper;            // Interrupt levels, raw 12-bit, 0.25C per LSB
+  int16_t lower;
+  int16_t hysteresis;
+};
+
+class GridEYEStartup
+{
+public:
+  GridEYEStartup();
+
+  // Register defaults: normal power, 10FPS, no averaging, interrupt off
+  static void defaultProfile(GridEYEProfile *profile);
+
+  void setWarmStart(bool enable); // On by default
+  void setTimeout(uint16_t ms);   // For the probe and for the first frame, each
+
+  // Bring the sensor up with profile. sensor must have had begin() called.
+  // frame, if not NULL, receives the first valid frame. Returns GRIDEYE_STARTUP_*.
+  // Only GRIDEYE_RESET_NONE allows a warm start.
+  uint8_t start(GridEYE &sensor, const GridEYEProfile &profile, uint8_t resetMode = GRIDEYE_RESET_INITIAL,
+                int16_t *frame = NULL);
+
+  uint8_t getResult();
+  bool wasWarmStart();            // The reset and profile writes were skipped
+  uint32_t getTimeToFirstFrame(); // Microseconds from start() to the first valid frame
+  uint32_t getProbeTime();        // Microseconds until the device first answered
+
+private:
+  bool probe(GridEYE &sensor, uint8_t *config);
+  bool matches(const uint8_t *config);
+  bool apply(GridEYE &sensor, const GridEYEProfile &profile);
+  void settleFrom(uint32_t now, const GridEYEProfile &profile);
+  bool waitForFrame(GridEYE &sensor, int16_t *frame);
+  bool expired();
+
+  uint8_t _shadow[GRIDEYE_CONFIG_BYTES]; // Register image the profile asks for
+  bool _warmEnabled;
+  uint16_t _timeout;
+
+  uint32_t _start;
+  uint32_t _phaseStart;
+  uint32_t _readyAt; // micros() the output is valid from
+  uint8_t _result;
+  bool _warm;
+  uint32_t _firstFrame;
+  uint32_t _probe;
+};
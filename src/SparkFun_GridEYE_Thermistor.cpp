@@ -0,0 +1,214 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Scheduled thermistor sampling with ambient drift compensation.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+#define MAX_RATE ((int32_t)32767 << 8) // Largest drift getRate() can report
+#define MAX_PREDICT_MS 60000           // Don't extrapolate more than a minute if nobody is polling
+#define MAX_PREDICT_RATE 35791         // Q8 per second; times MAX_PREDICT_MS still fits 32 bits
+
+GridEYEThermistor::GridEYEThermistor()
+{
+  _interval = GRIDEYE_THERMISTOR_DEFAULT_INTERVAL;
+  _fastInterval = GRIDEYE_THERMISTOR_DEFAULT_FAST_INTERVAL;
+  _transientThreshold = GRIDEYE_THERMISTOR_DEFAULT_TRANSIENT;
+  _coefficient = 0;
+  _reference = 0;
+  _referenceSet = false;
+
+  _slow = 0;
+  _fast = 0;
+  _rate = 0;
+  _lastSample = 0;
+  _sampled = false;
+  _transient = false;
+  _forceSample = false;
+}
+
+void GridEYEThermistor::setInterval(uint32_t ms)
+{
+  _interval = ms;
+}
+
+void GridEYEThermistor::setFastInterval(uint32_t ms)
+{
+  _fastInterval = ms;
+}
+
+void GridEYEThermistor::setTransientThreshold(uint16_t thermistorLSB)
+{
+  _transientThreshold = thermistorLSB;
+}
+
+void GridEYEThermistor::setDriftCoefficient(int16_t coefficientQ8)
+{
+  _coefficient = coefficientQ8;
+}
+
+void GridEYEThermistor::setReference(int16_t thermistorLSB)
+{
+  _reference = thermistorLSB;
+  _referenceSet = true;
+}
+
+void GridEYEThermistor::setReferenceToCurrent()
+{
+  setReference(getFiltered());
+}
+
+void GridEYEThermistor::requestSample()
+{
+  _forceSample = true;
+}
+
+/********************************************************
+ * Sampling and filtering
+ ********************************************************
+ *
+ * poll() - reads THERMISTOR_REGISTER_LSB if the current
+ *    interval has elapsed (or a sample was requested) and
+ *    updates the filters. Two first order filters run on
+ *    each sample: a slow one (1/8) that is used for the
+ *    correction and a fast one (1/2) that shows when the
+ *    slow one is lagging behind a real change.
+ *
+ ********************************************************/
+
+bool GridEYEThermistor::poll(GridEYE &sensor, uint32_t nowMs)
+{
+  if (_sampled && !_forceSample)
+  {
+    uint32_t period = _transient ? _fastInterval : _interval;
+    if (nowMs - _lastSample < period)
+      return false;
+  }
+
+  uint16_t val = 0;
+  if (!sensor.getRegister16(THERMISTOR_REGISTER_LSB, &val))
+    return false;
+
+  // The thermistor register is 12-bit sign and magnitude, not two's complement
+  int32_t sample = val & 0x07FF;
+  if (val & (1 << 11))
+    sample = -sample;
+  sample *= 256; // Q8, a shift of a negative value is undefined
+
+  if (!_sampled)
+  {
+    _slow = sample;
+    _fast = sample;
+    _rate = 0;
+    _sampled = true;
+    if (!_referenceSet)
+      setReference((int16_t)(sample >> 8));
+  }
+  else
+  {
+    uint32_t elapsed = nowMs - _lastSample;
+    int32_t previous = _slow;
+
+    _fast += (sample - _fast) >> 1;
+    _slow += (sample - _slow) >> 3;
+
+    // Drift rate from how far the slow filter moved, smoothed over a few samples.
+    // Two samples in the same millisecond say nothing about the rate. A short
+    // interval can scale a small step past anything getRate() can report, so the
+    // rate is worked out in 64 bits and clamped before it joins the average.
+    if (elapsed > 0)
+    {
+      int64_t instant = (int64_t)(_slow - previous) * 60000 / elapsed;
+      if (instant > MAX_RATE)
+        instant = MAX_RATE;
+      else if (instant < -MAX_RATE)
+        instant = -MAX_RATE;
+      _rate += ((int32_t)instant - _rate) >> 2;
+    }
+  }
+
+  int32_t spread = _fast - _slow;
+  if (spread < 0)
+    spread = -spread;
+  _transient = spread > ((int32_t)_transientThreshold << 8);
+
+  _lastSample = nowMs;
+  _forceSample = false;
+
+  return true;
+}
+
+/********************************************************
+ * Drift model
+ ********************************************************
+ *
+ * getPredicted() - slow filtered ambient extrapolated
+ *    from the last sample using the drift rate
+ *
+ * getDriftCorrection() - value to add to every raw pixel
+ *    so readings stay referenced to the calibration
+ *    ambient. Zero until a coefficient is set.
+ *
+ ********************************************************/
+
+int16_t GridEYEThermistor::getFiltered()
+{
+  return (int16_t)((_slow + 128) >> 8);
+}
+
+int16_t GridEYEThermistor::getPredicted(uint32_t nowMs)
+{
+  uint32_t elapsed = nowMs - _lastSample;
+  if (elapsed > MAX_PREDICT_MS)
+    elapsed = MAX_PREDICT_MS;
+
+  // A minute at the largest rate is past 32 bits, so the rate is clamped to
+  // over 8C a second first. That keeps the result well inside 16 bits too.
+  int32_t ratePerSecond = _rate / 60;
+  if (ratePerSecond > MAX_PREDICT_RATE)
+    ratePerSecond = MAX_PREDICT_RATE;
+  else if (ratePerSecond < -MAX_PREDICT_RATE)
+    ratePerSecond = -MAX_PREDICT_RATE;
+  int32_t predicted = _slow + (ratePerSecond * (int32_t)elapsed) / 1000;
+
+  return (int16_t)((predicted + 128) >> 8);
+}
+
+int16_t GridEYEThermistor::getRate()
+{
+  return (int16_t)(_rate >> 8);
+}
+
+int16_t GridEYEThermistor::getDriftCorrection(uint32_t nowMs)
+{
+  if (!_sampled || (_coefficient == 0))
+    return 0;
+
+  // Thermistor LSB is 1/16C and pixel LSB is 1/4C, so Q8 coefficient needs >> 10
+  int32_t delta = (int32_t)getPredicted(nowMs) - _reference;
+  return (int16_t)(-((delta * _coefficient) >> 10));
+}
+
+bool GridEYEThermistor::isTransient()
+{
+  return _transient;
+}
+
+bool GridEYEThermistor::hasSample()
+{
+  return _sampled;
+}
@@ -0,0 +1,83 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Scheduled thermistor sampling with ambient drift compensation.
+
+  The thermistor changes slowly, so instead of reading it every
+  frame this service samples it on its own schedule, filters it,
+  and tracks how fast it is moving. Between samples the ambient is
+  extrapolated from that rate. GridEYE adds the resulting drift
+  correction to every pixel while it decodes the frame.
+
+  A fast filter running ahead of the slow one flags thermal
+  transients (a hand on the board, a door opening) and switches
+  sampling to the fast interval until things settle.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+class GridEYE;
+
+// Defaults: sample every 5s, every 500ms during a transient
+#define GRIDEYE_THERMISTOR_DEFAULT_INTERVAL 5000
+#define GRIDEYE_THERMISTOR_DEFAULT_FAST_INTERVAL 500
+// Fast and slow filters more than 0.5C apart is a transient (1/16C per LSB)
+#define GRIDEYE_THERMISTOR_DEFAULT_TRANSIENT 8
+
+class GridEYEThermistor
+{
+public:
+  GridEYEThermistor();
+
+  void setInterval(uint32_t ms);     // Normal sampling period
+  void setFastInterval(uint32_t ms); // Sampling period while a transient is flagged
+  void setTransientThreshold(uint16_t thermistorLSB);
+
+  // How much pixel readings shift per degree of sensor body temperature.
+  // Q8: 256 means pixels read 1C high for every 1C the body warms up.
+  void setDriftCoefficient(int16_t coefficientQ8);
+  void setReference(int16_t thermistorLSB); // Ambient the calibration was taken at
+  void setReferenceToCurrent();
+
+  // Samples the thermistor if due. Returns true if a sample was taken.
+  bool poll(GridEYE &sensor, uint32_t nowMs);
+  void requestSample(); // Force a sample on the next poll
+
+  int16_t getFiltered();                  // Slow filtered thermistor, 1/16C per LSB
+  int16_t getPredicted(uint32_t nowMs);   // Filtered value extrapolated to nowMs
+  int16_t getRate();                      // Ambient drift, 1/16C per minute
+  int16_t getDriftCorrection(uint32_t nowMs); // Pixel correction, 0.25C per LSB
+  bool isTransient();
+  bool hasSample();
+
+private:
+  uint32_t _interval;
+  uint32_t _fastInterval;
+  uint16_t _transientThreshold;
+  int16_t _coefficient;
+  int16_t _reference;
+  bool _referenceSet;
+
+  int32_t _slow; // Filter states, 1/256 thermistor LSB
+  int32_t _fast;
+  int32_t _rate; // 1/256 thermistor LSB per minute
+  uint32_t _lastSample;
+  bool _sampled;
+  bool _transient;
+  bool _forceSample;
+};
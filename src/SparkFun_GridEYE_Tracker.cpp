@@ -0,0 +1,202 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Region of interest tracking for the GridEYE.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+GridEYETracker::GridEYETracker()
+{
+  _threshold = GRIDEYE_TRACKER_DEFAULT_THRESHOLD;
+  _margin = GRIDEYE_TRACKER_DEFAULT_MARGIN;
+  _refreshInterval = GRIDEYE_TRACKER_DEFAULT_REFRESH;
+
+  _sinceRefresh = 0;
+  _background = 0;
+  _hasTarget = false;
+  _fullFrame = false;
+
+  _rx0 = _ry0 = 0;
+  _rx1 = _ry1 = 7;
+  _tx0 = _ty0 = _tx1 = _ty1 = 0;
+  _hottest = 0;
+}
+
+void GridEYETracker::setThreshold(int16_t raw)
+{
+  _threshold = raw;
+}
+
+void GridEYETracker::setMargin(uint8_t pixels)
+{
+  _margin = pixels;
+}
+
+void GridEYETracker::setRefreshInterval(uint8_t updates)
+{
+  _refreshInterval = updates;
+}
+
+void GridEYETracker::refresh()
+{
+  _hasTarget = false;
+}
+
+/********************************************************
+ * Tracking
+ ********************************************************
+ *
+ * update() - reads a full frame when there is no target
+ *    or a refresh is due, otherwise only the region. The
+ *    region is then refit to the target: target box plus
+ *    margin, one pixel wider on any side where the target
+ *    reached the edge of what was read (it may continue
+ *    past it). A region read without any target pixels
+ *    drops the target, so the next update is a full frame.
+ *
+ ********************************************************/
+
+bool GridEYETracker::update(GridEYE &sensor, int16_t *frame)
+{
+  // _sinceRefresh counts region reads since the last full frame; this update is one more
+  _fullFrame = !_hasTarget || ((uint16_t)_sinceRefresh + 1 >= _refreshInterval);
+
+  if (_fullFrame)
+  {
+    if (!sensor.getFrameRaw(frame))
+      return false;
+
+    int32_t total = 0;
+    for (uint8_t i = 0; i < 64; i++)
+      total += frame[i];
+    _background = (int16_t)(total / 64);
+
+    _sinceRefresh = 0;
+    _rx0 = _ry0 = 0;
+    _rx1 = _ry1 = 7;
+  }
+  else
+  {
+    GridEYERegion region;
+    getRegion(&region);
+
+    int16_t values[64];
+    if (!sensor.getRegionRaw(region, values))
+      return false;
+
+    // Scatter into the caller's frame so it always holds the latest of every pixel
+    const int16_t *src = values;
+    for (uint8_t y = _ry0; y <= _ry1; y++)
+    {
+      for (uint8_t x = _rx0; x <= _rx1; x++)
+        frame[y * 8 + x] = *src++;
+    }
+
+    _sinceRefresh++;
+  }
+
+  _hasTarget = findTarget(frame, _rx0, _ry0, _rx1, _ry1);
+  if (_hasTarget)
+    fitRegion();
+
+  return true;
+}
+
+bool GridEYETracker::findTarget(int16_t *frame, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+  int16_t level = _background + _threshold;
+  int16_t hottestValue = level;
+  bool found = false;
+
+  for (uint8_t y = y0; y <= y1; y++)
+  {
+    for (uint8_t x = x0; x <= x1; x++)
+    {
+      int16_t value = frame[y * 8 + x];
+      if (value <= level)
+        continue;
+
+      if (!found)
+      {
+        _tx0 = _tx1 = x;
+        _ty0 = _ty1 = y;
+        found = true;
+      }
+      if (x < _tx0)
+        _tx0 = x;
+      if (x > _tx1)
+        _tx1 = x;
+      if (y < _ty0)
+        _ty0 = y;
+      if (y > _ty1)
+        _ty1 = y;
+
+      if (value > hottestValue)
+      {
+        hottestValue = value;
+        _hottest = y * 8 + x;
+      }
+    }
+  }
+
+  return found;
+}
+
+void GridEYETracker::fitRegion()
+{
+  // Extra pixel where the target touched the edge of what was read
+  uint8_t left = _margin + ((_tx0 == _rx0) ? 1 : 0);
+  uint8_t right = _margin + ((_tx1 == _rx1) ? 1 : 0);
+  uint8_t top = _margin + ((_ty0 == _ry0) ? 1 : 0);
+  uint8_t bottom = _margin + ((_ty1 == _ry1) ? 1 : 0);
+
+  _rx0 = (_tx0 > left) ? _tx0 - left : 0;
+  _ry0 = (_ty0 > top) ? _ty0 - top : 0;
+  _rx1 = (_tx1 + right < 7) ? _tx1 + right : 7;
+  _ry1 = (_ty1 + bottom < 7) ? _ty1 + bottom : 7;
+}
+
+bool GridEYETracker::hasTarget()
+{
+  return _hasTarget;
+}
+
+bool GridEYETracker::wasFullFrame()
+{
+  return _fullFrame;
+}
+
+void GridEYETracker::getRegion(GridEYERegion *region)
+{
+  region->x = _rx0;
+  region->y = _ry0;
+  region->width = _rx1 - _rx0 + 1;
+  region->height = _ry1 - _ry0 + 1;
+}
+
+void GridEYETracker::getTarget(GridEYERegion *box)
+{
+  box->x = _tx0;
+  box->y = _ty0;
+  box->width = _tx1 - _tx0 + 1;
+  box->height = _ty1 - _ty0 + 1;
+}
+
+uint8_t GridEYETracker::getHottestPixel()
+{
+  return _hottest;
+}
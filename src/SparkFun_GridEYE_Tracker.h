@@ -0,0 +1,75 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Region of interest tracking for the GridEYE.
+
+  Once a warm target is found in a full frame, only the rows around
+  it are read. The region follows the target: it widens when the
+  target touches its edge and narrows when the target shrinks. A
+  full frame is read every few updates, and whenever the target is
+  lost, so new targets and background changes are still seen.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+class GridEYE;
+struct GridEYERegion;
+
+// Defaults: 2C above background is target, 1 pixel margin, full frame every 10 updates
+#define GRIDEYE_TRACKER_DEFAULT_THRESHOLD 8
+#define GRIDEYE_TRACKER_DEFAULT_MARGIN 1
+#define GRIDEYE_TRACKER_DEFAULT_REFRESH 10
+
+class GridEYETracker
+{
+public:
+  GridEYETracker();
+
+  void setThreshold(int16_t raw);        // Above the background mean, 0.25C per LSB
+  void setMargin(uint8_t pixels);        // Kept around the target on every side
+  void setRefreshInterval(uint8_t updates); // Full frame every this many updates, 0 or 1 for every update
+
+  // Read the next frame. frame is the caller's int16_t[64] and must persist
+  // between calls: region reads only overwrite the pixels inside the region.
+  bool update(GridEYE &sensor, int16_t *frame);
+
+  bool hasTarget();
+  bool wasFullFrame(); // True if the last update read all 64 pixels
+  void getRegion(GridEYERegion *region);
+  void getTarget(GridEYERegion *box); // Bounding box of target pixels
+  uint8_t getHottestPixel();
+  void refresh(); // Force a full frame on the next update
+
+private:
+  bool findTarget(int16_t *frame, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+  void fitRegion();
+
+  int16_t _threshold;
+  uint8_t _margin;
+  uint8_t _refreshInterval;
+
+  uint8_t _sinceRefresh;
+  int16_t _background; // Mean of the last full frame
+  bool _hasTarget;
+  bool _fullFrame;
+
+  // Region being read and target box, inclusive corners
+  uint8_t _rx0, _ry0, _rx1, _ry1;
+  uint8_t _tx0, _ty0, _tx1, _ty1;
+  uint8_t _hottest;
+};
@@ -0,0 +1,300 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Software alarm zones for GridEYE frames.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_GridEYE_Arduino_Library.h"
+
+static int16_t saturate16(int32_t value)
+{
+  if (value > 32767)
+    return 32767;
+  if (value < -32768)
+    return -32768;
+  return (int16_t)value;
+}
+
+static int16_t clamp12(int32_t value)
+{
+  if (value > 2047)
+    return 2047;
+  if (value < -2048)
+    return -2048;
+  return (int16_t)value;
+}
+
+// True if bits has at least count bits set. Stops as soon as it knows.
+static bool atLeast(uint64_t bits, uint8_t count)
+{
+  if (count == 0)
+    count = 1;
+  while (bits != 0)
+  {
+    if (--count == 0)
+      return true;
+    bits &= bits - 1;
+  }
+  return false;
+}
+
+GridEYEZones::GridEYEZones()
+{
+  _zones = NULL;
+  _count = 0;
+  _alarms = 0;
+  _frame = NULL;
+  _cacheUsed = 0;
+}
+
+void GridEYEZones::begin(GridEYEZone *zones, uint16_t count)
+{
+  _zones = zones;
+  _count = (zones != NULL) ? count : 0;
+  reset();
+}
+
+void GridEYEZones::setZone(uint16_t index, uint64_t mask, int16_t lower, int16_t upper, int16_t hysteresis,
+                           uint8_t dwell, uint8_t minPixels)
+{
+  if (index >= _count)
+    return;
+
+  GridEYEZone *zone = &_zones[index];
+  zone->mask = mask;
+  zone->lower = lower;
+  zone->upper = upper;
+  zone->hysteresis = (hysteresis > 0) ? hysteresis : 0;
+  zone->dwell = dwell;
+  zone->minPixels = minPixels;
+  zone->state = 0;
+  zone->highCount = 0;
+  zone->lowCount = 0;
+}
+
+uint64_t GridEYEZones::regionMask(GridEYERegion region)
+{
+  if ((region.x > 7) || (region.y > 7) || (region.width == 0) || (region.height == 0))
+    return 0;
+  uint8_t width = (region.x + region.width > 8) ? 8 - region.x : region.width;
+  uint8_t height = (region.y + region.height > 8) ? 8 - region.y : region.height;
+
+  uint64_t row = (uint64_t)(((1U << width) - 1) << region.x);
+  uint64_t mask = 0;
+  for (uint8_t y = region.y; y < region.y + height; y++)
+    mask |= row << (8 * y);
+  return mask;
+}
+
+void GridEYEZones::reset()
+{
+  for (uint16_t i = 0; i < _count; i++)
+  {
+    _zones[i].state = 0;
+    _zones[i].highCount = 0;
+    _zones[i].lowCount = 0;
+  }
+  _alarms = 0;
+}
+
+/********************************************************
+ * Evaluation
+ ********************************************************
+ *
+ * above() - mask of the pixels above a level in the
+ *    current frame. The first GRIDEYE_ZONES_CACHE levels
+ *    asked for in an update are kept, so zones with the
+ *    same level share one set of 64 compares.
+ *
+ * update() - per zone, the level to test is the alarm
+ *    level while the alarm is off and the level moved back
+ *    by the hysteresis while it is on. Dwell counts only
+ *    delay raising an alarm; clearing is immediate.
+ *
+ ********************************************************/
+
+uint64_t GridEYEZones::above(int16_t level)
+{
+  for (uint8_t i = 0; i < _cacheUsed; i++)
+  {
+    if (_cacheLevel[i] == level)
+      return _cacheMask[i];
+  }
+
+  uint64_t mask = 0;
+  for (int8_t y = 7; y >= 0; y--)
+  {
+    const int16_t *row = &_frame[y * 8];
+    uint8_t bits = 0;
+    for (uint8_t x = 0; x < 8; x++)
+      bits |= (uint8_t)(row[x] > level) << x;
+    mask = (mask << 8) | bits;
+  }
+
+  if (_cacheUsed < GRIDEYE_ZONES_CACHE)
+  {
+    _cacheLevel[_cacheUsed] = level;
+    _cacheMask[_cacheUsed] = mask;
+    _cacheUsed++;
+  }
+  return mask;
+}
+
+uint16_t GridEYEZones::update(const int16_t *frame)
+{
+  _frame = frame;
+  _cacheUsed = 0;
+
+  uint16_t changes = 0;
+  uint16_t alarms = 0;
+  for (uint16_t i = 0; i < _count; i++)
+  {
+    GridEYEZone *zone = &_zones[i];
+    uint8_t state = zone->state & ~GRIDEYE_ZONE_CHANGED;
+
+    if (zone->upper != GRIDEYE_ZONE_NO_UPPER)
+    {
+      bool active = state & GRIDEYE_ZONE_HIGH;
+      int16_t level = active ? saturate16((int32_t)zone->upper - zone->hysteresis) : zone->upper;
+      bool out = atLeast(above(level) & zone->mask, zone->minPixels);
+
+      if (active != out)
+      {
+        if (active || (++zone->highCount >= zone->dwell))
+        {
+          state = (state ^ GRIDEYE_ZONE_HIGH) | GRIDEYE_ZONE_CHANGED;
+          zone->highCount = 0;
+        }
+      }
+      else
+      {
+        zone->highCount = 0;
+      }
+    }
+
+    if (zone->lower != GRIDEYE_ZONE_NO_LOWER)
+    {
+      bool active = state & GRIDEYE_ZONE_LOW;
+      int16_t level = active ? saturate16((int32_t)zone->lower + zone->hysteresis) : zone->lower;
+      bool out = atLeast(~above(level - 1) & zone->mask, zone->minPixels); // Below level
+
+      if (active != out)
+      {
+        if (active || (++zone->lowCount >= zone->dwell))
+        {
+          state = (state ^ GRIDEYE_ZONE_LOW) | GRIDEYE_ZONE_CHANGED;
+          zone->lowCount = 0;
+        }
+      }
+      else
+      {
+        zone->lowCount = 0;
+      }
+    }
+
+    zone->state = state;
+    if (state & GRIDEYE_ZONE_CHANGED)
+      changes++;
+    if (state & (GRIDEYE_ZONE_HIGH | GRIDEYE_ZONE_LOW))
+      alarms++;
+  }
+
+  _alarms = alarms;
+  return changes;
+}
+
+/********************************************************
+ * Results
+ ********************************************************/
+
+uint8_t GridEYEZones::getState(uint16_t index)
+{
+  return (index < _count) ? _zones[index].state : 0;
+}
+
+bool GridEYEZones::inAlarm(uint16_t index)
+{
+  return getState(index) & (GRIDEYE_ZONE_HIGH | GRIDEYE_ZONE_LOW);
+}
+
+bool GridEYEZones::changed(uint16_t index)
+{
+  return getState(index) & GRIDEYE_ZONE_CHANGED;
+}
+
+uint16_t GridEYEZones::getAlarmCount()
+{
+  return _alarms;
+}
+
+/********************************************************
+ * Hardware interrupt
+ ********************************************************
+ *
+ * The sensor flags any pixel above its upper level or
+ * below its lower level. With the lowest upper and the
+ * highest lower of all zones, every frame that could
+ * start a zone alarm also trips the sensor, and the band
+ * is kept inside the 12-bit range the registers hold.
+ *
+ ********************************************************/
+
+void GridEYEZones::getBand(int16_t *lower, int16_t *upper, int16_t *hysteresis, int16_t margin)
+{
+  int32_t low = -2048;
+  int32_t high = 2047;
+  int16_t hyst = -1;
+  for (uint16_t i = 0; i < _count; i++)
+  {
+    const GridEYEZone *zone = &_zones[i];
+    if ((zone->upper == GRIDEYE_ZONE_NO_UPPER) && (zone->lower == GRIDEYE_ZONE_NO_LOWER))
+      continue;
+    if ((zone->upper != GRIDEYE_ZONE_NO_UPPER) && (zone->upper < high))
+      high = zone->upper;
+    if ((zone->lower != GRIDEYE_ZONE_NO_LOWER) && (zone->lower > low))
+      low = zone->lower;
+    if ((hyst < 0) || (zone->hysteresis < hyst))
+      hyst = zone->hysteresis;
+  }
+
+  *lower = clamp12(low + margin);
+  *upper = clamp12(high - margin);
+  *hysteresis = (hyst > 0) ? clamp12(hyst) : 0;
+}
+
+bool GridEYEZones::programInterrupt(GridEYE &sensor, int16_t margin)
+{
+  bool used = false;
+  for (uint16_t i = 0; i < _count; i++)
+  {
+    if ((_zones[i].upper != GRIDEYE_ZONE_NO_UPPER) || (_zones[i].lower != GRIDEYE_ZONE_NO_LOWER))
+      used = true;
+  }
+  if (!used)
+  {
+    sensor.interruptPinDisable();
+    return false;
+  }
+
+  int16_t lower, upper, hysteresis;
+  getBand(&lower, &upper, &hysteresis, margin);
+  sensor.setInterruptModeAbsolute();
+  sensor.setUpperInterruptValueRaw(upper & 0x0FFF);
+  sensor.setLowerInterruptValueRaw(lower & 0x0FFF);
+  sensor.setInterruptHysteresisRaw(hysteresis & 0x0FFF);
+  sensor.interruptPinEnable();
+  return true;
+}
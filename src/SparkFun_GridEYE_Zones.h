@@ -0,0 +1,117 @@
+/*
+  This is a library written for the Panasonic Grid-EYE AMG88
+  SparkFun sells these at its website: www.sparkfun.com
+  Do you like this library? Help support SparkFun. Buy a board!
+  https://www.sparkfun.com/products/14568
+
+  Software alarm zones for GridEYE frames.
+
+  The sensor's own interrupt has one upper level, one lower level and
+  one hysteresis for all 64 pixels. A zone is any set of pixels (a
+  64-bit mask, bit n = pixel n) with its own levels, hysteresis, dwell
+  and minimum pixel count, so a door and a stove in the same view can
+  have different limits.
+
+  Each update compares the frame with every level in use once, giving
+  a 64-bit "above" mask per level, and then tests each zone with an AND
+  of its pixel mask. Zones sharing levels share the comparisons, so
+  hundreds of zones cost little more than the distinct levels they use.
+  Below a level is the complement of above level - 1.
+
+  A zone alarms high when at least minPixels of its pixels are above
+  upper for dwell frames in a row, and clears once fewer than that are
+  above upper - hysteresis. Low alarms mirror this with lower. Levels
+  are raw, 0.25C per LSB; GRIDEYE_ZONE_NO_UPPER / GRIDEYE_ZONE_NO_LOWER
+  turn a side off.
+
+  The zone array belongs to the caller, one per sensor. programInterrupt()
+  sets the sensor's interrupt to the loosest band of all zones (lowest
+  upper, highest lower), so the interrupt pin only fires when some zone
+  could: the MCU can sleep until then.
+
+  https://github.com/sparkfun/SparkFun_GridEYE_Arduino_Library
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class GridEYE;
+struct GridEYERegion;
+
+#define GRIDEYE_ZONE_NO_UPPER 32767
+#define GRIDEYE_ZONE_NO_LOWER (-32767 - 1)
+
+// Zone state bits
+#define GRIDEYE_ZONE_HIGH 0x01    // Above upper
+#define GRIDEYE_ZONE_LOW 0x02     // Below lower
+#define GRIDEYE_ZONE_CHANGED 0x04 // HIGH or LOW changed in the last update
+
+// Distinct levels kept per update; further ones are compared without caching
+#define GRIDEYE_ZONES_CACHE 16
+
+struct GridEYEZone
+{
+  uint64_t mask;      // Pixels in the zone
+  int16_t upper;      // Raw level, or GRIDEYE_ZONE_NO_UPPER
+  int16_t lower;      // Raw level, or GRIDEYE_ZONE_NO_LOWER
+  int16_t hysteresis; // How far back inside a level before an alarm clears
+  uint8_t dwell;      // Frames in a row out of band before an alarm is raised
+  uint8_t minPixels;  // Pixels that must be out of band together
+
+  // Kept by GridEYEZones
+  uint8_t state;
+  uint8_t highCount;
+  uint8_t lowCount;
+};
+
+class GridEYEZones
+{
+public:
+  GridEYEZones();
+
+  // zones holds count entries and belongs to the caller. Clears their state.
+  void begin(GridEYEZone *zones, uint16_t count);
+
+  void setZone(uint16_t index, uint64_t mask, int16_t lower, int16_t upper, int16_t hysteresis = 2,
+               uint8_t dwell = 1, uint8_t minPixels = 1);
+  static uint64_t regionMask(GridEYERegion region);
+
+  void reset(); // Clear every alarm and dwell count
+
+  // Evaluate a sign-extended frame. Returns the number of zones whose alarm changed.
+  uint16_t update(const int16_t *frame);
+
+  uint8_t getState(uint16_t index);
+  bool inAlarm(uint16_t index);
+  bool changed(uint16_t index);
+  uint16_t getAlarmCount();
+
+  // Loosest band over all zones: the lowest upper, the highest lower and the
+  // smallest hysteresis. margin moves both levels inward so the sensor trips
+  // sooner, e.g. by the largest calibration offset, since it compares
+  // uncorrected values.
+  void getBand(int16_t *lower, int16_t *upper, int16_t *hysteresis, int16_t margin = 0);
+  bool programInterrupt(GridEYE &sensor, int16_t margin = 0);
+
+private:
+  uint64_t above(int16_t level);
+
+  GridEYEZone *_zones;
+  uint16_t _count;
+  uint16_t _alarms;
+
+  const int16_t *_frame;
+  int16_t _cacheLevel[GRIDEYE_ZONES_CACHE];
+  uint64_t _cacheMask[GRIDEYE_ZONES_CACHE];
+  uint8_t _cacheUsed;
+};